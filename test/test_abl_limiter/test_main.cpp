@@ -0,0 +1,116 @@
+/*
+ * Host tests for automatic brightness limiter (wled00/abl_limiter.h)
+ * run with: pio test -e native -f test_abl_limiter
+ */
+#include <unity.h>
+#include <algorithm>
+#include "abl_limiter.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_within_budget_is_not_limited() {
+  ABLLimiter l;
+  TEST_ASSERT_EQUAL(255, l.limit(1500, 2000, 100, 20, false, 100));
+  TEST_ASSERT_UINT32_WITHIN(1, 1500, l.getCurrent()); // 16 bit gain
+}
+
+void test_peak_budget_is_never_exceeded() {
+  ABLLimiter l;
+  for (int i = 0; i < 50; i++) {
+    l.limit(8000, 2000, 100, 20, true, 100);
+    TEST_ASSERT_LESS_OR_EQUAL(2000, l.getCurrent());
+  }
+  TEST_ASSERT_GREATER_THAN(1990, l.getCurrent());
+}
+
+void test_budget_below_standby_gives_minimum() {
+  ABLLimiter l;
+  TEST_ASSERT_EQUAL(1, l.limit(5000, 100, 300, 20, false, 100));
+}
+
+// frame budget must follow the rolling average continuously (no jump from peak to sustained)
+void test_frame_budget_is_continuous() {
+  ABLLimiter l;
+  const uint32_t peak = 4000, standby = 100;
+  uint32_t prev = l.frameBudget(peak, standby, 50);
+  TEST_ASSERT_EQUAL(peak, prev);
+  for (int i = 0; i < 30000; i++) {
+    l.limit(3000, peak, standby, 20, false, 100); // average rises towards 3000mA, sustained budget not used for limiting
+    uint32_t budget = l.frameBudget(peak, standby, 50);
+    TEST_ASSERT_LESS_OR_EQUAL(prev, budget);     // monotonic while average rises
+    TEST_ASSERT_LESS_OR_EQUAL(10, prev - budget); // small steps only
+    prev = budget;
+  }
+  TEST_ASSERT_EQUAL(2000, prev); // average above sustained (50% of 4000mA)
+}
+
+// constant overload: average settles at sustained budget and brightness does not pump
+void test_sustained_average_settles_without_pumping() {
+  ABLLimiter l;
+  const uint32_t peak = 4000, standby = 100, sustained = 2000;
+  unsigned minBri = 255, maxBri = 0;
+  for (int i = 0; i < 60000; i++) { // 20 minutes at 50 FPS
+    uint8_t bri = l.limit(6000, peak, standby, 20, true, 50);
+    TEST_ASSERT_LESS_OR_EQUAL(peak, l.getCurrent());
+    if (i >= 50000) { if (bri < minBri) minBri = bri; if (bri > maxBri) maxBri = bri; }
+  }
+  TEST_ASSERT_UINT32_WITHIN(50, sustained, l.getAverage());
+  TEST_ASSERT_LESS_OR_EQUAL(1, maxBri - minBri); // steady brightness
+}
+
+void test_short_peak_may_exceed_sustained() {
+  ABLLimiter l;
+  for (int i = 0; i < 500; i++) l.limit(500, 4000, 100, 20, false, 50); // idle, low average
+  l.limit(3500, 4000, 100, 20, false, 50);
+  TEST_ASSERT_UINT32_WITHIN(1, 3500, l.getCurrent()); // not limited to sustained budget (2000mA)
+}
+
+// color value is sum of all channels (max of RGB for WS2815 model)
+void test_color_value_matches_channel_sum() {
+  uint32_t c = 0x12345678;
+  for (int i = 0; i < 10000; i++) {
+    c ^= c << 13; c ^= c >> 17; c ^= c << 5;
+    const unsigned w = c >> 24, r = (c >> 16) & 0xFF, g = (c >> 8) & 0xFF, b = c & 0xFF;
+    TEST_ASSERT_EQUAL(w + r + g + b, ablColorValue(c, false));
+    TEST_ASSERT_EQUAL(std::max(r, std::max(g, b)), ablColorValue(c, true));
+  }
+  TEST_ASSERT_EQUAL(4*255, ablColorValue(0xFFFFFFFF, false));
+}
+
+void test_current_estimate() {
+  const uint32_t white = 100 * ablColorValue(0x00FFFFFF, false);
+  TEST_ASSERT_EQUAL(100*55 + 100, ablEstimateCurrent(white, 55, 255, false, 100));       // full white RGB, 1mA standby per LED
+  TEST_ASSERT_EQUAL(100*55/2 + 100, ablEstimateCurrent(white/2, 55, 255, false, 100));   // half the color value, half the current
+  TEST_ASSERT_UINT32_WITHIN(1, 100*55*128/255 + 100, ablEstimateCurrent(white, 55, 128, false, 100)); // bus brightness
+  TEST_ASSERT_EQUAL(100*55/4 + 100, ablEstimateCurrent(100 * ablColorValue(0xFF000000, false), 55, 255, true, 100)); // W only on RGBW
+  TEST_ASSERT_EQUAL(10*12 + 10, ablEstimateCurrent(10 * ablColorValue(0xFFFFFFFF, true), 255, 255, false, 10)); // WS2815 model (RGB)
+  TEST_ASSERT_EQUAL(50, ablEstimateCurrent(0, 55, 255, false, 50)); // black: standby current only
+}
+
+// black/white strobe without smoothing: each frame is limited by its own estimate (white frames never exceed budget)
+void test_strobe_is_limited_on_every_frame() {
+  ABLLimiter l;
+  const uint32_t white = 100 * ablColorValue(0x00FFFFFF, false);
+  for (int i = 0; i < 20; i++) {
+    const uint32_t demand = ablEstimateCurrent((i & 1) ? white : 0, 55, 255, false, 100);
+    const uint8_t bri = l.limit(demand, 2000, 100, 20, false, 100);
+    TEST_ASSERT_LESS_OR_EQUAL(2000, l.getCurrent());
+    TEST_ASSERT_LESS_OR_EQUAL(2000 + 100*55/255, ablEstimateCurrent((i & 1) ? white : 0, 55, bri, false, 100)); // frame painted with its limit (one 8 bit step)
+    if (!(i & 1)) TEST_ASSERT_EQUAL(255, bri); // black frame is not dimmed
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_within_budget_is_not_limited);
+  RUN_TEST(test_peak_budget_is_never_exceeded);
+  RUN_TEST(test_budget_below_standby_gives_minimum);
+  RUN_TEST(test_frame_budget_is_continuous);
+  RUN_TEST(test_sustained_average_settles_without_pumping);
+  RUN_TEST(test_short_peak_may_exceed_sustained);
+  RUN_TEST(test_color_value_matches_channel_sum);
+  RUN_TEST(test_current_estimate);
+  RUN_TEST(test_strobe_is_limited_on_every_frame);
+  return UNITY_END();
+}
@@ -0,0 +1,97 @@
+/*
+ * Host tests for real-input FFT of the audioreactive usermod (usermods/audioreactive/audio_fft.h)
+ * compute() must give the magnitudes of the ArduinoFFT sequence dcRemoval() -> windowing(Flat_top) -> compute() -> complexToMagnitude()
+ * run with: pio test -e native -f test_audio_fft
+ */
+#include <unity.h>
+#include <vector>
+#include "../../usermods/audioreactive/audio_fft.h"
+
+void setUp() {}
+void tearDown() {}
+
+// reference: DFT of DC free, flat top windowed samples (window is symmetric, ArduinoFFT computes the first half)
+static std::vector<float> referenceMagnitudes(const std::vector<float> &in) {
+  const unsigned n = in.size();
+  double mean = 0.0;
+  for (float v : in) mean += v;
+  mean /= n;
+  std::vector<double> x(n);
+  for (unsigned i = 0; i < n; i++) x[i] = (in[i] - mean) * realFFT_flatTop(i < n/2 ? i : n-1 - i, n);
+  std::vector<float> mag(n);
+  for (unsigned k = 0; k <= n/2; k++) {
+    double re = 0.0, im = 0.0;
+    for (unsigned i = 0; i < n; i++) {
+      re += x[i] * cos(2.0 * M_PI * k * i / n);
+      im -= x[i] * sin(2.0 * M_PI * k * i / n);
+    }
+    mag[k] = float(sqrt(re*re + im*im));
+  }
+  for (unsigned k = 1; k < n/2; k++) mag[n - k] = mag[k]; // mirrored like complex FFT output
+  return mag;
+}
+
+static uint32_t rnd = 0x12345678;
+static float noise() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return float(int32_t(rnd % 2001) - 1000); }
+
+// microphone like input: DC offset, two tones (one between bins) and noise
+static std::vector<float> signal(unsigned n, float amplitude) {
+  std::vector<float> s(n);
+  for (unsigned i = 0; i < n; i++) {
+    s[i] = 1500.0f + amplitude * float(sin(2.0 * M_PI * 10.5 * i / n)) + 0.3f * amplitude * float(cos(2.0 * M_PI * 37 * i / n))
+         + amplitude * 0.01f * noise() / 1000.0f;
+  }
+  return s;
+}
+
+// every bin must be within tolerance * peak of the reference
+template<class FFT> static void checkAgainstReference(unsigned n, float amplitude, float tolerance) {
+  FFT fft;
+  TEST_ASSERT_TRUE(fft.begin(n));
+  std::vector<float> data = signal(n, amplitude);
+  const std::vector<float> ref = referenceMagnitudes(data);
+  fft.compute(data.data());
+  float peak = 0.0f;
+  for (float v : ref) peak = fmaxf(peak, v);
+  for (unsigned k = 0; k < n; k++) TEST_ASSERT_FLOAT_WITHIN(tolerance * peak, ref[k], data[k]);
+}
+
+void test_float_matches_dft() {
+  for (unsigned n : {64, 512}) {
+    checkAgainstReference<RealFFT>(n, 8000.0f, 1e-5f);
+    checkAgainstReference<RealFFT>(n, 20.0f, 1e-4f); // quiet input: float DC removal of the 1500 offset limits precision
+  }
+}
+
+void test_q15_matches_dft() {
+  for (unsigned n : {64, 512}) {
+    checkAgainstReference<RealFFTQ15>(n, 30000.0f, 1e-3f); // large input is scaled down by block floating point
+    checkAgainstReference<RealFFTQ15>(n, 20.0f, 1e-3f);    // small input is scaled up
+  }
+}
+
+void test_q15_silence_is_zero() {
+  RealFFTQ15 fft;
+  TEST_ASSERT_TRUE(fft.begin(512));
+  std::vector<float> data(512, 1234.0f); // DC only
+  fft.compute(data.data());
+  for (float v : data) TEST_ASSERT_EQUAL_FLOAT(0.0f, v);
+}
+
+void test_begin_rejects_invalid_size() {
+  RealFFT fft;
+  RealFFTQ15 q15;
+  TEST_ASSERT_FALSE(fft.begin(4));
+  TEST_ASSERT_FALSE(fft.begin(384));
+  TEST_ASSERT_FALSE(q15.begin(100));
+  TEST_ASSERT_TRUE(q15.begin(8));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_float_matches_dft);
+  RUN_TEST(test_q15_matches_dft);
+  RUN_TEST(test_q15_silence_is_zero);
+  RUN_TEST(test_begin_rejects_invalid_size);
+  return UNITY_END();
+}
@@ -0,0 +1,188 @@
+/*
+ * Host tests for GEQ channels of the audioreactive usermod (usermods/audioreactive/audio_geq.h)
+ * geqMapChannels() averages FFT result bins into 16 channels, geqPostProcess() turns them into fftResult[]
+ * not covered: the AGC controller (agcAvg() computes the gain used here) and limitSampleDynamics() are members of the
+ * usermod class and run on millis(), WavFileSource reads from WLED_FS
+ * run with: pio test -e native -f test_audio_geq
+ */
+#include <unity.h>
+#include <initializer_list>
+#include "../../usermods/audioreactive/audio_geq.h"
+
+void setUp() {}
+void tearDown() {}
+
+static const float flatPink[16] = { 1,1,1,1, 1,1,1,1, 1,1,1,1, 1,1,1,1 };
+
+static GEQSettings settings(uint8_t scalingMode, bool limiter = false) {
+  GEQSettings geq;
+  geq.pink        = flatPink;
+  geq.gain        = 1.0f;
+  geq.postGain    = 1.0f;
+  geq.riseKeep    = 0.25f;
+  geq.fallKeep    = 0.78f;
+  geq.limiter     = limiter;
+  geq.scalingMode = scalingMode;
+  return geq;
+}
+
+// bins 1 .. 215 (43 Hz .. 9.2 kHz) all reach a channel, no gaps between channels
+void test_every_used_bin_reaches_a_channel() {
+  for (int bin = 1; bin <= 215; bin++) {
+    float bins[256] = {}, ch[16];
+    bins[bin] = 100.0f;
+    geqMapChannels(bins, ch, false);
+    float sum = 0.0f;
+    for (float c : ch) sum += c;
+    TEST_ASSERT_GREATER_THAN(0.0f, sum);
+  }
+  // aliased bins are ignored
+  float bins[256] = {}, ch[16];
+  for (int bin = 216; bin < 256; bin++) bins[bin] = 100.0f;
+  geqMapChannels(bins, ch, false);
+  for (float c : ch) TEST_ASSERT_EQUAL_FLOAT(0.0f, c);
+}
+
+// 1 kHz tone (bin 23 @ 22050 Hz / 512) lands in the center channel
+void test_1kHz_is_center_channel() {
+  float bins[256] = {}, ch[16];
+  bins[1000 * 512 / 22050] = 100.0f;
+  geqMapChannels(bins, ch, false);
+  for (int i = 0; i < 16; i++) {
+    if (i == 7) TEST_ASSERT_GREATER_THAN(0.0f, ch[i]);
+    else        TEST_ASSERT_EQUAL_FLOAT(0.0f, ch[i]);
+  }
+}
+
+// band pass filter: lowest bins (below ~100 Hz) are skipped, highest channel ends earlier
+void test_band_pass_mapping() {
+  float bins[256] = {}, ch[16];
+  bins[1] = bins[2] = 100.0f;
+  geqMapChannels(bins, ch, true);
+  for (float c : ch) TEST_ASSERT_EQUAL_FLOAT(0.0f, c);
+  for (int bin = 0; bin < 256; bin++) bins[bin] = 100.0f;
+  geqMapChannels(bins, ch, true);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 80.0f, ch[0]);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 75.0f, ch[15]);
+}
+
+// every scaling mode gives 0 for silence, stays within 0 .. 255 and does not decrease with rising input
+void test_scaling_is_monotonic_and_bounded() {
+  for (uint8_t mode = 0; mode <= 3; mode++) {
+    for (int channel = 0; channel < 16; channel++) {
+      float avg[16] = {}, calc[16] = {};
+      uint8_t result[16], last = 0;
+      GEQSettings geq = settings(mode);
+      geqPostProcess(calc, avg, result, 16, true, geq);
+      TEST_ASSERT_EQUAL_UINT8(0, result[channel]);
+      for (float in = 0.0f; in <= 4000.0f; in += 5.0f) {
+        for (float &c : calc) c = in;
+        geqPostProcess(calc, avg, result, 16, true, geq);
+        TEST_ASSERT_GREATER_OR_EQUAL(last, result[channel]);
+        last = result[channel];
+      }
+      if (mode != 2 || channel > 0) TEST_ASSERT_GREATER_THAN(200, last); // loud input reaches the top rows (linear mode has no up-scaling on channel 0)
+    }
+  }
+}
+
+// default mode (square root): values of the top row, channel 0 and 15 (high frequencies get extra up-scaling)
+void test_square_root_scaling_values() {
+  float calc[16], avg[16] = {};
+  uint8_t result[16];
+  GEQSettings geq = settings(3);
+  for (float &c : calc) c = 100.0f;
+  geqPostProcess(calc, avg, result, 16, true, geq);
+  TEST_ASSERT_EQUAL_UINT8(45, result[0]);                // sqrt(100 * 0.46 * 0.38 - 6) * 0.85 * 255/16
+  TEST_ASSERT_EQUAL_UINT8(225, result[15]);              // ... * (0.85 + 15/4.5)
+}
+
+// noise gate closed: pink correction and gain are not applied, channel values are passed on as they are
+void test_gain_only_with_open_noise_gate() {
+  float pink[16], calc[16], avg[16] = {};
+  uint8_t open[16], closed[16];
+  for (int i = 0; i < 16; i++) pink[i] = 2.0f;
+  GEQSettings geq = settings(0);
+  geq.pink = pink;
+  geq.gain = 1.5f;
+  for (float &c : calc) c = 50.0f;
+  geqPostProcess(calc, avg, open, 16, true, geq);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 150.0f, calc[0]);
+  TEST_ASSERT_EQUAL_UINT8(146, open[0]);
+  for (float &c : calc) c = 50.0f;
+  geqPostProcess(calc, avg, closed, 16, false, geq);
+  TEST_ASSERT_EQUAL_UINT8(46, closed[0]);
+}
+
+// limiter on: results rise fast and fall slowly, limiter off: results follow the input immediately
+void test_limiter_smooths_rise_and_fall() {
+  float calc[16], avg[16] = {};
+  uint8_t result[16];
+  GEQSettings geq = settings(0, true);
+  for (float &c : calc) c = 204.0f;
+  geqPostProcess(calc, avg, result, 16, true, geq);
+  TEST_ASSERT_EQUAL_UINT8(149, result[0]);               // 75% of the step in one run
+  for (float &c : calc) c = 204.0f;
+  geqPostProcess(calc, avg, result, 16, true, geq);
+  TEST_ASSERT_EQUAL_UINT8(187, result[0]);               // 94% after two runs
+  for (int run = 0; run < 20; run++) {
+    for (float &c : calc) c = 204.0f;
+    geqPostProcess(calc, avg, result, 16, true, geq);
+  }
+  TEST_ASSERT_EQUAL_UINT8(200, result[0]);
+  unsigned runs = 0;
+  while (result[0] > 0 && runs < 100) {
+    for (float &c : calc) c = 0.0f;
+    geqPostProcess(calc, avg, result, 16, true, geq);
+    runs++;
+  }
+  TEST_ASSERT_GREATER_OR_EQUAL(5, runs);                  // falls slower than it rises
+  TEST_ASSERT_LESS_THAN(100, runs);
+
+  geq.limiter = false;
+  for (float &c : calc) c = 204.0f;
+  geqPostProcess(calc, avg, result, 16, true, geq);
+  TEST_ASSERT_EQUAL_UINT8(200, result[0]);
+  for (float &c : calc) c = 0.0f;
+  geqPostProcess(calc, avg, result, 16, true, geq);
+  TEST_ASSERT_EQUAL_UINT8(0, result[0]);
+}
+
+// with overlapping FFT windows the smoothing runs 2x or 4x as often, rise/fall time must stay the same
+void test_hop_smoothing_keeps_time_constant() {
+  for (float keep : {0.25f, 0.78f, 0.9f}) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, keep, geqHopSmoothing(keep, 0));
+    const float k1 = geqHopSmoothing(keep, 1), k2 = geqHopSmoothing(keep, 2);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, keep, k1 * k1);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, keep, k2 * k2 * k2 * k2);
+  }
+}
+
+// "GEQ Gain" below 1 is compressed (0.5 -> 0.6), above 1 applied as is
+void test_post_gain_scales_result() {
+  float calc[16], avg[16] = {};
+  uint8_t result[16];
+  GEQSettings geq = settings(0);
+  geq.postGain = 0.6f;
+  for (float &c : calc) c = 104.0f;
+  geqPostProcess(calc, avg, result, 16, true, geq);
+  TEST_ASSERT_EQUAL_UINT8(60, result[0]);
+  geq.postGain = 2.0f;
+  for (float &c : calc) c = 204.0f;
+  geqPostProcess(calc, avg, result, 16, true, geq);
+  TEST_ASSERT_EQUAL_UINT8(255, result[0]);               // clipped
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_every_used_bin_reaches_a_channel);
+  RUN_TEST(test_1kHz_is_center_channel);
+  RUN_TEST(test_band_pass_mapping);
+  RUN_TEST(test_scaling_is_monotonic_and_bounded);
+  RUN_TEST(test_square_root_scaling_values);
+  RUN_TEST(test_gain_only_with_open_noise_gate);
+  RUN_TEST(test_limiter_smooths_rise_and_fall);
+  RUN_TEST(test_hop_smoothing_keeps_time_constant);
+  RUN_TEST(test_post_gain_scales_result);
+  return UNITY_END();
+}
@@ -0,0 +1,169 @@
+/*
+ * Host stand-in for BusDigital/PolyBus pixel dispatch (wled00/color_order.h)
+ * per pixel path: virtual setPixelColor() -> color order map lookup -> type switch, for every LED
+ * bulk path:      virtual setPixels() -> colorOrderSpanRun() -> type switch once per run -> templated loop
+ * NeoPixelBus types are replaced by plain GRB/GRBW buffers, so this measures dispatch overhead, not NeoPixelBus
+ * run with: pio test -e native -f test_bus_dispatch
+ */
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include "color_order.h"
+
+void setUp() {}
+void tearDown() {}
+
+static unsigned typeSwitches = 0, orderLookups = 0;
+
+// stand-in for the PolyBus type switch (as many cases as a typical ESP32 build has bus types)
+enum StandInType : uint8_t { T_RMT_3, T_RMT_4, T_I2S_3, T_I2S_4, T_PAR_3, T_PAR_4, T_TM1_4, T_TM2_3, T_UCS_3, T_UCS_4, T_APA_3, T_1914_3 };
+static inline unsigned bytesPerPixel(uint8_t type) { return (type == T_RMT_4 || type == T_I2S_4 || type == T_PAR_4 || type == T_TM1_4 || type == T_UCS_4) ? 4 : 3; }
+
+[[gnu::noinline]] static void polySetPixelColor(uint8_t *buf, uint8_t type, unsigned pix, uint32_t c, uint8_t co) {
+  typeSwitches++;
+  uint8_t wire[4];
+  colorToWireOrder(c, co, wire);
+  switch (type) {
+    case T_RMT_3: case T_I2S_3: case T_PAR_3: case T_TM2_3: case T_UCS_3: case T_APA_3: case T_1914_3:
+      for (unsigned k = 0; k < 3; k++) buf[pix*3 + k] = wire[k];
+      break;
+    default:
+      for (unsigned k = 0; k < 4; k++) buf[pix*4 + k] = wire[k];
+      break;
+  }
+}
+
+[[gnu::noinline]] static void polySetPixels(uint8_t *buf, uint8_t type, unsigned pix, int step, const uint32_t *c, size_t count, uint8_t co) {
+  typeSwitches++;
+  switch (type) {
+    case T_RMT_3: case T_I2S_3: case T_PAR_3: case T_TM2_3: case T_UCS_3: case T_APA_3: case T_1914_3:
+      writeWireOrderPixels<3>(buf, pix, step, c, count, co);
+      break;
+    default:
+      writeWireOrderPixels<4>(buf, pix, step, c, count, co);
+      break;
+  }
+}
+
+class StandInBus {
+  public:
+    virtual ~StandInBus() {}
+    virtual void setPixelColor(unsigned pix, uint32_t c) = 0;
+    virtual void setPixels(unsigned start, const uint32_t *src, size_t count) = 0;
+};
+
+// mirrors BusDigital: reversal, skipped LEDs, color order map
+class StandInDigital : public StandInBus {
+  public:
+    StandInDigital(uint8_t type, unsigned start, unsigned len, unsigned skip, bool reversed, const std::vector<ColorOrderMapEntry> &map)
+    : _type(type), _start(start), _len(len), _skip(skip), _reversed(reversed), _map(map), _buf((len + skip) * bytesPerPixel(type))
+    {
+      resolveColorOrderSpans(_map, _start, _len + _skip, 0, _spans);
+    }
+
+    void setPixelColor(unsigned pix, uint32_t c) override {
+      if (_reversed) pix = _len - pix - 1;
+      pix += _skip;
+      orderLookups++;
+      polySetPixelColor(_buf.data(), _type, pix, c, colorOrderAt(_map, pix + _start, 0));
+    }
+
+    void setPixels(unsigned start, const uint32_t *src, size_t count) override {
+      while (count) {
+        unsigned pix;
+        size_t n;
+        orderLookups++;
+        const uint8_t co = _spans[colorOrderSpanRun(_spans, start, count, _len, _skip, _reversed, pix, n)].colorOrder;
+        polySetPixels(_buf.data(), _type, pix, _reversed ? -1 : 1, src, n, co);
+        src   += n;
+        start += n;
+        count -= n;
+      }
+    }
+
+    const std::vector<uint8_t> &buffer() const { return _buf; }
+
+  private:
+    uint8_t  _type;
+    unsigned _start, _len, _skip;
+    bool     _reversed;
+    std::vector<ColorOrderMapEntry> _map, _spans;
+    std::vector<uint8_t> _buf;
+};
+
+static std::vector<uint32_t> testFrame(unsigned len, uint32_t seed) {
+  std::vector<uint32_t> f(len);
+  for (auto &c : f) c = (seed = seed * 1664525U + 1013904223U);
+  return f;
+}
+
+// bulk path writes the same bytes as the per pixel path, for 3 and 4 byte types, reversed, skipped LEDs, color order map
+void test_bulk_matches_per_pixel() {
+  const std::vector<ColorOrderMapEntry> map = {{103, 4, 1}, {110, 1, 2}, {115, 20, 0x13}};
+  for (uint8_t type : {T_RMT_3, T_RMT_4}) {
+    for (unsigned skip = 0; skip < 2; skip++) {
+      for (bool reversed : {false, true}) {
+        StandInDigital a(type, 100, 60, skip, reversed, map), b(type, 100, 60, skip, reversed, map);
+        const std::vector<uint32_t> f = testFrame(60, 7);
+        for (unsigned i = 0; i < 60; i++) a.setPixelColor(i, f[i]);
+        b.setPixels(0, f.data(), 60);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(a.buffer().data(), b.buffer().data(), a.buffer().size());
+      }
+    }
+  }
+}
+
+// type switch and color order lookup once per run of equal color order instead of once per LED
+void test_dispatch_once_per_run() {
+  const std::vector<ColorOrderMapEntry> map = {{10, 10, 1}}; // 3 runs: 0-9, 10-19, 20-299
+  StandInDigital bus(T_I2S_4, 0, 300, 0, false, map);
+  const std::vector<uint32_t> f = testFrame(300, 1);
+  typeSwitches = orderLookups = 0;
+  for (unsigned i = 0; i < 300; i++) bus.setPixelColor(i, f[i]);
+  TEST_ASSERT_EQUAL(300, typeSwitches);
+  TEST_ASSERT_EQUAL(300, orderLookups);
+  typeSwitches = orderLookups = 0;
+  bus.setPixels(0, f.data(), 300);
+  TEST_ASSERT_EQUAL(3, typeSwitches);
+  TEST_ASSERT_EQUAL(3, orderLookups);
+}
+
+// dispatch overhead: 4 buses of 512 LEDs (one with a color order map entry), both paths, reported per LED
+void test_dispatch_benchmark() {
+  const std::vector<ColorOrderMapEntry> map = {{1500, 20, 1}};
+  std::vector<std::unique_ptr<StandInBus>> buses;
+  const uint8_t types[] = {T_RMT_3, T_I2S_4, T_PAR_3, T_UCS_4};
+  for (unsigned i = 0; i < 4; i++) buses.emplace_back(new StandInDigital(types[i], i * 512, 512, 0, i & 1, map));
+  const std::vector<uint32_t> f = testFrame(512, 3);
+  const unsigned frames = 500;
+  using clock = std::chrono::steady_clock;
+
+  auto t0 = clock::now();
+  for (unsigned n = 0; n < frames; n++)
+    for (auto &bus : buses)
+      for (unsigned i = 0; i < 512; i++) bus->setPixelColor(i, f[i] + n);
+  auto t1 = clock::now();
+  std::vector<uint32_t> g(512);
+  for (unsigned n = 0; n < frames; n++) {
+    for (unsigned i = 0; i < 512; i++) g[i] = f[i] + n; // same work on the colors as above
+    for (auto &bus : buses) bus->setPixels(0, g.data(), 512);
+  }
+  auto t2 = clock::now();
+
+  const double leds = double(frames) * 4 * 512;
+  const double perPixel = std::chrono::duration<double, std::nano>(t1 - t0).count() / leds;
+  const double bulk     = std::chrono::duration<double, std::nano>(t2 - t1).count() / leds;
+  printf("  per pixel: %.2f ns/LED, bulk: %.2f ns/LED\n", perPixel, bulk); // reported only, timing depends on host and build flags
+  TEST_ASSERT_GREATER_THAN(0.0, bulk);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_bulk_matches_per_pixel);
+  RUN_TEST(test_dispatch_once_per_run);
+  RUN_TEST(test_dispatch_benchmark);
+  return UNITY_END();
+}
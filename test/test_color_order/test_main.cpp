@@ -0,0 +1,182 @@
+/*
+ * Host tests for color order map resolution (wled00/color_order.h)
+ * run with: pio test -e native -f test_color_order
+ */
+#include <unity.h>
+#include "color_order.h"
+
+#define GRB 0
+#define RGB 1
+#define BRG 2
+#define RBG 3
+
+void setUp() {}
+void tearDown() {}
+
+// reference: per pixel lookup, which the spans must reproduce
+static void checkSpans(const std::vector<ColorOrderMapEntry> &map, unsigned busStart, unsigned total, uint8_t def) {
+  std::vector<ColorOrderMapEntry> spans;
+  resolveColorOrderSpans(map, busStart, total, def, spans);
+  TEST_ASSERT_FALSE(spans.empty());
+  unsigned covered = 0;
+  for (size_t i = 0; i < spans.size(); i++) {
+    TEST_ASSERT_EQUAL(covered, spans[i].start); // consecutive, no gaps
+    TEST_ASSERT_GREATER_THAN(0, spans[i].len);
+    if (i) TEST_ASSERT_TRUE(spans[i].colorOrder != spans[i-1].colorOrder); // merged
+    covered += spans[i].len;
+  }
+  TEST_ASSERT_EQUAL(total, covered);
+  for (unsigned pix = 0; pix < total; pix++) {
+    TEST_ASSERT_EQUAL(colorOrderAt(map, pix + busStart, def), spans[findColorOrderSpan(spans, pix)].colorOrder);
+  }
+}
+
+void test_empty_map_is_one_span() {
+  std::vector<ColorOrderMapEntry> map, spans;
+  resolveColorOrderSpans(map, 100, 50, GRB, spans);
+  TEST_ASSERT_EQUAL(1, spans.size());
+  TEST_ASSERT_EQUAL(0, spans[0].start);
+  TEST_ASSERT_EQUAL(50, spans[0].len);
+  TEST_ASSERT_EQUAL(GRB, spans[0].colorOrder);
+}
+
+void test_mapping_inside_bus() {
+  std::vector<ColorOrderMapEntry> map = {{10, 5, RGB}};
+  checkSpans(map, 0, 30, GRB);
+  std::vector<ColorOrderMapEntry> spans;
+  resolveColorOrderSpans(map, 0, 30, GRB, spans);
+  TEST_ASSERT_EQUAL(3, spans.size());
+  TEST_ASSERT_EQUAL(10, spans[1].start);
+  TEST_ASSERT_EQUAL(5, spans[1].len);
+}
+
+void test_overlapping_mappings_first_wins() {
+  std::vector<ColorOrderMapEntry> map = {{10, 10, RGB}, {15, 10, BRG}, {0, 40, RBG}};
+  checkSpans(map, 0, 40, GRB);
+  TEST_ASSERT_EQUAL(RGB, colorOrderAt(map, 17, GRB));
+  TEST_ASSERT_EQUAL(BRG, colorOrderAt(map, 22, GRB));
+  TEST_ASSERT_EQUAL(RBG, colorOrderAt(map, 5, GRB));
+}
+
+void test_bus_not_at_zero_and_partial_overlap() {
+  std::vector<ColorOrderMapEntry> map = {{90, 20, RGB}, {130, 5, BRG}, {200, 10, RBG}};
+  checkSpans(map, 100, 50, GRB);
+}
+
+void test_equal_neighbours_are_merged() {
+  std::vector<ColorOrderMapEntry> map = {{0, 10, RGB}, {10, 10, RGB}};
+  std::vector<ColorOrderMapEntry> spans;
+  resolveColorOrderSpans(map, 0, 25, GRB, spans);
+  TEST_ASSERT_EQUAL(2, spans.size());
+  TEST_ASSERT_EQUAL(20, spans[0].len);
+}
+
+void test_w_swap_nibble() {
+  std::vector<ColorOrderMapEntry> map = {{0, 5, RGB}, {5, 5, 0x20 | BRG}};
+  TEST_ASSERT_EQUAL(0x10 | RGB, colorOrderAt(map, 2, 0x10 | GRB)); // global W swap kept
+  TEST_ASSERT_EQUAL(0x20 | BRG, colorOrderAt(map, 7, 0x10 | GRB)); // mapping's W swap wins
+  checkSpans(map, 0, 12, 0x10 | GRB);
+}
+
+// reference: per pixel mapping of BusDigital::setPixelColor() (reversal, skipped LEDs, color order of each LED)
+// runs as split by BusDigital::setPixels() must address the same LEDs with the same color order
+static void checkRuns(const std::vector<ColorOrderMapEntry> &map, unsigned busStart, unsigned len, unsigned skip, bool reversed, size_t maxRun) {
+  std::vector<ColorOrderMapEntry> spans;
+  resolveColorOrderSpans(map, busStart, len + skip, GRB, spans);
+  for (unsigned start = 0; start < len; start++) {
+    std::vector<int> led(len, -1);
+    std::vector<uint8_t> co(len, 0xFF);
+    unsigned pos = start;
+    size_t count = len - start;
+    while (count) {
+      unsigned pix;
+      size_t n;
+      const size_t s = colorOrderSpanRun(spans, pos, std::min(count, maxRun), len, skip, reversed, pix, n);
+      TEST_ASSERT_GREATER_THAN(0, n);
+      for (size_t i = 0; i < n; i++) {
+        led[pos + i] = reversed ? pix - i : pix + i;
+        co[pos + i]  = spans[s].colorOrder;
+      }
+      pos   += n;
+      count -= n;
+    }
+    for (unsigned i = start; i < len; i++) {
+      const unsigned ref = (reversed ? len - i - 1 : i) + skip;
+      TEST_ASSERT_EQUAL(ref, led[i]);
+      TEST_ASSERT_EQUAL(colorOrderAt(map, ref + busStart, GRB), co[i]);
+    }
+  }
+}
+
+void test_span_runs_match_per_pixel() {
+  std::vector<ColorOrderMapEntry> map = {{103, 4, RGB}, {110, 1, BRG}, {115, 20, RBG}};
+  for (unsigned skip = 0; skip < 3; skip++) {
+    checkRuns(map, 100, 30, skip, false, 64);
+    checkRuns(map, 100, 30, skip, true,  64);
+    checkRuns(map, 100, 30, skip, true,  3); // runs split by buffer size
+  }
+}
+
+void test_span_run_single_span() {
+  std::vector<ColorOrderMapEntry> map, spans;
+  resolveColorOrderSpans(map, 0, 50, GRB, spans);
+  unsigned pix;
+  size_t n;
+  TEST_ASSERT_EQUAL(0, colorOrderSpanRun(spans, 10, 40, 50, 0, false, pix, n));
+  TEST_ASSERT_EQUAL(10, pix);
+  TEST_ASSERT_EQUAL(40, n);
+  colorOrderSpanRun(spans, 10, 39, 49, 1, true, pix, n); // rest of reversed bus with one skipped LED
+  TEST_ASSERT_EQUAL(39, pix);
+  TEST_ASSERT_EQUAL(39, n);
+}
+
+static uint8_t channel(uint32_t c, char name) {
+  switch (name) { case 'R': return c >> 16; case 'G': return c >> 8; case 'B': return c; default: return c >> 24; }
+}
+
+// wire bytes follow color order name, upper nibble swaps W with 3rd (1), 1st (2) or 2nd (3) wire byte
+void test_wire_order_all_orders() {
+  static const char *names[] = { "GRB", "RGB", "BRG", "RBG", "BGR", "GBR" };
+  const uint32_t c = 0x44112233; // W=44 R=11 G=22 B=33
+  for (unsigned order = 0; order < 6; order++) {
+    for (unsigned swap = 0; swap < 4; swap++) {
+      uint8_t ref[4] = { channel(c, names[order][0]), channel(c, names[order][1]), channel(c, names[order][2]), channel(c, 'W') };
+      if (swap) std::swap(ref[3], ref[swap == 1 ? 2 : swap - 2]);
+      uint8_t wire[4];
+      colorToWireOrder(c, (swap << 4) | order, wire);
+      TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, wire, 4);
+    }
+  }
+}
+
+// bytes of reversed run are written downwards from pix, neighbouring pixels are not touched
+void test_write_wire_order_pixels() {
+  const uint32_t c[3] = { 0x00112233, 0x00445566, 0x00778899 };
+  uint8_t buf3[6*3];
+  std::fill(buf3, buf3 + sizeof(buf3), 0xEE);
+  writeWireOrderPixels<3>(buf3, 4, -1, c, 3, GRB);
+  const uint8_t ref3[6*3] = { 0xEE,0xEE,0xEE, 0xEE,0xEE,0xEE, 0x88,0x77,0x99, 0x55,0x44,0x66, 0x22,0x11,0x33, 0xEE,0xEE,0xEE };
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(ref3, buf3, sizeof(buf3));
+
+  const uint32_t w[2] = { 0xAA112233, 0xBB445566 };
+  uint8_t buf4[3*4];
+  std::fill(buf4, buf4 + sizeof(buf4), 0xEE);
+  writeWireOrderPixels<4>(buf4, 1, 1, w, 2, RGB);
+  const uint8_t ref4[3*4] = { 0xEE,0xEE,0xEE,0xEE, 0x11,0x22,0x33,0xAA, 0x44,0x55,0x66,0xBB };
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(ref4, buf4, sizeof(buf4));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_map_is_one_span);
+  RUN_TEST(test_mapping_inside_bus);
+  RUN_TEST(test_overlapping_mappings_first_wins);
+  RUN_TEST(test_bus_not_at_zero_and_partial_overlap);
+  RUN_TEST(test_equal_neighbours_are_merged);
+  RUN_TEST(test_w_swap_nibble);
+  RUN_TEST(test_span_runs_match_per_pixel);
+  RUN_TEST(test_span_run_single_span);
+  RUN_TEST(test_wire_order_all_orders);
+  RUN_TEST(test_write_wire_order_pixels);
+  return UNITY_END();
+}
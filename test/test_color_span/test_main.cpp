@@ -0,0 +1,205 @@
+/*
+ * Host tests for span variants of color functions (wled00/color_span.h)
+ * spans must give the same result as the per pixel loops they replaced in Segment functions
+ * run with: pio test -e native -f test_color_span
+ * (add -D WLED_COLOR_NO_SIMD to build_flags to test plain C implementation on x86/ARM hosts)
+ */
+#include <unity.h>
+#include <vector>
+#include "color_span.h"
+
+void setUp() {}
+void tearDown() {}
+
+// reference: single pixel functions (colors.cpp)
+static uint32_t ref_color_blend(uint32_t color1, uint32_t color2, uint8_t blend) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  uint32_t rb1 =  color1       & TWO_CHANNEL_MASK;
+  uint32_t wg1 = (color1 >> 8) & TWO_CHANNEL_MASK;
+  uint32_t rb2 =  color2       & TWO_CHANNEL_MASK;
+  uint32_t wg2 = (color2 >> 8) & TWO_CHANNEL_MASK;
+  uint32_t rb3 = ((((rb1 << 8) | rb2) + (rb2 * blend) - (rb1 * blend)) >> 8) &  TWO_CHANNEL_MASK;
+  uint32_t wg3 = ((((wg1 << 8) | wg2) + (wg2 * blend) - (wg1 * blend)))      & ~TWO_CHANNEL_MASK;
+  return rb3 | wg3;
+}
+
+static uint32_t ref_color_add(uint32_t c1, uint32_t c2) { // color_add() without color ratio preservation
+  uint32_t r = 0;
+  for (int i = 0; i < 32; i += 8) {
+    unsigned ch = ((c1 >> i) & 0xFF) + ((c2 >> i) & 0xFF);
+    r |= (ch > 255 ? 255 : ch) << i;
+  }
+  return r;
+}
+
+static uint32_t ref_color_fade(uint32_t c1, uint8_t amount, bool video) {
+  if (c1 == 0 || amount == 0) return 0;
+  if (amount == 255) return c1;
+  uint32_t addRemains = 0;
+  if (!video) amount++;
+  else {
+    uint8_t r = uint8_t(c1>>16), g = uint8_t(c1>>8), b = uint8_t(c1), w = uint8_t(c1>>24);
+    uint8_t maxc = (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
+    addRemains  = r && (r<<5) > maxc ? 0x00010000 : 0;
+    addRemains |= g && (g<<5) > maxc ? 0x00000100 : 0;
+    addRemains |= b && (b<<5) > maxc ? 0x00000001 : 0;
+    addRemains |= w ? 0x01000000 : 0;
+  }
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  uint32_t rb = (((c1 & TWO_CHANNEL_MASK) * amount) >> 8) &  TWO_CHANNEL_MASK;
+  uint32_t wg = (((c1 >> 8) & TWO_CHANNEL_MASK) * amount) & ~TWO_CHANNEL_MASK;
+  return (rb | wg) + addRemains;
+}
+
+// reference: per pixel loops of Segment::fade_out() and Segment::blur()
+static void ref_fade_out(uint32_t *buf, size_t n, uint32_t target, int mappedRate) {
+  for (size_t j = 0; j < n; j++) {
+    uint32_t color = buf[j];
+    if (color == target) continue;
+    for (int i = 0; i < 32; i += 8) {
+      uint8_t c2 = (target>>i);
+      uint8_t c1 = (color>>i);
+      int delta = (c2 - c1) * mappedRate / 256;
+      if (delta == 0) delta += (c2 == c1) ? 0 : (c2 > c1) ? 1 : -1;
+      color &= ~(0xFF<<i);
+      color |= ((c1 + delta) & 0xFF) << i;
+    }
+    buf[j] = color;
+  }
+}
+
+static void ref_blur(uint32_t *buf, size_t n, size_t stride, uint8_t keep, uint8_t seep) {
+  if (n == 0) return;
+  uint32_t cur = buf[0];
+  uint32_t carryover = fast_color_scale(cur, seep);
+  buf[0] = fast_color_scale(cur, keep);
+  for (size_t i = 1; i < n; i++) {
+    cur = buf[i*stride];
+    uint32_t part = fast_color_scale(cur, seep);
+    cur = ref_color_add(fast_color_scale(cur, keep), carryover);
+    buf[(i-1)*stride] = ref_color_add(buf[(i-1)*stride], part);
+    buf[i*stride] = cur;
+    carryover = part;
+  }
+}
+
+// Unity refuses to compare empty arrays
+static void assertPixels(const std::vector<uint32_t> &expected, const std::vector<uint32_t> &actual) {
+  TEST_ASSERT_EQUAL(expected.size(), actual.size());
+  if (!expected.empty()) TEST_ASSERT_EQUAL_HEX32_ARRAY(expected.data(), actual.data(), expected.size());
+}
+
+static uint32_t rnd = 0x12345678;
+static uint32_t nextRandom() { rnd ^= rnd << 13; rnd ^= rnd >> 17; rnd ^= rnd << 5; return rnd; }
+
+// random pixels with some saturated and black channels, odd lengths exercise the tail after 4 pixel blocks
+static std::vector<uint32_t> randomPixels(size_t n) {
+  std::vector<uint32_t> px(n);
+  for (auto &c : px) {
+    c = nextRandom();
+    if ((c & 0x300) == 0)   c |= 0xFF00FF00;
+    if ((c & 0xC00) == 0)   c &= 0x00FF00FF;
+  }
+  return px;
+}
+
+void test_scale_span_matches_fast_color_scale() {
+  for (size_t n = 0; n < 20; n++) {
+    for (unsigned scale = 0; scale < 256; scale++) {
+      std::vector<uint32_t> px = randomPixels(n), ref = px;
+      for (auto &c : ref) c = fast_color_scale(c, scale);
+      color_scale_span(px.data(), n, scale);
+      assertPixels(ref, px);
+    }
+  }
+}
+
+void test_blend_span_matches_color_blend() {
+  for (size_t n = 0; n < 20; n++) {
+    for (unsigned blend = 0; blend < 256; blend++) {
+      const uint32_t c = nextRandom();
+      std::vector<uint32_t> px = randomPixels(n), ref = px;
+      for (auto &p : ref) p = ref_color_blend(p, c, blend);
+      color_blend_span(px.data(), n, c, blend);
+      assertPixels(ref, px);
+    }
+  }
+}
+
+void test_fade_span_matches_color_fade() {
+  for (unsigned video = 0; video < 2; video++) {
+    for (size_t n = 0; n < 20; n++) {
+      for (unsigned amount = 0; amount < 256; amount++) {
+        std::vector<uint32_t> px = randomPixels(n), ref = px;
+        if (n > 2) px[1] = ref[1] = 0x00200001; // blue below 1/32 of red is dropped in video mode
+        for (auto &c : ref) c = ref_color_fade(c, amount, video);
+        color_fade_span(px.data(), n, amount, video);
+        assertPixels(ref, px);
+      }
+    }
+  }
+}
+
+void test_add_span_matches_color_add() {
+  for (size_t n = 0; n < 20; n++) {
+    std::vector<uint32_t> px = randomPixels(n), src = randomPixels(n), ref = px;
+    for (size_t i = 0; i < n; i++) ref[i] = ref_color_add(ref[i], src[i]);
+    color_add_span(px.data(), src.data(), n);
+    assertPixels(ref, px);
+  }
+}
+
+void test_fade_out_span_matches_fade_out() {
+  for (unsigned rate = 0; rate < 256; rate++) {
+    const int mappedRate = 256 / (((256 - rate) >> 1) + 1); // same mapping as Segment::fade_out()
+    for (unsigned k = 0; k < 8; k++) {
+      const uint32_t target = k == 0 ? 0 : k == 1 ? 0xFFFFFFFF : nextRandom();
+      std::vector<uint32_t> px = randomPixels(37), ref = px;
+      px[3] = ref[3] = target; // pixel already at target
+      for (unsigned step = 0; step < 4; step++) { // repeated fades converge to target
+        ref_fade_out(ref.data(), ref.size(), target, mappedRate);
+        color_fade_out_span(px.data(), px.size(), target, mappedRate);
+        assertPixels(ref, px);
+      }
+    }
+  }
+}
+
+void test_blur_span_matches_blur() {
+  for (unsigned amount = 1; amount < 256; amount += 3) {
+    for (unsigned smear = 0; smear < 2; smear++) {
+      const uint8_t keep = smear ? 255 : 255 - amount;
+      const uint8_t seep = amount >> 1;
+      for (size_t n = 0; n < 12; n++) {
+        std::vector<uint32_t> px = randomPixels(n), ref = px;
+        ref_blur(ref.data(), n, 1, keep, seep);
+        color_blur_span(px.data(), n, 1, keep, seep);
+        assertPixels(ref, px);
+      }
+    }
+  }
+}
+
+// column blur of 2D segment (stride = width), other columns must not change
+void test_blur_span_with_stride() {
+  const size_t cols = 5, rows = 7;
+  std::vector<uint32_t> px = randomPixels(cols * rows), ref = px;
+  for (size_t col = 0; col < cols; col++) ref_blur(ref.data() + col, rows, cols, 200, 27);
+  for (size_t col = 0; col < cols; col++) color_blur_span(px.data() + col, rows, cols, 200, 27);
+  assertPixels(ref, px);
+  std::vector<uint32_t> one = randomPixels(cols * rows), before = one;
+  color_blur_span(one.data() + 2, rows, cols, 200, 27);
+  for (size_t i = 0; i < one.size(); i++) if (i % cols != 2) TEST_ASSERT_EQUAL_HEX32(before[i], one[i]);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_scale_span_matches_fast_color_scale);
+  RUN_TEST(test_blend_span_matches_color_blend);
+  RUN_TEST(test_fade_span_matches_color_fade);
+  RUN_TEST(test_add_span_matches_color_add);
+  RUN_TEST(test_fade_out_span_matches_fade_out);
+  RUN_TEST(test_blur_span_with_stride);
+  RUN_TEST(test_blur_span_matches_blur);
+  return UNITY_END();
+}
@@ -0,0 +1,87 @@
+/*
+ * Host tests for non-blocking BusManager::show() bookkeeping (wled00/bus_show.h)
+ * run with: pio test -e native -f test_deferred_show
+ */
+#include <unity.h>
+#include <vector>
+#include "bus_show.h"
+
+struct FakeBus {
+  bool     busy  = false; // still sending previous frame
+  unsigned shown = 0;     // number of frames sent
+  bool canShow() const { return !busy; }
+  void show()          { shown++; }
+};
+
+static std::vector<FakeBus*> buses;
+static FakeBus a, b;
+
+void setUp() {
+  a = FakeBus(); b = FakeBus();
+  buses = { &a, &b };
+}
+void tearDown() {}
+
+void test_idle_buses_are_shown_immediately() {
+  DeferredShow ds;
+  TEST_ASSERT_FALSE(ds.show(buses, 0));
+  TEST_ASSERT_EQUAL(1, a.shown);
+  TEST_ASSERT_EQUAL(1, b.shown);
+  TEST_ASSERT_FALSE(ds.isPending());
+}
+
+// frame shown while bus is busy, then only loop() flushes (no further show()/service())
+void test_busy_frame_is_flushed_without_service() {
+  DeferredShow ds;
+  b.busy = true;
+  TEST_ASSERT_TRUE(ds.show(buses, 1000));
+  TEST_ASSERT_EQUAL(1, a.shown);
+  TEST_ASSERT_EQUAL(0, b.shown);
+  TEST_ASSERT_TRUE(ds.isPending());
+
+  ds.flush(buses, 1200); // still busy
+  TEST_ASSERT_EQUAL(0, b.shown);
+  TEST_ASSERT_TRUE(ds.isPending());
+
+  b.busy = false;
+  ds.flush(buses, 1500);
+  TEST_ASSERT_EQUAL(1, b.shown);
+  TEST_ASSERT_EQUAL(1, a.shown); // idle bus is not sent twice
+  TEST_ASSERT_FALSE(ds.isPending());
+  TEST_ASSERT_EQUAL(0, ds.getDropped());
+
+  ds.flush(buses, 2000); // nothing left to send
+  TEST_ASSERT_EQUAL(1, b.shown);
+}
+
+void test_overwritten_frame_counts_as_dropped() {
+  DeferredShow ds;
+  b.busy = true;
+  ds.show(buses, 0);
+  ds.show(buses, 100); // new frame before previous one was sent
+  TEST_ASSERT_EQUAL(1, ds.getDropped());
+  b.busy = false;
+  ds.flush(buses, 300);
+  TEST_ASSERT_EQUAL(1, b.shown);
+  TEST_ASSERT_EQUAL(300 >> 4, ds.getWaitTime()); // waited since first deferral (300us), averaged over 16 frames
+}
+
+void test_clear_forgets_pending_frame() {
+  DeferredShow ds;
+  a.busy = true;
+  ds.show(buses, 0);
+  ds.clear();
+  TEST_ASSERT_FALSE(ds.isPending());
+  a.busy = false;
+  ds.flush(buses, 10);
+  TEST_ASSERT_EQUAL(0, a.shown);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_idle_buses_are_shown_immediately);
+  RUN_TEST(test_busy_frame_is_flushed_without_service);
+  RUN_TEST(test_overwritten_frame_counts_as_dropped);
+  RUN_TEST(test_clear_forgets_pending_frame);
+  return UNITY_END();
+}
@@ -0,0 +1,118 @@
+/*
+ * Host tests for render queue shared by FX workers (wled00/render_queue.h)
+ * workers are std::thread, woken the same way as the host FX worker (see WS2812FX::fxWorker())
+ * run with: pio test -e native -f test_render_queue
+ */
+#include <unity.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "render_queue.h"
+
+void setUp() {}
+void tearDown() {}
+
+static constexpr unsigned QUEUE_SIZE = 32;  // MAX_NUM_SEGMENTS
+static constexpr unsigned WORKERS    = 4;   // loop() and 3 worker threads
+
+static thread_local unsigned workerIndex = 0;   // same as fxWorkerIndex: render context is bound to the thread
+
+// every entry of a queue is rendered exactly once, in queue order by a single worker
+void test_single_worker_renders_each_entry_once() {
+  RenderQueue<QUEUE_SIZE> q;
+  for (unsigned i = 0; i < 5; i++) q.entries()[i] = 10 + i;
+  q.publish(5);
+  std::vector<uint8_t> rendered;
+  q.drain([&](uint8_t i) { rendered.push_back(i); });
+  TEST_ASSERT_EQUAL(5, rendered.size());
+  for (unsigned i = 0; i < 5; i++) TEST_ASSERT_EQUAL(10 + i, rendered[i]);
+  TEST_ASSERT_TRUE(q.isDone());
+  q.drain([&](uint8_t) { TEST_FAIL_MESSAGE("drained queue must not render"); });
+}
+
+// a worker woken for the previous (drained) queue must not claim entries of an empty new one
+void test_empty_queue_is_done() {
+  RenderQueue<QUEUE_SIZE> q;
+  q.publish(0);
+  TEST_ASSERT_TRUE(q.isDone());
+  q.drain([&](uint8_t) { TEST_FAIL_MESSAGE("empty queue must not render"); });
+}
+
+// many frames rendered by several threads: each entry once per frame, each render context used by one thread at a time
+void test_threads_render_each_entry_once_per_frame() {
+  RenderQueue<QUEUE_SIZE> q;
+  std::mutex mtx;
+  std::condition_variable wake;
+  unsigned wakeGen = 0;
+  bool stop = false;
+  std::atomic<unsigned> frame(0);
+  std::atomic<unsigned> hits[QUEUE_SIZE];
+  std::atomic<unsigned> stale(0);       // renders of an entry for a frame that was already finished
+  std::atomic<bool>     busy[WORKERS];  // render context of each worker
+  std::atomic<unsigned> overlaps(0);
+  unsigned              wrongCount = 0; // frames in which an entry was not rendered exactly once
+  std::atomic<unsigned> byWorker[WORKERS];
+  for (auto &h : hits)     h = 0;
+  for (auto &b : busy)     b = false;
+  for (auto &w : byWorker) w = 0;
+
+  const auto render = [&](uint8_t i) {
+    if (busy[workerIndex].exchange(true)) overlaps++;
+    const unsigned f = frame.load();
+    if (hits[i].fetch_add(1) != 0 || f != frame.load()) stale++;
+    for (volatile int spin = 0; spin < 200; spin++) {} // effect work
+    byWorker[workerIndex]++;
+    busy[workerIndex] = false;
+  };
+  const auto worker = [&](unsigned index) {
+    workerIndex = index;
+    unsigned gen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        wake.wait(lock, [&]{ return stop || gen != wakeGen; });
+        if (stop) return;
+        gen = wakeGen;
+      }
+      q.drain(render);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned w = 1; w < WORKERS; w++) threads.emplace_back(worker, w);
+
+  uint32_t rnd = 12345;
+  for (unsigned f = 0; f < 3000; f++) {
+    rnd = rnd * 1664525U + 1013904223U;
+    const unsigned len = 2 + (rnd >> 24) % (QUEUE_SIZE - 1); // 2..QUEUE_SIZE
+    for (unsigned i = 0; i < len; i++) q.entries()[i] = i;
+    for (auto &h : hits) h = 0;
+    frame = f;
+    q.publish(len);
+    { std::lock_guard<std::mutex> lock(mtx); wakeGen++; }
+    wake.notify_all();
+    q.drain(render);
+    while (!q.isDone()) std::this_thread::yield();
+    for (unsigned i = 0; i < QUEUE_SIZE; i++) if (hits[i].load() != (i < len)) wrongCount++; // asserted after threads are joined
+  }
+  { std::lock_guard<std::mutex> lock(mtx); stop = true; }
+  wake.notify_all();
+  for (auto &t : threads) t.join();
+
+  TEST_ASSERT_EQUAL(0, wrongCount);
+  TEST_ASSERT_EQUAL(0, stale.load());
+  TEST_ASSERT_EQUAL(0, overlaps.load());
+  unsigned helpers = 0;
+  for (unsigned w = 1; w < WORKERS; w++) helpers += byWorker[w].load();
+  TEST_ASSERT_GREATER_THAN(0, byWorker[0].load());
+  TEST_ASSERT_GREATER_THAN(0, helpers); // worker threads took part
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_single_worker_renders_each_entry_once);
+  RUN_TEST(test_empty_queue_is_done);
+  RUN_TEST(test_threads_render_each_entry_once_per_frame);
+  return UNITY_END();
+}
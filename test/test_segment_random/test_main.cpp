@@ -0,0 +1,72 @@
+/*
+ * Host tests for PRNG of seeded segments (wled00/segment_random.h)
+ * run with: pio test -e native -f test_segment_random
+ */
+#include <unity.h>
+#include <vector>
+#include "segment_random.h"
+
+void setUp() {}
+void tearDown() {}
+
+// random numbers an effect draws in one frame
+static std::vector<uint32_t> frame(uint16_t seed, unsigned segment, bool previousMode, uint32_t call, size_t n = 64) {
+  uint32_t state = segmentRandomState(seed, segment, previousMode, call);
+  std::vector<uint32_t> r(n);
+  for (auto &v : r) v = prng32(state);
+  return r;
+}
+
+// same frame of same effect gets same random numbers (every run, every synced controller)
+void test_frame_is_reproducible() {
+  for (uint32_t call = 0; call < 100; call++) {
+    const std::vector<uint32_t> a = frame(1234, 3, false, call), b = frame(1234, 3, false, call);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(a.data(), b.data(), a.size());
+  }
+}
+
+// seed, segment, old/new effect of a transition and frame counter each select a different sequence
+void test_inputs_select_different_sequences() {
+  const std::vector<uint32_t> base = frame(1234, 3, false, 10);
+  const std::vector<std::vector<uint32_t>> other = {
+    frame(1235, 3, false, 10), frame(1234, 2, false, 10), frame(1234, 3, true, 10), frame(1234, 3, false, 11)
+  };
+  for (const auto &o : other) {
+    unsigned equal = 0;
+    for (size_t i = 0; i < base.size(); i++) equal += base[i] == o[i];
+    TEST_ASSERT_EQUAL(0, equal);
+  }
+}
+
+// hw_random8()/hw_random16() truncate: low bits of first number of consecutive frames must be evenly distributed
+// (an effect often draws only one or two numbers per frame, and states of consecutive frames differ in low bits only)
+void test_first_number_of_consecutive_frames_is_uniform() {
+  const unsigned frames = 256 * 64;
+  for (unsigned shift : {0, 8, 16, 24}) { // each byte
+    unsigned hist[256] = {};
+    for (uint32_t call = 0; call < frames; call++) hist[(frame(42, 0, false, call, 1)[0] >> shift) & 0xFF]++;
+    double chi2 = 0.0;
+    for (unsigned h : hist) chi2 += (h - 64.0) * (h - 64.0) / 64.0;
+    TEST_ASSERT_LESS_THAN(350.0, chi2); // 255 degrees of freedom, p < 0.0001
+  }
+}
+
+// sequence is part of the file format of golden frame hashes (fx_golden.cpp) and of what synced controllers render:
+// changing prng32() or segmentRandomState() must be a deliberate decision, update the constant then
+void test_frame_hash_is_pinned() {
+  uint32_t hash = 2166136261U; // FNV-1a over 16 frames of 2 segments, both sides of a transition
+  for (unsigned segment = 0; segment < 2; segment++)
+    for (bool previousMode : {false, true})
+      for (uint32_t call = 0; call < 16; call++)
+        for (uint32_t v : frame(1234, segment, previousMode, call, 16)) hash = (hash ^ v) * 16777619U;
+  TEST_ASSERT_EQUAL_HEX32(0xEDFA4DF3U, hash);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_is_reproducible);
+  RUN_TEST(test_inputs_select_different_sequences);
+  RUN_TEST(test_first_number_of_consecutive_frames_is_uniform);
+  RUN_TEST(test_frame_hash_is_pinned);
+  return UNITY_END();
+}
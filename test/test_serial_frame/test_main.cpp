@@ -0,0 +1,126 @@
+/*
+ * Host tests for Adalight/TPM2 frame parsing (wled00/serial_frame.h)
+ * streams are replayed the way handleSerial() feeds them: header bytes one at a time, pixel data in blocks
+ * run with: pio test -e native -f test_serial_frame
+ */
+#include <unity.h>
+#include <vector>
+#include <algorithm>
+#include "serial_frame.h"
+
+struct Pixel { unsigned i; uint8_t r, g, b; };
+
+static std::vector<Pixel> pixels;
+static unsigned frames, commands, pings;
+
+void setUp() { pixels.clear(); frames = commands = pings = 0; }
+void tearDown() {}
+
+// replays stream, pixel data is read in blocks of at most block bytes (like Serial.readBytes() with limited availability)
+static void replay(SerialFrameParser &p, const std::vector<uint8_t> &stream, size_t block) {
+  size_t pos = 0;
+  while (pos < stream.size()) {
+    if (p.isData()) {
+      const size_t len = std::min(std::min(stream.size() - pos, p.bytesLeft()), block);
+      if (p.data(&stream[pos], len, [](unsigned i, uint8_t r, uint8_t g, uint8_t b) { pixels.push_back({i, r, g, b}); })) frames++;
+      pos += len;
+      continue;
+    }
+    switch (p.header(stream[pos++])) {
+      case SerialFrameParser::Event::Command: commands++; break;
+      case SerialFrameParser::Event::Ping:    pings++;    break;
+      default: break;
+    }
+  }
+}
+
+static std::vector<uint8_t> adalight(unsigned n, uint8_t seed) {
+  const unsigned hi = (n - 1) >> 8, lo = (n - 1) & 0xFF;
+  std::vector<uint8_t> s = { 'A', 'd', 'a', (uint8_t)hi, (uint8_t)lo, (uint8_t)(hi ^ lo ^ 0x55) };
+  for (unsigned i = 0; i < 3*n; i++) s.push_back(uint8_t(seed + i));
+  return s;
+}
+
+static std::vector<uint8_t> tpm2(unsigned bytes, uint8_t seed) {
+  std::vector<uint8_t> s = { 0xC9, 0xDA, (uint8_t)(bytes >> 8), (uint8_t)bytes };
+  for (unsigned i = 0; i < bytes; i++) s.push_back(uint8_t(seed + i));
+  s.push_back(0x36); // TPM2 end byte (ignored as command)
+  return s;
+}
+
+static void checkPixels(unsigned n, uint8_t seed) {
+  TEST_ASSERT_EQUAL(n, pixels.size());
+  for (unsigned i = 0; i < n; i++) {
+    TEST_ASSERT_EQUAL(i, pixels[i].i);
+    TEST_ASSERT_EQUAL(uint8_t(seed + 3*i),     pixels[i].r);
+    TEST_ASSERT_EQUAL(uint8_t(seed + 3*i + 1), pixels[i].g);
+    TEST_ASSERT_EQUAL(uint8_t(seed + 3*i + 2), pixels[i].b);
+  }
+}
+
+// result must not depend on how pixel data is split into blocks (pixels split between reads)
+void test_adalight_any_block_size() {
+  for (size_t block : {1, 2, 3, 4, 5, 64, 192}) {
+    setUp();
+    SerialFrameParser p;
+    replay(p, adalight(100, 7), block);
+    TEST_ASSERT_EQUAL(1, frames);
+    checkPixels(100, 7);
+    TEST_ASSERT_TRUE(p.getState() == SerialFrameParser::State::Header_A);
+  }
+}
+
+void test_adalight_bad_checksum_is_dropped() {
+  SerialFrameParser p;
+  std::vector<uint8_t> s = adalight(10, 0);
+  s[5] ^= 1;
+  replay(p, s, 192);
+  TEST_ASSERT_EQUAL(0, frames);
+  TEST_ASSERT_EQUAL(1, p.getDropped());
+  TEST_ASSERT_EQUAL(0, pixels.size());
+}
+
+// TPM2 size is (hi*256 + lo)/3 pixels
+void test_tpm2_size() {
+  SerialFrameParser p;
+  replay(p, tpm2(3*300, 1), 7); // 900 bytes: hi/3 + lo/3 would give 85 + 44 pixels
+  TEST_ASSERT_EQUAL(1, frames);
+  checkPixels(300, 1);
+  TEST_ASSERT_EQUAL(1, commands); // end byte
+}
+
+void test_tpm2_empty_frame_is_dropped() {
+  SerialFrameParser p;
+  replay(p, { 0xC9, 0xDA, 0x00, 0x02 }, 192);
+  TEST_ASSERT_EQUAL(1, p.getDropped());
+  TEST_ASSERT_TRUE(p.getState() == SerialFrameParser::State::Header_A);
+}
+
+void test_tpm2_ping_and_commands() {
+  SerialFrameParser p;
+  replay(p, { 'v', 0xC9, 0xAA, 'A', 'x', 'l' }, 192); // version, ping, broken Adalight header, JSON request
+  TEST_ASSERT_EQUAL(1, pings);
+  TEST_ASSERT_EQUAL(2, commands); // 'x' breaks Adalight header and is not reprocessed
+  TEST_ASSERT_EQUAL(0, frames);
+}
+
+void test_consecutive_frames() {
+  SerialFrameParser p;
+  std::vector<uint8_t> s = adalight(5, 10), t = tpm2(15, 10);
+  s.insert(s.end(), t.begin(), t.end());
+  replay(p, s, 4);
+  TEST_ASSERT_EQUAL(2, frames);
+  TEST_ASSERT_EQUAL(10, pixels.size());
+  TEST_ASSERT_EQUAL(0, pixels[5].i); // second frame starts at pixel 0
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_adalight_any_block_size);
+  RUN_TEST(test_adalight_bad_checksum_is_dropped);
+  RUN_TEST(test_tpm2_size);
+  RUN_TEST(test_tpm2_empty_frame_is_dropped);
+  RUN_TEST(test_tpm2_ping_and_commands);
+  RUN_TEST(test_consecutive_frames);
+  return UNITY_END();
+}
@@ -0,0 +1,250 @@
+#pragma once
+/*
+   Real-input FFT for the audioreactive usermod
+
+   Audio samples are real numbers, so running them through a complex FFT with the imaginary
+   part set to zero wastes half of the work. These classes pack the N real samples into N/2
+   complex values, run an N/2 point complex FFT and "unpack" the result into the N/2+1 bins
+   of the real spectrum. Window and twiddle factors are computed once in begin().
+
+   compute() is a drop-in replacement for the ArduinoFFT sequence used in FFTcode()
+     dcRemoval() -> windowing(Flat_top) -> compute() -> complexToMagnitude()
+   It leaves the magnitudes in data[0 .. N-1] (upper half mirrored, like the complex FFT does),
+   so majorPeak() and the GEQ channel mapping work unchanged.
+
+   RealFFT     : float version, for MCUs with FPU (ESP32, ESP32-S3)
+   RealFFTQ15  : 16bit fixed-point version with block floating point scaling, for MCUs without FPU (ESP32-S2, -C3)
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// "Flat Top" window, same coefficients as ArduinoFFT (symmetric, only the first half is stored)
+static inline float realFFT_flatTop(unsigned i, unsigned samples) {
+  const double ratio = double(i) / double(samples - 1);
+  return float(0.2810639 - 0.5208972 * cos(2.0 * M_PI * ratio) + 0.1980399 * cos(4.0 * M_PI * ratio));
+}
+
+// reorder N/2 complex values (interleaved re/im) into bit-reversed order
+template<typename T> static void realFFT_bitReverse(T *z, unsigned m) {
+  for (unsigned i = 1, j = 0; i < m; i++) {
+    unsigned bit = m >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      T t = z[2*i];   z[2*i]   = z[2*j];   z[2*j]   = t;
+      t   = z[2*i+1]; z[2*i+1] = z[2*j+1]; z[2*j+1] = t;
+    }
+  }
+}
+
+class RealFFT {
+  public:
+    ~RealFFT() { end(); }
+
+    // allocate and fill window and twiddle tables. samples must be a power of 2 (>= 8)
+    bool begin(uint16_t samples) {
+      if (_samples == samples && _window) return true;
+      end();
+      if (samples < 8 || (samples & (samples - 1))) return false;
+      _window = (float*) malloc(sizeof(float) * samples * 3/2); // N/2 window weights, N/2 cos, N/2 sin
+      if (!_window) return false;
+      _samples = samples;
+      _cos = _window + samples/2;
+      _sin = _cos + samples/2;
+      for (unsigned i = 0; i < samples/2; i++) {
+        _window[i] = realFFT_flatTop(i, samples);
+        _cos[i] = float(cos(2.0 * M_PI * i / samples));
+        _sin[i] = float(sin(2.0 * M_PI * i / samples));
+      }
+      return true;
+    }
+
+    void end() {
+      free(_window);
+      _window = _cos = _sin = nullptr;
+      _samples = 0;
+    }
+
+    // in: samples[0 .. N-1]; out: magnitudes in data[0 .. N/2], mirrored into data[N/2+1 .. N-1]
+    void compute(float *data) const {
+      if (!_window) return;
+      const unsigned n = _samples;
+      const unsigned m = n / 2;
+
+      // DC removal and windowing
+      float mean = 0.0f;
+      for (unsigned i = 0; i < n; i++) mean += data[i];
+      mean /= float(n);
+      for (unsigned i = 0; i < m; i++) {
+        data[i]       = (data[i]       - mean) * _window[i];
+        data[n-1 - i] = (data[n-1 - i] - mean) * _window[i];
+      }
+
+      // N/2 point complex FFT: even samples are the real part, odd samples the imaginary part
+      realFFT_bitReverse(data, m);
+      for (unsigned len = 2, step = m; len <= m; len <<= 1, step >>= 1) {
+        const unsigned half = len / 2;
+        for (unsigned k = 0; k < half; k++) {
+          const float wr = _cos[k*step];
+          const float wi = -_sin[k*step];
+          for (unsigned i = k; i < m; i += len) {
+            float *a = data + 2*i;
+            float *b = data + 2*(i + half);
+            const float tr = b[0]*wr - b[1]*wi;
+            const float ti = b[0]*wi + b[1]*wr;
+            b[0] = a[0] - tr; b[1] = a[1] - ti;
+            a[0] += tr;       a[1] += ti;
+          }
+        }
+      }
+
+      // unpack into the real spectrum X[0 .. N/2]; X[k] and X[N/2-k] are computed together
+      const float nyquist = data[0] - data[1];
+      data[0] = data[0] + data[1];
+      data[1] = 0.0f;
+      for (unsigned k = 1; k <= m/2; k++) {
+        float *a = data + 2*k;
+        float *b = data + 2*(m - k);
+        const float er = 0.5f * (a[0] + b[0]), ei = 0.5f * (a[1] - b[1]);   // even part
+        const float or_ = 0.5f * (a[1] + b[1]), oi = 0.5f * (b[0] - a[0]);  // odd part
+        const float wr = _cos[k], wi = -_sin[k];
+        const float tr = or_*wr - oi*wi;
+        const float ti = or_*wi + oi*wr;
+        a[0] = er + tr; a[1] = ei + ti;
+        b[0] = er - tr; b[1] = ti - ei;   // conj(even - w*odd)
+      }
+
+      // magnitudes (compact in place: bin k is read from 2k/2k+1, which is never below k)
+      data[0] = fabsf(data[0]);
+      for (unsigned k = 1; k < m; k++) data[k] = sqrtf(data[2*k]*data[2*k] + data[2*k+1]*data[2*k+1]);
+      data[m] = fabsf(nyquist);
+      for (unsigned k = 1; k < m; k++) data[n - k] = data[k];
+    }
+
+  private:
+    uint16_t _samples = 0;
+    float *_window = nullptr;
+    float *_cos = nullptr;
+    float *_sin = nullptr;
+};
+
+class RealFFTQ15 {
+  public:
+    ~RealFFTQ15() { end(); }
+
+    // allocate and fill window and twiddle tables plus the 16bit work buffer. samples must be a power of 2 (>= 8)
+    bool begin(uint16_t samples) {
+      if (_samples == samples && _window) return true;
+      end();
+      if (samples < 8 || (samples & (samples - 1))) return false;
+      _window = (int16_t*) malloc(sizeof(int16_t) * samples * 5/2); // N/2 window, N/2 cos, N/2 sin, N work
+      if (!_window) return false;
+      _samples = samples;
+      _cos  = _window + samples/2;
+      _sin  = _cos + samples/2;
+      _work = _sin + samples/2;
+      for (unsigned i = 0; i < samples/2; i++) {
+        _window[i] = toQ15(realFFT_flatTop(i, samples));
+        _cos[i] = toQ15(float(cos(2.0 * M_PI * i / samples)));
+        _sin[i] = toQ15(float(sin(2.0 * M_PI * i / samples)));
+      }
+      return true;
+    }
+
+    void end() {
+      free(_window);
+      _window = _cos = _sin = _work = nullptr;
+      _samples = 0;
+    }
+
+    // in: samples[0 .. N-1]; out: magnitudes in data[0 .. N/2], mirrored into data[N/2+1 .. N-1]
+    void compute(float *data) const {
+      if (!_window) return;
+      const unsigned n = _samples;
+      const unsigned m = n / 2;
+      int16_t *z = _work;
+
+      // DC removal, then normalize so that the largest windowed sample stays below 2^13 (headroom for the first stage)
+      float mean = 0.0f;
+      for (unsigned i = 0; i < n; i++) mean += data[i];
+      mean /= float(n);
+      float peak = 0.0f;
+      for (unsigned i = 0; i < n; i++) peak = fmaxf(peak, fabsf(data[i] - mean));
+      if (peak < 1e-6f) { memset(data, 0, sizeof(float) * n); return; }
+      int exponent;
+      frexpf(peak, &exponent);                   // peak < 2^exponent
+      int scale = 13 - exponent;                 // result = q * 2^-scale
+      const float norm = ldexpf(1.0f, scale);
+      for (unsigned i = 0; i < m; i++) {
+        z[i]       = mulQ15(int16_t((data[i]       - mean) * norm), _window[i]);
+        z[n-1 - i] = mulQ15(int16_t((data[n-1 - i] - mean) * norm), _window[i]);
+      }
+
+      // N/2 point complex FFT with block floating point: a stage can grow values by up to 1+sqrt(2),
+      // so every stage starts with |values| < 2^13 and the block is shifted down if the previous stage went above
+      realFFT_bitReverse(z, m);
+      int maxVal = 0;
+      for (unsigned len = 2, step = m; len <= m; len <<= 1, step >>= 1) {
+        if (maxVal >= 8192) {
+          const int shift = (maxVal >= 16384) ? 2 : 1;
+          for (unsigned i = 0; i < n; i++) z[i] >>= shift;
+          scale -= shift;
+        }
+        maxVal = 0;
+        const unsigned half = len / 2;
+        for (unsigned k = 0; k < half; k++) {
+          const int wr = _cos[k*step];
+          const int wi = -_sin[k*step];
+          for (unsigned i = k; i < m; i += len) {
+            int16_t *a = z + 2*i;
+            int16_t *b = z + 2*(i + half);
+            const int tr = (b[0]*wr - b[1]*wi + 16384) >> 15;
+            const int ti = (b[0]*wi + b[1]*wr + 16384) >> 15;
+            const int br = a[0] - tr, bi = a[1] - ti;
+            const int ar = a[0] + tr, ai = a[1] + ti;
+            b[0] = br; b[1] = bi; a[0] = ar; a[1] = ai;
+            const int peak = maxAbs4(ar, ai, br, bi);
+            if (peak > maxVal) maxVal = peak;
+          }
+        }
+      }
+      if (maxVal >= 8192) {                      // same headroom for the unpack step
+        const int shift = (maxVal >= 16384) ? 2 : 1;
+        for (unsigned i = 0; i < n; i++) z[i] >>= shift;
+        scale -= shift;
+      }
+
+      // unpack straight into float magnitudes (no need to store the complex spectrum)
+      const float gain = ldexpf(1.0f, -scale);
+      data[0] = fabsf(float(z[0] + z[1])) * gain;
+      data[m] = fabsf(float(z[0] - z[1])) * gain;
+      for (unsigned k = 1; k <= m/2; k++) {
+        const int16_t *a = z + 2*k;
+        const int16_t *b = z + 2*(m - k);
+        const int er = (a[0] + b[0]) >> 1, ei = (a[1] - b[1]) >> 1;   // even part
+        const int or_ = (a[1] + b[1]) >> 1, oi = (b[0] - a[0]) >> 1;  // odd part
+        const int wr = _cos[k], wi = -_sin[k];
+        const int tr = (or_*wr - oi*wi + 16384) >> 15;
+        const int ti = (or_*wi + oi*wr + 16384) >> 15;
+        data[k]     = magnitude(er + tr, ei + ti) * gain;
+        data[m - k] = magnitude(er - tr, ti - ei) * gain;
+      }
+      for (unsigned k = 1; k < m; k++) data[n - k] = data[k];
+    }
+
+  private:
+    static int16_t toQ15(float v) { return int16_t(constrain15(lrintf(v * 32768.0f))); }
+    static long constrain15(long v) { return v > 32767 ? 32767 : (v < -32768 ? -32768 : v); }
+    static int16_t mulQ15(int16_t a, int16_t b) { return int16_t((int32_t(a) * b + 16384) >> 15); }
+    static int maxAbs4(int a, int b, int c, int d) { a = abs(a); b = abs(b); c = abs(c); d = abs(d); a = a > b ? a : b; c = c > d ? c : d; return a > c ? a : c; }
+    static float magnitude(int re, int im) { return sqrtf(float(re*re + im*im)); }
+
+    uint16_t _samples = 0;
+    int16_t *_window = nullptr;
+    int16_t *_cos = nullptr;
+    int16_t *_sin = nullptr;
+    int16_t *_work = nullptr;
+};
@@ -0,0 +1,183 @@
+#pragma once
+/*
+   GEQ channels of the audioreactive usermod
+
+   FFTcode() averages the useful FFT result bins (512 samples @ 22050 Hz, bin width ~43 Hz) into 16 frequency
+   channels with geqMapChannels(). geqPostProcess() then turns them into the fftResult[] values used by effects:
+   pink noise correction, gain (AGC multiplier or manual gain), rise/fall smoothing (used when the dynamics limiter
+   is on), scaling (none/logarithmic/linear/square root) and the extra "GEQ Gain".
+*/
+
+#include <stdint.h>
+#include <math.h>
+
+// the following are observed values, supported by a bit of "educated guessing"
+//#define FFT_DOWNSCALE 0.65f                             // 20kHz - downscaling factor for FFT results - "Flat-Top" window @20Khz, old freq channels
+#define FFT_DOWNSCALE 0.46f                             // downscaling factor for FFT results - for "Flat-Top" window @22Khz, new freq channels
+#define LOG_256  5.54517744f                            // log(256)
+
+struct GEQSettings {
+  const float *pink;        // per channel correction of the frequency response
+  float        gain;        // AGC multiplier, or manual gain from sampleGain and inputLevel
+  float        postGain;    // extra "GEQ Gain" applied after scaling (1.0 = none)
+  float        riseKeep;    // smoothing of rising and falling channel values (already adjusted to FFT overlap, see geqHopSmoothing())
+  float        fallKeep;
+  bool         limiter;     // dynamics limiter on: use smoothed values
+  uint8_t      scalingMode; // 0 none; 1 optimized logarithmic; 2 optimized linear; 3 optimized square root
+};
+
+static inline float geqConstrain(float v, float lo, float hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+// compute average of several FFT result bins
+static inline float geqAddAvg(const float *bins, int from, int to) {
+  float result = 0.0f;
+  for (int i = from; i <= to; i++) {
+    result += bins[i];
+  }
+  return result / float(to - from + 1);
+}
+
+// smoothing factors below were tuned for one FFT run per ~23ms. With overlapping windows the FFT runs 2x or 4x as often,
+// so the factor is taken to the power of 1/2 or 1/4 to keep the same rise/fall times.
+static inline float geqHopSmoothing(float keep, unsigned overlap)
+{
+  switch (overlap) {
+    case 1:  return sqrtf(keep);
+    case 2:  return sqrtf(sqrtf(keep));
+    default: return keep;
+  }
+}
+
+// mapping of FFT result bins (bins[0 .. 255]) to 16 frequency channels
+static void geqMapChannels(const float *bins, float *channels, bool bandPass)
+{
+#if 0
+    /* This FFT post processing is a DIY endeavour. What we really need is someone with sound engineering expertise to do a great job here AND most importantly, that the animations look GREAT as a result.
+    *
+    * Andrew's updated mapping of 256 bins down to the 16 result bins with Sample Freq = 10240, samplesFFT = 512 and some overlap.
+    * Based on testing, the lowest/Start frequency is 60 Hz (with bin 3) and a highest/End frequency of 5120 Hz in bin 255.
+    * Now, Take the 60Hz and multiply by 1.320367784 to get the next frequency and so on until the end. Then determine the bins.
+    * End frequency = Start frequency * multiplier ^ 16
+    * Multiplier = (End frequency/ Start frequency) ^ 1/16
+    * Multiplier = 1.320367784
+    */                                              //  Range
+      channels[ 0] = geqAddAvg(bins,2,4);           // 60 - 100
+      channels[ 1] = geqAddAvg(bins,4,5);           // 80 - 120
+      channels[ 2] = geqAddAvg(bins,5,7);           // 100 - 160
+      channels[ 3] = geqAddAvg(bins,7,9);           // 140 - 200
+      channels[ 4] = geqAddAvg(bins,9,12);          // 180 - 260
+      channels[ 5] = geqAddAvg(bins,12,16);         // 240 - 340
+      channels[ 6] = geqAddAvg(bins,16,21);         // 320 - 440
+      channels[ 7] = geqAddAvg(bins,21,29);         // 420 - 600
+      channels[ 8] = geqAddAvg(bins,29,37);         // 580 - 760
+      channels[ 9] = geqAddAvg(bins,37,48);         // 740 - 980
+      channels[10] = geqAddAvg(bins,48,64);         // 960 - 1300
+      channels[11] = geqAddAvg(bins,64,84);         // 1280 - 1700
+      channels[12] = geqAddAvg(bins,84,111);        // 1680 - 2240
+      channels[13] = geqAddAvg(bins,111,147);       // 2220 - 2960
+      channels[14] = geqAddAvg(bins,147,194);       // 2940 - 3900
+      channels[15] = geqAddAvg(bins,194,250);       // 3880 - 5000 // avoid the last 5 bins, which are usually inaccurate
+#else
+      /* new mapping, optimized for 22050 Hz by softhack007 */
+                                                    // bins frequency  range
+      if (bandPass) {
+        // skip frequencies below 100hz
+        channels[ 0] = 0.8f * geqAddAvg(bins,3,4);
+        channels[ 1] = 0.9f * geqAddAvg(bins,4,5);
+        channels[ 2] = geqAddAvg(bins,5,6);
+        channels[ 3] = geqAddAvg(bins,6,7);
+        // don't use the last bins from 206 to 255.
+        channels[15] = geqAddAvg(bins,165,205) * 0.75f;   // 40 7106 - 8828 high             -- with some damping
+      } else {
+        channels[ 0] = geqAddAvg(bins,1,2);               // 1    43 - 86   sub-bass
+        channels[ 1] = geqAddAvg(bins,2,3);               // 1    86 - 129  bass
+        channels[ 2] = geqAddAvg(bins,3,5);               // 2   129 - 216  bass
+        channels[ 3] = geqAddAvg(bins,5,7);               // 2   216 - 301  bass + midrange
+        // don't use the last bins from 216 to 255. They are usually contaminated by aliasing (aka noise)
+        channels[15] = geqAddAvg(bins,165,215) * 0.70f;   // 50 7106 - 9259 high             -- with some damping
+      }
+      channels[ 4] = geqAddAvg(bins,7,10);                // 3   301 - 430  midrange
+      channels[ 5] = geqAddAvg(bins,10,13);               // 3   430 - 560  midrange
+      channels[ 6] = geqAddAvg(bins,13,19);               // 5   560 - 818  midrange
+      channels[ 7] = geqAddAvg(bins,19,26);               // 7   818 - 1120 midrange -- 1Khz should always be the center !
+      channels[ 8] = geqAddAvg(bins,26,33);               // 7  1120 - 1421 midrange
+      channels[ 9] = geqAddAvg(bins,33,44);               // 9  1421 - 1895 midrange
+      channels[10] = geqAddAvg(bins,44,56);               // 12 1895 - 2412 midrange + high mid
+      channels[11] = geqAddAvg(bins,56,70);               // 14 2412 - 3015 high mid
+      channels[12] = geqAddAvg(bins,70,86);               // 16 3015 - 3704 high mid
+      channels[13] = geqAddAvg(bins,86,104);              // 18 3704 - 4479 high mid
+      channels[14] = geqAddAvg(bins,104,165) * 0.88f;     // 61 4479 - 7106 high mid + high  -- with slight damping
+#endif
+}
+
+// scaling of one (gain adjusted) channel value to the 0 .. 255 range of fftResult[]
+static float geqScale(float currentResult, int channel, uint8_t scalingMode)
+{
+      switch (scalingMode) {
+        case 1:
+            // Logarithmic scaling
+            currentResult *= 0.42f;                      // 42 is the answer ;-)
+            currentResult -= 8.0f;                       // this skips the lowest row, giving some room for peaks
+            if (currentResult > 1.0f) currentResult = logf(currentResult); // log to base "e", which is the fastest log() function
+            else currentResult = 0.0f;                   // special handling, because log(1) = 0; log(0) = undefined
+            currentResult *= 0.85f + (float(channel)/18.0f);  // extra up-scaling for high frequencies
+            currentResult = currentResult * 255.0f / LOG_256; // map [log(1) ... log(255)] to [0 ... 255]
+        break;
+        case 2:
+            // Linear scaling
+            currentResult *= 0.30f;                     // needs a bit more damping, get stay below 255
+            currentResult -= 4.0f;                       // giving a bit more room for peaks
+            if (currentResult < 1.0f) currentResult = 0.0f;
+            currentResult *= 0.85f + (float(channel)/1.8f);   // extra up-scaling for high frequencies
+        break;
+        case 3:
+            // square root scaling
+            currentResult *= 0.38f;
+            currentResult -= 6.0f;
+            if (currentResult > 1.0f) currentResult = sqrtf(currentResult);
+            else currentResult = 0.0f;                   // special handling, because sqrt(0) = undefined
+            currentResult *= 0.85f + (float(channel)/4.5f);   // extra up-scaling for high frequencies
+            currentResult = currentResult * 255.0f / 16.0f; // map [sqrt(1) ... sqrt(256)] to [0 ... 255]
+        break;
+
+        case 0:
+        default:
+            // no scaling - leave freq bins as-is
+            currentResult -= 4; // just a bit more room for peaks
+        break;
+      }
+      return currentResult;
+}
+
+// post-processing and post-amp of GEQ channels: calc[] (mapped channels, modified in place) -> result[]
+// avg[] holds the smoothed channels and must be kept between runs
+static void geqPostProcess(float *calc, float *avg, uint8_t *result, int numberOfChannels, bool noiseGateOpen, const GEQSettings &geq)
+{
+    for (int i=0; i < numberOfChannels; i++) {
+
+      if (noiseGateOpen) { // noise gate open
+        // Adjustment for frequency curves.
+        calc[i] *= geq.pink[i];
+        if (geq.scalingMode > 0) calc[i] *= FFT_DOWNSCALE;  // adjustment related to FFT windowing function
+        // Manual linear adjustment of gain using sampleGain adjustment for different input types.
+        calc[i] *= geq.gain;
+        if(calc[i] < 0) calc[i] = 0;
+      }
+
+      // smooth results - rise fast, fall slower
+      if(calc[i] > avg[i])   // rise fast
+        avg[i] = calc[i]*(1.0f - geq.riseKeep) + geq.riseKeep*avg[i];  // will need approx 2 cycles (50ms) for converging against calc[i]
+      else                   // fall slow
+        avg[i] = calc[i]*(1.0f - geq.fallKeep) + geq.fallKeep*avg[i];
+      // constrain internal vars - just to be sure
+      calc[i] = geqConstrain(calc[i], 0.0f, 1023.0f);
+      avg[i] = geqConstrain(avg[i], 0.0f, 1023.0f);
+
+      float currentResult = geqScale(geq.limiter ? avg[i] : calc[i], i, geq.scalingMode);
+
+      // Now, let's dump it all into result. Need to do this, otherwise other routines might grab values prematurely.
+      currentResult *= geq.postGain;
+      int v = (int)currentResult;
+      result[i] = v < 0 ? 0 : (v > 255 ? 255 : v);
+    }
+}
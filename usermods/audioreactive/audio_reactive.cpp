@@ -119,6 +119,7 @@ static uint8_t inputLevel = 128;              // UI slider value
 #endif
 // user settable options for FFTResult scaling
 static uint8_t FFTScalingMode = 3;            // 0 none; 1 optimized logarithmic; 2 optimized linear; 3 optimized square root
+static uint8_t fftOverlap = 0;                // sliding window: 0 none; 1 50% overlap; 2 75% overlap. New samples per FFT run = samplesFFT >> fftOverlap (config value)
 
 // 
 // AGC presets
@@ -147,10 +148,9 @@ static bool useBandPassFilter = false;                    // if true, enables a
 ////////////////////
 
 // some prototypes, to ensure consistent interfaces
-static float fftAddAvg(int from, int to);   // average of several FFT result bins
 void FFTcode(void * parameter);      // audio processing task: read samples, run FFT, fill GEQ channels from FFT results
 static void runMicFilter(uint16_t numSamples, float *sampleBuffer);          // pre-filtering of raw samples (band-pass)
-static void postProcessFFTResults(bool noiseGateOpen, int numberOfChannels); // post-processing and post-amp of GEQ channels
+static void postProcessFFTResults(bool noiseGateOpen, int numberOfChannels, unsigned overlap); // post-processing and post-amp of GEQ channels
 
 static TaskHandle_t FFT_Task = nullptr;
 
@@ -162,6 +162,8 @@ static float fftResultPink[NUM_GEQ_CHANNELS] = { 1.70f, 1.71f, 1.73f, 1.78f, 1.6
 static uint64_t fftTime = 0;
 static uint64_t sampleTime = 0;
 #endif
+static float    fftTaskLoad = 0.0f;                                    // CPU time used by FFT task for processing (without waiting for samples), in % of one core
+static uint16_t fftTaskRate = 0;                                       // FFT runs per second
 
 // FFT Task variables (filtering and post-processing)
 static float   fftCalc[NUM_GEQ_CHANNELS] = {0.0f};                    // Try and normalize fftBin values to a max of 4096, so that 4096/16 = 256.
@@ -183,14 +185,12 @@ constexpr SRate_t SAMPLE_RATE = 22050;        // Base sample rate in Hz - 22Khz
 // FFT Constants
 constexpr uint16_t samplesFFT = 512;            // Samples in an FFT batch - This value MUST ALWAYS be a power of 2
 constexpr uint16_t samplesFFT_2 = 256;          // meaningfull part of FFT results - only the "lower half" contains useful information.
-// the following are observed values, supported by a bit of "educated guessing"
-//#define FFT_DOWNSCALE 0.65f                             // 20kHz - downscaling factor for FFT results - "Flat-Top" window @20Khz, old freq channels 
-#define FFT_DOWNSCALE 0.46f                             // downscaling factor for FFT results - for "Flat-Top" window @22Khz, new freq channels
-#define LOG_256  5.54517744f                            // log(256)
+#include "audio_geq.h"                          // mapping of FFT result bins to GEQ channels and their post-processing (FFT_DOWNSCALE)
 
 // These are the input and output vectors.  Input vectors receive computed results from FFT.
 static float* vReal = nullptr;                  // FFT sample inputs / freq output -  these are our raw result bins
 static float* vImag = nullptr;                  // imaginary parts
+static float* sampleRing = nullptr;             // last samplesFFT samples, for overlapping FFT windows (only allocated if fftOverlap > 0)
 
 // Create FFT object
 // lib_deps += https://github.com/kosme/arduinoFFT#develop @ 1.9.2
@@ -201,17 +201,17 @@ static float* vImag = nullptr;                  // imaginary parts
 // #define sqrt_internal sqrtf          // see https://github.com/kosme/arduinoFFT/pull/83 - since v2.0.0 this must be done in build_flags
 
 #include <arduinoFFT.h>             // FFT object is created in FFTcode
-// Helper functions
-
-// compute average of several FFT result bins
-static float fftAddAvg(int from, int to) {
-  float result = 0.0f;
-  for (int i = from; i <= to; i++) {
-    result += vReal[i];
-  }
-  return result / float(to - from + 1);
-}
 
+// Real-input FFT (see audio_fft.h) - processes the 512 real samples as 256 complex values, with precomputed tables.
+// -D SR_FFT_REAL : float version, roughly halves FFT time on MCUs with FPU
+// -D SR_FFT_Q15  : 16bit fixed-point version, for MCUs without FPU (-S2, -C3)
+#if defined(SR_FFT_Q15)
+  #include "audio_fft.h"
+  #define SR_REAL_FFT RealFFTQ15
+#elif defined(SR_FFT_REAL)
+  #include "audio_fft.h"
+  #define SR_REAL_FFT RealFFT
+#endif
 //
 // FFT main task
 //
@@ -221,6 +221,16 @@ void FFTcode(void * parameter)
 
   // allocate FFT buffers on first call
   if (vReal == nullptr) vReal = (float*) calloc(samplesFFT, sizeof(float));
+#ifdef SR_REAL_FFT
+  SR_REAL_FFT realFFT;                                 // real-input FFT does not need imaginary parts
+  if ((vReal == nullptr) || !realFFT.begin(samplesFFT)) {
+    // something went wrong
+    if (vReal) free(vReal); vReal = nullptr;
+    return;
+  }
+  // FFT object is only used for majorPeak()
+  ArduinoFFT<float> FFT = ArduinoFFT<float>( vReal, vImag, samplesFFT, SAMPLE_RATE, false);
+#else
   if (vImag == nullptr) vImag = (float*) calloc(samplesFFT, sizeof(float));
   if ((vReal == nullptr) || (vImag == nullptr)) {
     // something went wrong
@@ -230,15 +240,34 @@ void FFTcode(void * parameter)
   }
   // Create FFT object with weighing factor storage
   ArduinoFFT<float> FFT = ArduinoFFT<float>( vReal, vImag, samplesFFT, SAMPLE_RATE, true);
+#endif
 
-  // see https://www.freertos.org/vtaskdelayuntil.html
-  const TickType_t xFrequency = FFT_MIN_CYCLE * portTICK_PERIOD_MS;  
+  unsigned ringPos = 0;                       // write position in sampleRing (always a multiple of the hop size)
+  unsigned long loadStart = millis();         // CPU load measurement window
+  unsigned long busyMicros = 0;
+  unsigned fftRuns = 0;
 
   TickType_t xLastWakeTime = xTaskGetTickCount();
   for(;;) {
     delay(1);           // DO NOT DELETE THIS LINE! It is needed to give the IDLE(0) task enough time and to keep the watchdog happy.
                         // taskYIELD(), yield(), vTaskDelay() and esp_task_wdt_feed() didn't seem to work.
 
+    // sliding window: with overlap, only "hop" new samples are read per run; older samples are taken from the ring buffer
+    if (fftOverlap > 0 && sampleRing == nullptr) sampleRing = (float*) calloc(samplesFFT, sizeof(float));
+    const unsigned overlap = (sampleRing != nullptr && fftOverlap <= 2) ? fftOverlap : 0; // effective overlap (none if ring buffer could not be allocated)
+    const unsigned hop = samplesFFT >> overlap;
+    // see https://www.freertos.org/vtaskdelayuntil.html
+    const TickType_t xFrequency = (FFT_MIN_CYCLE >> overlap) * portTICK_PERIOD_MS;
+
+    if (millis() - loadStart >= 1000) {
+      const unsigned long elapsed = millis() - loadStart;
+      fftTaskLoad = float(busyMicros) / (10.0f * elapsed);
+      fftTaskRate = (fftRuns * 1000UL + elapsed/2) / elapsed;
+      loadStart += elapsed;
+      busyMicros = 0;
+      fftRuns = 0;
+    }
+
     // Don't run FFT computing code if we're in Receive mode or in realtime mode
     if (disableSoundProcessing || (audioSyncEnabled & 0x02)) {
       vTaskDelayUntil( &xLastWakeTime, xFrequency);        // release CPU, and let I2S fill its buffers
@@ -251,8 +280,16 @@ void FFTcode(void * parameter)
 #endif
 
     // get a fresh batch of samples from I2S
-    if (audioSource) audioSource->getSamples(vReal, samplesFFT);
+    float *newSamples = vReal;
+    if (hop < samplesFFT) {
+      if (ringPos % hop) ringPos = 0;          // overlap was changed
+      newSamples = sampleRing + ringPos;
+    }
+    if (audioSource) audioSource->getSamples(newSamples, hop);
+    const unsigned long busyStart = micros();
+#ifndef SR_REAL_FFT
     memset(vImag, 0, samplesFFT * sizeof(float));   // set imaginary parts to 0
+#endif
 
 #if defined(WLED_DEBUG) || defined(SR_DEBUG)
     if (start < esp_timer_get_time()) { // filter out overflows
@@ -266,7 +303,14 @@ void FFTcode(void * parameter)
 
     // band pass filter - can reduce noise floor by a factor of 50
     // downside: frequencies below 100Hz will be ignored
-    if (useBandPassFilter) runMicFilter(samplesFFT, vReal);
+    if (useBandPassFilter) runMicFilter(hop, newSamples);
+
+    if (hop < samplesFFT) {
+      // FFT input = ring buffer contents, oldest sample first
+      ringPos = (ringPos + hop) % samplesFFT;
+      memcpy(vReal, sampleRing + ringPos, (samplesFFT - ringPos) * sizeof(float));
+      memcpy(vReal + (samplesFFT - ringPos), sampleRing, ringPos * sizeof(float));
+    }
 
     // find highest sample in the batch
     float maxSample = 0.0f;                         // max sample from FFT batch
@@ -285,12 +329,16 @@ void FFTcode(void * parameter)
     if (sampleAvg > 0.25f) { // noise gate open means that FFT results will be used. Don't run FFT if results are not needed.
 #endif
 
+#ifdef SR_REAL_FFT
+      realFFT.compute(vReal);                                     // remove DC offset, "Flat Top" window, real-input FFT, magnitudes
+#else
       // run FFT (takes 3-5ms on ESP32, ~12ms on ESP32-S2)
       FFT.dcRemoval();                                            // remove DC offset
       FFT.windowing( FFTWindow::Flat_top, FFTDirection::Forward); // Weigh data using "Flat Top" function - better amplitude accuracy
       //FFT.windowing(FFTWindow::Blackman_Harris, FFTDirection::Forward);  // Weigh data using "Blackman- Harris" window - sharp peaks due to excellent sideband rejection
       FFT.compute( FFTDirection::Forward );                       // Compute FFT
       FFT.complexToMagnitude();                                   // Compute magnitudes
+#endif
       vReal[0] = 0;   // The remaining DC offset on the signal produces a strong spike on position 0 that should be eliminated to avoid issues.
 
       FFT.majorPeak(&FFT_MajorPeak, &FFT_Magnitude);                // let the effects know which freq was most dominant
@@ -313,72 +361,17 @@ void FFTcode(void * parameter)
 
     // mapping of FFT result bins to frequency channels
     if (fabsf(sampleAvg) > 0.5f) { // noise gate open
-#if 0
-    /* This FFT post processing is a DIY endeavour. What we really need is someone with sound engineering expertise to do a great job here AND most importantly, that the animations look GREAT as a result.
-    *
-    * Andrew's updated mapping of 256 bins down to the 16 result bins with Sample Freq = 10240, samplesFFT = 512 and some overlap.
-    * Based on testing, the lowest/Start frequency is 60 Hz (with bin 3) and a highest/End frequency of 5120 Hz in bin 255.
-    * Now, Take the 60Hz and multiply by 1.320367784 to get the next frequency and so on until the end. Then determine the bins.
-    * End frequency = Start frequency * multiplier ^ 16
-    * Multiplier = (End frequency/ Start frequency) ^ 1/16
-    * Multiplier = 1.320367784
-    */                                    //  Range
-      fftCalc[ 0] = fftAddAvg(2,4);       // 60 - 100
-      fftCalc[ 1] = fftAddAvg(4,5);       // 80 - 120
-      fftCalc[ 2] = fftAddAvg(5,7);       // 100 - 160
-      fftCalc[ 3] = fftAddAvg(7,9);       // 140 - 200
-      fftCalc[ 4] = fftAddAvg(9,12);      // 180 - 260
-      fftCalc[ 5] = fftAddAvg(12,16);     // 240 - 340
-      fftCalc[ 6] = fftAddAvg(16,21);     // 320 - 440
-      fftCalc[ 7] = fftAddAvg(21,29);     // 420 - 600
-      fftCalc[ 8] = fftAddAvg(29,37);     // 580 - 760
-      fftCalc[ 9] = fftAddAvg(37,48);     // 740 - 980
-      fftCalc[10] = fftAddAvg(48,64);     // 960 - 1300
-      fftCalc[11] = fftAddAvg(64,84);     // 1280 - 1700
-      fftCalc[12] = fftAddAvg(84,111);    // 1680 - 2240
-      fftCalc[13] = fftAddAvg(111,147);   // 2220 - 2960
-      fftCalc[14] = fftAddAvg(147,194);   // 2940 - 3900
-      fftCalc[15] = fftAddAvg(194,250);   // 3880 - 5000 // avoid the last 5 bins, which are usually inaccurate
-#else
-      /* new mapping, optimized for 22050 Hz by softhack007 */
-                                                    // bins frequency  range
-      if (useBandPassFilter) {
-        // skip frequencies below 100hz
-        fftCalc[ 0] = 0.8f * fftAddAvg(3,4);
-        fftCalc[ 1] = 0.9f * fftAddAvg(4,5);
-        fftCalc[ 2] = fftAddAvg(5,6);
-        fftCalc[ 3] = fftAddAvg(6,7);
-        // don't use the last bins from 206 to 255. 
-        fftCalc[15] = fftAddAvg(165,205) * 0.75f;   // 40 7106 - 8828 high             -- with some damping
-      } else {
-        fftCalc[ 0] = fftAddAvg(1,2);               // 1    43 - 86   sub-bass
-        fftCalc[ 1] = fftAddAvg(2,3);               // 1    86 - 129  bass
-        fftCalc[ 2] = fftAddAvg(3,5);               // 2   129 - 216  bass
-        fftCalc[ 3] = fftAddAvg(5,7);               // 2   216 - 301  bass + midrange
-        // don't use the last bins from 216 to 255. They are usually contaminated by aliasing (aka noise) 
-        fftCalc[15] = fftAddAvg(165,215) * 0.70f;   // 50 7106 - 9259 high             -- with some damping
-      }
-      fftCalc[ 4] = fftAddAvg(7,10);                // 3   301 - 430  midrange
-      fftCalc[ 5] = fftAddAvg(10,13);               // 3   430 - 560  midrange
-      fftCalc[ 6] = fftAddAvg(13,19);               // 5   560 - 818  midrange
-      fftCalc[ 7] = fftAddAvg(19,26);               // 7   818 - 1120 midrange -- 1Khz should always be the center !
-      fftCalc[ 8] = fftAddAvg(26,33);               // 7  1120 - 1421 midrange
-      fftCalc[ 9] = fftAddAvg(33,44);               // 9  1421 - 1895 midrange
-      fftCalc[10] = fftAddAvg(44,56);               // 12 1895 - 2412 midrange + high mid
-      fftCalc[11] = fftAddAvg(56,70);               // 14 2412 - 3015 high mid
-      fftCalc[12] = fftAddAvg(70,86);               // 16 3015 - 3704 high mid
-      fftCalc[13] = fftAddAvg(86,104);              // 18 3704 - 4479 high mid
-      fftCalc[14] = fftAddAvg(104,165) * 0.88f;     // 61 4479 - 7106 high mid + high  -- with slight damping
-#endif
+      geqMapChannels(vReal, fftCalc, useBandPassFilter);
     } else {  // noise gate closed - just decay old values
+      const float decay = geqHopSmoothing(0.85f, overlap);
       for (int i=0; i < NUM_GEQ_CHANNELS; i++) {
-        fftCalc[i] *= 0.85f;  // decay to zero
+        fftCalc[i] *= decay;  // decay to zero
         if (fftCalc[i] < 4.0f) fftCalc[i] = 0.0f;
       }
     }
 
     // post-processing of frequency channels (pink noise adjustment, AGC, smoothing, scaling)
-    postProcessFFTResults((fabsf(sampleAvg) > 0.25f)? true : false , NUM_GEQ_CHANNELS);
+    postProcessFFTResults((fabsf(sampleAvg) > 0.25f)? true : false , NUM_GEQ_CHANNELS, overlap);
 
 #if defined(WLED_DEBUG) || defined(SR_DEBUG)
     if (haveDoneFFT && (start < esp_timer_get_time())) { // filter out overflows
@@ -389,6 +382,9 @@ void FFTcode(void * parameter)
     // run peak detection
     autoResetPeak();
     detectSamplePeak();
+
+    busyMicros += micros() - busyStart;
+    fftRuns++;
     
     #if !defined(I2S_GRAB_ADC1_COMPLETELY)    
     if ((audioSource == nullptr) || (audioSource->getType() != AudioSource::Type_I2SAdc))  // the "delay trick" does not help for analog ADC
@@ -434,80 +430,27 @@ static void runMicFilter(uint16_t numSamples, float *sampleBuffer)          // p
   }
 }
 
-static void postProcessFFTResults(bool noiseGateOpen, int numberOfChannels) // post-processing and post-amp of GEQ channels
+static void postProcessFFTResults(bool noiseGateOpen, int numberOfChannels, unsigned overlap) // post-processing and post-amp of GEQ channels
 {
-    for (int i=0; i < numberOfChannels; i++) {
-
-      if (noiseGateOpen) { // noise gate open
-        // Adjustment for frequency curves.
-        fftCalc[i] *= fftResultPink[i];
-        if (FFTScalingMode > 0) fftCalc[i] *= FFT_DOWNSCALE;  // adjustment related to FFT windowing function
-        // Manual linear adjustment of gain using sampleGain adjustment for different input types.
-        fftCalc[i] *= soundAgc ? multAgc : ((float)sampleGain/40.0f * (float)inputLevel/128.0f + 1.0f/16.0f); //apply gain, with inputLevel adjustment
-        if(fftCalc[i] < 0) fftCalc[i] = 0;
-      }
-
-      // smooth results - rise fast, fall slower
-      if(fftCalc[i] > fftAvg[i])   // rise fast 
-        fftAvg[i] = fftCalc[i] *0.75f + 0.25f*fftAvg[i];  // will need approx 2 cycles (50ms) for converging against fftCalc[i]
-      else {                       // fall slow
-        if (decayTime < 1000) fftAvg[i] = fftCalc[i]*0.22f + 0.78f*fftAvg[i];       // approx  5 cycles (225ms) for falling to zero
-        else if (decayTime < 2000) fftAvg[i] = fftCalc[i]*0.17f + 0.83f*fftAvg[i];  // default - approx  9 cycles (225ms) for falling to zero
-        else if (decayTime < 3000) fftAvg[i] = fftCalc[i]*0.14f + 0.86f*fftAvg[i];  // approx 14 cycles (350ms) for falling to zero
-        else fftAvg[i] = fftCalc[i]*0.1f  + 0.9f*fftAvg[i];                         // approx 20 cycles (500ms) for falling to zero
-      }
-      // constrain internal vars - just to be sure
-      fftCalc[i] = constrain(fftCalc[i], 0.0f, 1023.0f);
-      fftAvg[i] = constrain(fftAvg[i], 0.0f, 1023.0f);
-
-      float currentResult;
-      if(limiterOn == true)
-        currentResult = fftAvg[i];
-      else
-        currentResult = fftCalc[i];
-
-      switch (FFTScalingMode) {
-        case 1:
-            // Logarithmic scaling
-            currentResult *= 0.42f;                      // 42 is the answer ;-)
-            currentResult -= 8.0f;                       // this skips the lowest row, giving some room for peaks
-            if (currentResult > 1.0f) currentResult = logf(currentResult); // log to base "e", which is the fastest log() function
-            else currentResult = 0.0f;                   // special handling, because log(1) = 0; log(0) = undefined
-            currentResult *= 0.85f + (float(i)/18.0f);  // extra up-scaling for high frequencies
-            currentResult = mapf(currentResult, 0, LOG_256, 0, 255); // map [log(1) ... log(255)] to [0 ... 255]
-        break;
-        case 2:
-            // Linear scaling
-            currentResult *= 0.30f;                     // needs a bit more damping, get stay below 255
-            currentResult -= 4.0f;                       // giving a bit more room for peaks
-            if (currentResult < 1.0f) currentResult = 0.0f;
-            currentResult *= 0.85f + (float(i)/1.8f);   // extra up-scaling for high frequencies
-        break;
-        case 3:
-            // square root scaling
-            currentResult *= 0.38f;
-            currentResult -= 6.0f;
-            if (currentResult > 1.0f) currentResult = sqrtf(currentResult);
-            else currentResult = 0.0f;                   // special handling, because sqrt(0) = undefined
-            currentResult *= 0.85f + (float(i)/4.5f);   // extra up-scaling for high frequencies
-            currentResult = mapf(currentResult, 0.0, 16.0, 0.0, 255.0); // map [sqrt(1) ... sqrt(256)] to [0 ... 255]
-        break;
-
-        case 0:
-        default:
-            // no scaling - leave freq bins as-is
-            currentResult -= 4; // just a bit more room for peaks
-        break;
-      }
-
-      // Now, let's dump it all into fftResult. Need to do this, otherwise other routines might grab fftResult values prematurely.
-      if (soundAgc > 0) {  // apply extra "GEQ Gain" if set by user
-        float post_gain = (float)inputLevel/128.0f;
-        if (post_gain < 1.0f) post_gain = ((post_gain -1.0f) * 0.8f) +1.0f;
-        currentResult *= post_gain;
-      }
-      fftResult[i] = constrain((int)currentResult, 0, 255);
+    float fallKeep;                                       // approx 5/9/14/20 cycles for falling to zero, depending on decayTime
+    if (decayTime < 1000) fallKeep = 0.78f;
+    else if (decayTime < 2000) fallKeep = 0.83f;
+    else if (decayTime < 3000) fallKeep = 0.86f;
+    else fallKeep = 0.9f;
+
+    GEQSettings geq;
+    geq.pink        = fftResultPink;
+    geq.gain        = soundAgc ? multAgc : ((float)sampleGain/40.0f * (float)inputLevel/128.0f + 1.0f/16.0f); // gain, with inputLevel adjustment
+    geq.postGain    = 1.0f;
+    if (soundAgc > 0) {  // apply extra "GEQ Gain" if set by user
+      geq.postGain = (float)inputLevel/128.0f;
+      if (geq.postGain < 1.0f) geq.postGain = ((geq.postGain -1.0f) * 0.8f) +1.0f;
     }
+    geq.riseKeep    = geqHopSmoothing(0.25f, overlap);
+    geq.fallKeep    = geqHopSmoothing(fallKeep, overlap);
+    geq.limiter     = limiterOn;
+    geq.scalingMode = FFTScalingMode;
+    geqPostProcess(fftCalc, fftAvg, fftResult, numberOfChannels, noiseGateOpen, geq);
 }
 ////////////////////
 // Peak detection //
@@ -612,8 +555,28 @@ class AudioReactive : public Usermod {
       double FFT_MajorPeak;   //  08 Bytes
     };
 
+    // "V3" audiosync struct - 52 Bytes. V2 payload plus sender timestamp and sequence number, so receivers can buffer packets and play them out in step
+    struct __attribute__ ((packed)) audioSyncPacket_v3 {
+      audioSyncPacket data;   //  44 Bytes  offset 0  - same as V2, but with header "00003"
+      uint32_t timestamp;     //  04 Bytes  offset 44 - sender time (toki) in ms
+      uint16_t sequence;      //  02 Bytes  offset 48 - incremented with each packet
+      uint8_t  timeSource;    //  01 Bytes  offset 50 - sender toki time source (TOKI_TS_*)
+      uint8_t  reserved4;     //  01 Bytes  offset 51 - not used yet
+    };
+
     #define UDPSOUND_MAX_PACKET 88 // max packet size for audiosync
 
+    // receive-side jitter buffer for V3 packets: each packet is played out "syncDelay" ms after it was sent
+    #define UDPSOUND_JITTER_SLOTS 8
+    #define UDPSOUND_STREAM_TIMEOUT 2500       // V3 receive: no packet for this long (ms) means a new stream (sender restarted)
+    #define UDPSOUND_MAX_REORDER (4*UDPSOUND_JITTER_SLOTS) // V3 receive: packets further back than this belong to a new stream
+    struct syncBufferSlot {
+      audioSyncPacket data;
+      uint32_t playAt;        // local millis() when this packet is due
+      uint16_t sequence;
+      bool     used;
+    };
+
     // set your config variables to their boot default value (this can also be done in readFromConfig() or a constructor if you prefer)
     #ifdef UM_AUDIOREACTIVE_ENABLE
     bool     enabled = true;
@@ -630,6 +593,23 @@ class AudioReactive : public Usermod {
     unsigned long lastTime = 0;   // last time of running UDP Microphone Sync
     const uint16_t delayMs = 10;  // I don't want to sample too often and overload WLED
     uint16_t audioSyncPort= 11988;// default port for UDP sound sync
+    uint8_t  audioSyncFormat = 2; // packet format for sending: 2 = V2 (compatible with all receivers), 3 = V3 (timestamped) (config value)
+    uint16_t syncDelay = 60;      // V3 receive: playout delay in ms, must cover network jitter. Use the same value on all receivers (config value)
+    uint16_t txSequence = 0;      // V3 send: sequence number of the next packet
+
+    // V3 receive: jitter buffer and statistics
+    syncBufferSlot syncBuffer[UDPSOUND_JITTER_SLOTS];
+    uint16_t lastPlayedSequence = 0;
+    bool     havePlayedSequence = false;
+    uint16_t nextSequence = 0;          // expected sequence number of the next packet
+    bool     haveNextSequence = false;
+    int32_t  syncTransitMin = 0;        // smallest (arrival - sender timestamp) seen, used if clocks are not synchronized
+    int32_t  syncTransitWinMin = 0;     // same, for the current window
+    unsigned long syncTransitWindow = 0;
+    bool     haveSyncTransit = false;
+    uint32_t syncPacketsLost = 0;       // gaps in sequence numbers
+    uint32_t syncPacketsLate = 0;       // packets that arrived after their playout time
+    unsigned long syncLastPacket = 0;   // arrival time of last accepted packet
 
     bool updateIsRunning = false; // true during OTA.
 
@@ -656,7 +636,7 @@ class AudioReactive : public Usermod {
 
     // used to feed "Info" Page
     unsigned long last_UDPTime = 0;    // time of last valid UDP sound sync datapacket
-    int receivedFormat = 0;            // last received UDP sound sync format - 0=none, 1=v1 (0.13.x), 2=v2 (0.14.x)
+    int receivedFormat = 0;            // last received UDP sound sync format - 0=none, 1=v1 (0.13.x), 2=v2 (0.14.x), 3=v3 (timestamped)
     float maxSample5sec = 0.0f;        // max sample (after AGC) in last 5 seconds 
     unsigned long sampleMaxTimer = 0;  // last time maxSample5sec was reset
     #define CYCLE_SAMPLEMAX 3500       // time window for merasuring
@@ -675,6 +655,7 @@ class AudioReactive : public Usermod {
     static const char _addPalettes[];
     static const char UDP_SYNC_HEADER[];
     static const char UDP_SYNC_HEADER_v1[];
+    static const char UDP_SYNC_HEADER_v3[];
 
     // private methods
     void removeAudioPalettes(void);
@@ -990,10 +971,11 @@ class AudioReactive : public Usermod {
       if (!udpSyncConnected) return;
       //DEBUGSR_PRINTLN("Transmitting UDP Mic Packet");
 
-      audioSyncPacket transmitData;
-      memset(reinterpret_cast<void *>(&transmitData), 0, sizeof(transmitData)); // make sure that the packet - including "invisible" padding bytes added by the compiler - is fully initialized
+      audioSyncPacket_v3 packet;
+      memset(reinterpret_cast<void *>(&packet), 0, sizeof(packet)); // make sure that the packet - including "invisible" padding bytes added by the compiler - is fully initialized
+      audioSyncPacket &transmitData = packet.data;
 
-      strncpy_P(transmitData.header, PSTR(UDP_SYNC_HEADER), 6);
+      strncpy_P(transmitData.header, (audioSyncFormat == 3) ? UDP_SYNC_HEADER_v3 : UDP_SYNC_HEADER, 6);
       // transmit samples that were not modified by limitSampleDynamics()
       transmitData.sampleRaw   = (soundAgc) ? rawSampleAgc: sampleRaw;
       transmitData.sampleSmth  = (soundAgc) ? sampleAgc   : sampleAvg;
@@ -1007,8 +989,16 @@ class AudioReactive : public Usermod {
       transmitData.FFT_Magnitude = my_magnitude;
       transmitData.FFT_MajorPeak = FFT_MajorPeak;
 
+      size_t packetSize = sizeof(transmitData);
+      if (audioSyncFormat == 3) {
+        packet.timestamp  = tokiMillis();
+        packet.sequence   = txSequence++;
+        packet.timeSource = toki.getTimeSource();
+        packetSize = sizeof(packet);
+      }
+
       if (fftUdp.beginMulticastPacket() != 0) { // beginMulticastPacket returns 0 in case of error
-        fftUdp.write(reinterpret_cast<uint8_t *>(&transmitData), sizeof(transmitData));
+        fftUdp.write(reinterpret_cast<uint8_t *>(&packet), packetSize);
         fftUdp.endPacket();
       }
       return;
@@ -1022,6 +1012,105 @@ class AudioReactive : public Usermod {
     static bool isValidUdpSyncVersion_v1(const char *header) {
       return strncmp_P(header, UDP_SYNC_HEADER_v1, 6) == 0;
     }
+    static bool isValidUdpSyncVersion_v3(const char *header) {
+      return strncmp_P(header, UDP_SYNC_HEADER_v3, 6) == 0;
+    }
+
+    // toki time in ms (wraps every 49 days, only differences are used)
+    static uint32_t tokiMillis() {
+      Toki::Time t = toki.getTime();
+      return t.sec * 1000UL + t.ms;
+    }
+    // true if toki time is millisecond accurate and shared with other nodes (NTP, or UDP sync from a WLED that uses NTP)
+    // TOKI_TS_UDP is an unsynced sender's clock and TOKI_TS_MS is not shared, both can be seconds apart from other nodes
+    static bool isTokiMsAccurate(uint8_t timeSource) {
+      return timeSource == TOKI_TS_UDP_NTP || timeSource >= TOKI_TS_NTP;
+    }
+
+    void resetSyncBuffer() {
+      for (auto &slot : syncBuffer) slot.used = false;
+      havePlayedSequence = haveNextSequence = haveSyncTransit = false;
+    }
+
+    // V3: put packet into jitter buffer. Returns false if it was dropped.
+    bool queueAudioData_v3(int packetSize, uint8_t *fftBuff) {
+      audioSyncPacket_v3 packet;
+      memcpy(&packet, fftBuff, min((unsigned)packetSize, (unsigned)sizeof(packet))); // don't violate alignment
+      const unsigned long now = millis();
+
+      // new stream: sender restarted (sequence starts over) or was gone for a while - forget old sequence numbers and timing
+      const bool jumpedBack = haveNextSequence && int16_t(packet.sequence - nextSequence) < -UDPSOUND_MAX_REORDER;
+      if (jumpedBack || (haveNextSequence && now - syncLastPacket > UDPSOUND_STREAM_TIMEOUT)) resetSyncBuffer();
+      syncLastPacket = now;
+
+      // statistics: gaps in the sequence are lost packets (unless they show up later)
+      int16_t gap = haveNextSequence ? int16_t(packet.sequence - nextSequence) : 0;
+      if (gap >= 0) {
+        syncPacketsLost += gap;
+        nextSequence = packet.sequence + 1;
+        haveNextSequence = true;
+      } else if (syncPacketsLost > 0) syncPacketsLost--; // out of order - it was not lost after all
+      if (havePlayedSequence && int16_t(packet.sequence - lastPlayedSequence) <= 0) {
+        syncPacketsLate++;                      // older than what is already shown
+        return false;
+      }
+
+      // due time: if both clocks are synchronized, all receivers play the packet at the same (toki) time.
+      // Otherwise, estimate the fastest transit time over the last few seconds and add the delay to that.
+      int32_t dueIn = 0;
+      bool synced = isTokiMsAccurate(packet.timeSource) && isTokiMsAccurate(toki.getTimeSource());
+      if (synced) {
+        dueIn = int32_t(packet.timestamp + syncDelay - tokiMillis());
+        if (dueIn < -1000 || dueIn > 2000) synced = false;     // clocks disagree - don't trust them
+      }
+      if (!synced) {
+        const int32_t transit = int32_t(now - packet.timestamp);  // includes unknown clock offset
+        if (!haveSyncTransit || now - syncTransitWindow > 5000) {  // new window: forget older minimum (follows clock drift and route changes)
+          syncTransitMin = haveSyncTransit ? min(syncTransitWinMin, transit) : transit;
+          syncTransitWinMin = transit;
+          syncTransitWindow = now;
+          haveSyncTransit = true;
+        }
+        syncTransitWinMin = min(syncTransitWinMin, transit);
+        syncTransitMin    = min(syncTransitMin, transit);
+        dueIn = syncTransitMin + int32_t(syncDelay) - transit;
+      }
+      if (dueIn < 0) {
+        syncPacketsLate++;                      // late, but newer than what is shown - play it right away
+        dueIn = 0;
+      }
+
+      // store in a free slot, or replace the slot that is due first
+      syncBufferSlot *slot = &syncBuffer[0];
+      for (auto &s : syncBuffer) {
+        if (!s.used) { slot = &s; break; }
+        if (int32_t(s.playAt - slot->playAt) < 0) slot = &s;
+      }
+      slot->data     = packet.data;
+      slot->playAt   = now + dueIn;
+      slot->sequence = packet.sequence;
+      slot->used     = true;
+      return true;
+    }
+
+    // V3: apply the newest packet that is due. Returns true if new data was applied.
+    bool playoutAudioData() {
+      const unsigned long now = millis();
+      syncBufferSlot *due = nullptr;
+      for (auto &s : syncBuffer) {
+        if (!s.used || int32_t(now - s.playAt) < 0) continue;
+        if (!due || int16_t(s.sequence - due->sequence) > 0) due = &s;
+      }
+      if (!due) return false;
+      for (auto &s : syncBuffer) {                               // drop everything older than the packet we show
+        if (s.used && int16_t(s.sequence - due->sequence) < 0) s.used = false;
+      }
+      decodeAudioData(sizeof(due->data), reinterpret_cast<uint8_t *>(&due->data));
+      lastPlayedSequence = due->sequence;
+      havePlayedSequence = true;
+      due->used = false;
+      return true;
+    }
 
     void decodeAudioData(int packetSize, uint8_t *fftBuff) {
       audioSyncPacket receivedPacket;
@@ -1082,33 +1171,41 @@ class AudioReactive : public Usermod {
       FFT_MajorPeak = constrain(receivedPacket->FFT_MajorPeak, 1.0, 11025.0);  // restrict value to range expected by effects
     }
 
-    bool receiveAudioData()   // check & process new data. return TRUE in case that new audio data was received. 
+    // check & process new data. return TRUE in case that new audio data was received.
+    // V1 and V2 data is applied immediately, V3 packets go to the jitter buffer and are applied by playoutAudioData()
+    bool receiveAudioData()
     {
       if (!udpSyncConnected) return false;
       bool haveFreshData = false;
 
-      size_t packetSize = fftUdp.parsePacket();
+      for (int n = 0; n < UDPSOUND_JITTER_SLOTS/2; n++) {   // read all waiting packets, so the jitter buffer sees them early
+        size_t packetSize = fftUdp.parsePacket();
+        if (packetSize == 0) break;
 #ifdef ARDUINO_ARCH_ESP32
-      if ((packetSize > 0) && ((packetSize < 5) || (packetSize > UDPSOUND_MAX_PACKET))) fftUdp.flush(); // discard invalid packets (too small or too big) - only works on esp32
+        if ((packetSize > 0) && ((packetSize < 5) || (packetSize > UDPSOUND_MAX_PACKET))) fftUdp.flush(); // discard invalid packets (too small or too big) - only works on esp32
 #endif
-      if ((packetSize > 5) && (packetSize <= UDPSOUND_MAX_PACKET)) {
-        //DEBUGSR_PRINTLN("Received UDP Sync Packet");
-        uint8_t fftBuff[UDPSOUND_MAX_PACKET+1] = { 0 }; // fixed-size buffer for receiving (stack), to avoid heap fragmentation caused by variable sized arrays
-        fftUdp.read(fftBuff, packetSize);
-
-        // VERIFY THAT THIS IS A COMPATIBLE PACKET
-        if (packetSize == sizeof(audioSyncPacket) && (isValidUdpSyncVersion((const char *)fftBuff))) {
-          decodeAudioData(packetSize, fftBuff);
-          //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v2");
-          haveFreshData = true;
-          receivedFormat = 2;
-        } else {
-          if (packetSize == sizeof(audioSyncPacket_v1) && (isValidUdpSyncVersion_v1((const char *)fftBuff))) {
-            decodeAudioData_v1(packetSize, fftBuff);
-            //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v1");
+        if ((packetSize > 5) && (packetSize <= UDPSOUND_MAX_PACKET)) {
+          //DEBUGSR_PRINTLN("Received UDP Sync Packet");
+          uint8_t fftBuff[UDPSOUND_MAX_PACKET+1] = { 0 }; // fixed-size buffer for receiving (stack), to avoid heap fragmentation caused by variable sized arrays
+          fftUdp.read(fftBuff, packetSize);
+
+          // VERIFY THAT THIS IS A COMPATIBLE PACKET
+          if (packetSize == sizeof(audioSyncPacket_v3) && (isValidUdpSyncVersion_v3((const char *)fftBuff))) {
+            if (queueAudioData_v3(packetSize, fftBuff)) haveFreshData = true;
+            receivedFormat = 3;
+          } else if (packetSize == sizeof(audioSyncPacket) && (isValidUdpSyncVersion((const char *)fftBuff))) {
+            decodeAudioData(packetSize, fftBuff);
+            //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v2");
             haveFreshData = true;
-            receivedFormat = 1;
-          } else receivedFormat = 0; // unknown format
+            receivedFormat = 2;
+          } else {
+            if (packetSize == sizeof(audioSyncPacket_v1) && (isValidUdpSyncVersion_v1((const char *)fftBuff))) {
+              decodeAudioData_v1(packetSize, fftBuff);
+              //DEBUGSR_PRINTLN("Finished parsing UDP Sync Packet v1");
+              haveFreshData = true;
+              receivedFormat = 1;
+            } else receivedFormat = 0; // unknown format
+          }
         }
       }
       return haveFreshData;
@@ -1219,6 +1316,13 @@ class AudioReactive : public Usermod {
           delay(100);
           if (audioSource) audioSource->initialize(i2swsPin, i2ssdPin, i2sckPin, mclkPin);
           break;
+        #ifdef SR_WAV_SOURCE
+        case 7:
+          DEBUGSR_PRINTLN(F("AR: WAV file source " SR_WAV_FILE));
+          audioSource = new WavFileSource(SAMPLE_RATE, BLOCK_SIZE);
+          if (audioSource) audioSource->initialize();
+          break;
+        #endif
 
         #if  !defined(CONFIG_IDF_TARGET_ESP32S2) && !defined(CONFIG_IDF_TARGET_ESP32C3) && !defined(CONFIG_IDF_TARGET_ESP32S3)
         // ADC over I2S is only possible on "classic" ESP32
@@ -1281,6 +1385,7 @@ class AudioReactive : public Usermod {
         udpSyncConnected = false;
         fftUdp.stop();
       }
+      resetSyncBuffer();
       
       if (audioSyncPort > 0 && (audioSyncEnabled & 0x03)) {
       #ifdef ARDUINO_ARCH_ESP32
@@ -1400,8 +1505,10 @@ class AudioReactive : public Usermod {
 #ifdef ARDUINO_ARCH_ESP32
             else fftUdp.flush(); // Flush udp input buffers if we haven't read it - avoids hickups in receive mode. Does not work on 8266.
 #endif
+            if (receivedFormat == 3) have_new_sample = false;  // V3 data is only applied when due
             lastTime = millis();
           }
+          if (playoutAudioData()) have_new_sample = true;     // V3 jitter buffer
           if (have_new_sample) syncVolumeSmth = volumeSmth;   // remember received sample
           else volumeSmth = syncVolumeSmth;                   // restore originally received sample for next run of dynamics limiter
           limitSampleDynamics();                              // run dynamics limiter on received volumeSmth, to hide jumps and hickups
@@ -1645,6 +1752,13 @@ class AudioReactive : public Usermod {
         infoArr = user.createNestedArray(F("Sound Processing"));
         if (audioSource && (disableSoundProcessing == false)) {
           infoArr.add(F("running"));
+          if (!(audioSyncEnabled & 0x02)) {
+            infoArr = user.createNestedArray(F("FFT load"));
+            infoArr.add(roundf(fftTaskLoad * 10.0f) / 10.0f);
+            char buf[40];
+            snprintf_P(buf, sizeof(buf), PSTR(" %% CPU, %u FFT/s (%u%% overlap)"), unsigned(fftTaskRate), fftOverlap == 2 ? 75U : fftOverlap * 50U);
+            infoArr.add(buf);
+          }
         } else {
           infoArr.add(F("suspended"));
         }
@@ -1667,7 +1781,7 @@ class AudioReactive : public Usermod {
         if (audioSyncEnabled) {
           if (audioSyncEnabled & 0x01) {
             infoArr.add(F("send mode"));
-            if ((udpSyncConnected) && (millis() - lastTime < 2500)) infoArr.add(F(" v2"));
+            if ((udpSyncConnected) && (millis() - lastTime < 2500)) infoArr.add((audioSyncFormat == 3) ? F(" v3") : F(" v2"));
           } else if (audioSyncEnabled & 0x02) {
               infoArr.add(F("receive mode"));
           }
@@ -1677,6 +1791,13 @@ class AudioReactive : public Usermod {
         if (audioSyncEnabled && udpSyncConnected && (millis() - last_UDPTime < 2500)) {
             if (receivedFormat == 1) infoArr.add(F(" v1"));
             if (receivedFormat == 2) infoArr.add(F(" v2"));
+            if (receivedFormat == 3) infoArr.add(F(" v3"));
+        }
+        if ((audioSyncEnabled & 0x02) && receivedFormat == 3) {
+          infoArr = user.createNestedArray(F("Sync packets"));
+          char buf[48];
+          snprintf_P(buf, sizeof(buf), PSTR("%u lost, %u late"), unsigned(syncPacketsLost), unsigned(syncPacketsLate));
+          infoArr.add(buf);
         }
 
         #if defined(WLED_DEBUG) || defined(SR_DEBUG)
@@ -1687,9 +1808,9 @@ class AudioReactive : public Usermod {
 
         infoArr = user.createNestedArray(F("FFT time"));
         infoArr.add(float(fftTime)/100.0f);
-        if ((fftTime/100) >= FFT_MIN_CYCLE) // FFT time over budget -> I2S buffer will overflow 
+        if ((fftTime/100) >= (FFT_MIN_CYCLE >> fftOverlap)) // FFT time over budget -> I2S buffer will overflow 
           infoArr.add("<b style=\"color:red;\">! ms</b>");
-        else if ((fftTime/80 + sampleTime/80) >= FFT_MIN_CYCLE) // FFT time >75% of budget -> risk of instability
+        else if ((fftTime/80 + sampleTime/80) >= (FFT_MIN_CYCLE >> fftOverlap)) // FFT time >75% of budget -> risk of instability
           infoArr.add("<b style=\"color:orange;\"> ms!</b>");
         else
           infoArr.add(" ms");
@@ -1817,6 +1938,7 @@ class AudioReactive : public Usermod {
 
       JsonObject freqScale = top.createNestedObject(FPSTR(_frequency));
       freqScale[F("scale")] = FFTScalingMode;
+      freqScale[F("overlap")] = fftOverlap;
 #endif
 
       JsonObject dynLim = top.createNestedObject(FPSTR(_dynamics));
@@ -1827,6 +1949,8 @@ class AudioReactive : public Usermod {
       JsonObject sync = top.createNestedObject("sync");
       sync["port"] = audioSyncPort;
       sync["mode"] = audioSyncEnabled;
+      sync[F("fmt")] = audioSyncFormat;
+      sync[F("delay")] = syncDelay;
     }
 
 
@@ -1880,6 +2004,8 @@ class AudioReactive : public Usermod {
       configComplete &= getJsonValue(top[FPSTR(_config)][F("AGC")],     soundAgc);
 
       configComplete &= getJsonValue(top[FPSTR(_frequency)][F("scale")], FFTScalingMode);
+      configComplete &= getJsonValue(top[FPSTR(_frequency)][F("overlap")], fftOverlap);
+      if (fftOverlap > 2) fftOverlap = 2;
 
       configComplete &= getJsonValue(top[FPSTR(_dynamics)][F("limiter")], limiterOn);
       configComplete &= getJsonValue(top[FPSTR(_dynamics)][F("rise")],  attackTime);
@@ -1887,6 +2013,10 @@ class AudioReactive : public Usermod {
 #endif
       configComplete &= getJsonValue(top["sync"]["port"], audioSyncPort);
       configComplete &= getJsonValue(top["sync"]["mode"], audioSyncEnabled);
+      configComplete &= getJsonValue(top["sync"][F("fmt")], audioSyncFormat);
+      configComplete &= getJsonValue(top["sync"][F("delay")], syncDelay);
+      if (audioSyncFormat != 3) audioSyncFormat = 2;
+      syncDelay = constrain(syncDelay, 0, 1000);
 
       if (initDone) {
         // add/remove custom/audioreactive palettes
@@ -1914,6 +2044,9 @@ class AudioReactive : public Usermod {
       uiScript.print(F("addOption(dd,'Generic I2S PDM',5);"));
     #endif
     uiScript.print(F("addOption(dd,'ES8388',6);"));
+    #ifdef SR_WAV_SOURCE
+      uiScript.print(F("addOption(dd,'WAV file (testing)',7);"));
+    #endif
     
       uiScript.print(F("dd=addDropdown(ux,'config:AGC');"));
       uiScript.print(F("addOption(dd,'Off',0);"));
@@ -1933,6 +2066,12 @@ class AudioReactive : public Usermod {
       uiScript.print(F("addOption(dd,'Linear (Amplitude)',2);"));
       uiScript.print(F("addOption(dd,'Square Root (Energy)',3);"));
       uiScript.print(F("addOption(dd,'Logarithmic (Loudness)',1);"));
+
+      uiScript.print(F("dd=addDropdown(ux,'frequency:overlap');"));
+      uiScript.print(F("addOption(dd,'None (23ms)',0);"));
+      uiScript.print(F("addOption(dd,'50% (12ms)',1);"));
+      uiScript.print(F("addOption(dd,'75% (6ms)',2);"));
+      uiScript.print(F("addInfo(ux+':frequency:overlap',1,'<i>faster response, more CPU</i>');"));
 #endif
 
       uiScript.print(F("dd=addDropdown(ux,'sync:mode');"));
@@ -1941,6 +2080,12 @@ class AudioReactive : public Usermod {
       uiScript.print(F("addOption(dd,'Send',1);"));
 #endif
       uiScript.print(F("addOption(dd,'Receive',2);"));
+#ifdef ARDUINO_ARCH_ESP32
+      uiScript.print(F("dd=addDropdown(ux,'sync:fmt');"));
+      uiScript.print(F("addOption(dd,'V2 (compatible)',2);"));
+      uiScript.print(F("addOption(dd,'V3 (timestamped)',3);"));
+#endif
+      uiScript.print(F("addInfo(ux+':sync:delay',1,'ms <i>(V3 receive)</i>');"));
 #ifdef ARDUINO_ARCH_ESP32
       uiScript.print(F("addInfo(ux+':digitalmic:type',1,'<i>requires reboot!</i>');"));  // 0 is field type, 1 is actual field
       uiScript.print(F("addInfo(uxp,0,'<i>sd/data/dout</i>','I2S SD');"));
@@ -2076,6 +2221,7 @@ const char AudioReactive::_digitalmic[] PROGMEM = "digitalmic";
 const char AudioReactive::_addPalettes[]       PROGMEM = "add-palettes";
 const char AudioReactive::UDP_SYNC_HEADER[]    PROGMEM = "00002"; // new sync header version, as format no longer compatible with previous structure
 const char AudioReactive::UDP_SYNC_HEADER_v1[] PROGMEM = "00001"; // old sync header version - need to add backwards-compatibility feature
+const char AudioReactive::UDP_SYNC_HEADER_v3[] PROGMEM = "00003"; // V2 + timestamp and sequence number
 
 static AudioReactive ar_module;
 REGISTER_USERMOD(ar_module);
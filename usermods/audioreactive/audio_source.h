@@ -770,4 +770,114 @@ class SPH0654 : public I2SSource {
 #endif
     }
 };
+
+#ifdef SR_WAV_SOURCE
+#ifndef SR_WAV_FILE
+#define SR_WAV_FILE "/audio.wav"
+#endif
+/* WAV file source
+   Plays a 16bit PCM .wav file from the WLED file system in an endless loop, paced like a real microphone.
+   Stereo files are mixed down to mono; other sample rates are converted by picking the nearest sample.
+   Provides repeatable input for benchmarking and comparing the FFT -> GEQ pipeline (for example SR_FFT_REAL vs. ArduinoFFT).
+*/
+class WavFileSource : public AudioSource {
+  public:
+    WavFileSource(SRate_t sampleRate, int blockSize, float sampleScale = 1.0f) :
+      AudioSource(sampleRate, blockSize, sampleScale)
+    {}
+
+    void initialize(int8_t = I2S_PIN_NO_CHANGE, int8_t = I2S_PIN_NO_CHANGE, int8_t = I2S_PIN_NO_CHANGE, int8_t = I2S_PIN_NO_CHANGE) {
+      DEBUGSR_PRINTLN(F("WavFileSource:: initialize()."));
+      _file = WLED_FS.open(SR_WAV_FILE, "r");
+      if (!_file) {
+        DEBUGSR_PRINTLN(F("AR: WAV file not found."));
+        return;
+      }
+
+      // walk the RIFF chunks: need "fmt " (16bit PCM) and "data"
+      uint8_t hdr[16];
+      if (_file.read(hdr, 12) != 12 || memcmp(hdr, "RIFF", 4) || memcmp(hdr+8, "WAVE", 4)) { deinitialize(); return; }
+      uint16_t format = 0, bits = 0;
+      uint32_t fileRate = 0;
+      _channels = 0;
+      while (_file.read(hdr, 8) == 8) {
+        uint32_t chunkSize = hdr[4] | (hdr[5] << 8) | (hdr[6] << 16) | (uint32_t(hdr[7]) << 24);
+        uint32_t next = _file.position() + chunkSize + (chunkSize & 1);  // chunks are padded to even size
+        if (!memcmp(hdr, "fmt ", 4) && chunkSize >= 16 && _file.read(hdr, 16) == 16) {
+          format    = hdr[0] | (hdr[1] << 8);
+          _channels = hdr[2] | (hdr[3] << 8);
+          fileRate  = hdr[4] | (hdr[5] << 8) | (hdr[6] << 16) | (uint32_t(hdr[7]) << 24);
+          bits      = hdr[14] | (hdr[15] << 8);
+        } else if (!memcmp(hdr, "data", 4)) {
+          _dataStart = _file.position();
+          _dataSize  = chunkSize;
+          break;
+        }
+        _file.seek(next);
+      }
+      if (format != 1 || bits != 16 || _channels < 1 || _channels > 2 || fileRate == 0 || _dataSize < 4U*_channels) {
+        DEBUGSR_PRINTF("AR: unsupported WAV file (format %u, %u bit, %u channels, %u Hz).\n", format, bits, _channels, unsigned(fileRate));
+        deinitialize();
+        return;
+      }
+      _dataSize -= _dataSize % (2*_channels);                 // whole frames only
+      _step = (uint64_t(fileRate) << 16) / _sampleRate;       // input frames per output sample (16.16)
+      _phase = 0;
+      _bufLen = _bufPos = 0;
+      _dataPos = 0;
+      _current = 0.0f;
+      _nextDue = micros();
+      _initialized = true;
+    }
+
+    void deinitialize() {
+      if (_file) _file.close();
+      _initialized = false;
+    }
+
+    void getSamples(float *buffer, uint16_t num_samples) {
+      if (!_initialized) return;
+      for (unsigned i = 0; i < num_samples; i++) {
+        _phase += _step;
+        while (_phase >= 0x10000) { _current = readFrame(); _phase -= 0x10000; }
+        buffer[i] = _current * _sampleScale;
+      }
+      // pace like a real microphone: num_samples take num_samples/sampleRate seconds
+      _nextDue += (uint32_t(num_samples) * 1000000UL) / _sampleRate;
+      int32_t wait = int32_t(_nextDue - micros());
+      if (wait > 1000000L || wait < -1000000L) _nextDue = micros();   // too far off (e.g. after a long stall) - re-sync
+      else if (wait > 1000) delay(wait / 1000);
+    }
+
+  private:
+    // next mono frame (16bit range, like I2S samples); wraps around at the end of the data chunk
+    float readFrame() {
+      if (_bufPos >= _bufLen) {
+        if (_dataPos >= _dataSize) { _dataPos = 0; _file.seek(_dataStart); }
+        size_t toRead = min(size_t(sizeof(_buf)), size_t(_dataSize - _dataPos));
+        _bufLen = _file.read(_buf, toRead);
+        _bufPos = 0;
+        _dataPos += _bufLen;
+        if (_bufLen < 2U*_channels) { _bufLen = 0; _dataPos = _dataSize; return 0.0f; } // read error - restart from beginning next time
+      }
+      int sample = int16_t(_buf[_bufPos] | (_buf[_bufPos+1] << 8));
+      if (_channels == 2) sample = (sample + int16_t(_buf[_bufPos+2] | (_buf[_bufPos+3] << 8))) / 2;
+      _bufPos += 2*_channels;
+      return float(sample);
+    }
+
+    File     _file;
+    uint8_t  _buf[256];        // multiple of 4 -> always whole frames
+    size_t   _bufLen = 0;
+    size_t   _bufPos = 0;
+    uint32_t _dataStart = 0;
+    uint32_t _dataSize = 0;
+    uint32_t _dataPos = 0;
+    uint16_t _channels = 0;
+    uint32_t _step = 0x10000;
+    uint32_t _phase = 0;
+    float    _current = 0.0f;
+    uint32_t _nextDue = 0;
+};
+#endif
 #endif
@@ -133,7 +133,7 @@ static um_data_t* getAudioData() {
  */
 uint16_t mode_static(void) {
   SEGMENT.fill(SEGCOLOR(0));
-  return strip.isOffRefreshRequired() ? FRAMETIME : 350;
+  return strip.isFrameRefreshRequired() ? FRAMETIME : 350;
 }
 static const char _data_FX_MODE_STATIC[] PROGMEM = "Solid";
 
@@ -10979,10 +10979,16 @@ uint8_t WS2812FX::addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name)
     if (_modeData[id] != _data_RESERVED) return 255; // do not overwrite an already added effect
     _mode[id]     = mode_fn;
     _modeData[id] = mode_name;
+    setModeInfo(id);
+    setRenderKernel(id, false);
+    setParallelSafe(id, false); // effect must opt in (see setupEffectData())
     return id;
   } else if (_mode.size() < 255) { // 255 is reserved for indicating the effect wasn't added
     _mode.push_back(mode_fn);
     _modeData.push_back(mode_name);
+    setModeInfo(_mode.size() - 1);
+    setRenderKernel(_mode.size() - 1, false);
+    setParallelSafe(_mode.size() - 1, false);
     if (_modeCount < _mode.size()) _modeCount++;
     return _mode.size() - 1;
   } else {
@@ -10990,14 +10996,114 @@ uint8_t WS2812FX::addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name)
   }
 }
 
+// add render kernel (effect function taking explicit render context) the same way as legacy effect
+// kernel is stored in the same vector (function pointer round-trip cast) and flagged so runEffect() calls it with context
+uint8_t WS2812FX::addEffect(uint8_t id, render_ptr render_fn, const char *mode_name) {
+  id = addEffect(id, reinterpret_cast<mode_ptr>(render_fn), mode_name);
+  if (id < 255) setRenderKernel(id, true);
+  return id;
+}
+
+// compile effect descriptor from mode data string ("Name@sliders;colors;palette;flags;defaults")
+// so that name, UI data, defaults and requirements can be found without re-scanning the (PROGMEM) string
+void WS2812FX::setModeInfo(uint8_t id) {
+  if (id >= _modeData.size()) return;
+  if (id >= _modeInfo.size()) _modeInfo.resize(id + 1);
+  mode_info_t &info = _modeInfo[id];
+  const char *data = _modeData[id];
+  info = {0, 0, 0, 0};
+  if (data == _data_RESERVED) info.flags |= FX_INFO_RESERVED;
+  size_t len = std::min(strlen_P(data), (size_t)UINT16_MAX);
+  unsigned section = 0;       // ";" separated sections after "@"
+  uint8_t  reqFlags = 0;      // content of flags section
+  bool     hasValues = false; // "=" found after last ";"
+  unsigned control = 0;       // position in slider section ("," separated)
+  size_t   controlLen = 0;    // length of its name
+  for (size_t i = 0; i < len; i++) {
+    char c = pgm_read_byte(data + i);
+    if ((info.flags & FX_INFO_DATA) && section == 0) { // slider section: non-empty name means control is shown
+      if (c == ',' || c == ';') {
+        if (controlLen && control < 8) info.controls |= 1 << control;
+        control++;
+        controlLen = 0;
+      } else controlLen++;
+    }
+    if (c == '@' && !(info.flags & FX_INFO_DATA)) {
+      info.nameLen = std::min(i, (size_t)UINT8_MAX);
+      info.flags  |= FX_INFO_DATA;
+    } else if (c == ';') {
+      if (info.flags & FX_INFO_DATA) section++;
+      info.defaults = i + 1;
+      hasValues = false;
+    } else if (c == '=') {
+      hasValues = true;
+      if (section == 3) reqFlags = 0; // short data string, defaults instead of flags
+    } else if (section == 3 && !hasValues) {
+      switch (c) {
+        case '0': reqFlags |= FX_INFO_0D;     break;
+        case '1': reqFlags |= FX_INFO_1D;     break;
+        case '2': reqFlags |= FX_INFO_2D;     break;
+        case 'v': reqFlags |= FX_INFO_VOLUME; break;
+        case 'f': reqFlags |= FX_INFO_FREQ;   break;
+      }
+    }
+  }
+  if (!(info.flags & FX_INFO_DATA)) info.nameLen = std::min(len, (size_t)UINT8_MAX);
+  if (!(info.flags & FX_INFO_DATA) || section == 0) info.controls = FX_CTRL_SX | FX_CTRL_IX; // no slider section: UI shows speed and intensity
+  if (hasValues && info.defaults) info.flags |= FX_INFO_DEFAULTS;
+  info.flags |= reqFlags;
+  indexModeName(id);
+}
+
+// hash of mode name (FNV-1a folded to 8 bit), name may be in RAM or PROGMEM
+static uint8_t modeNameHash(const char *name, size_t len, bool progmem) {
+  uint32_t h = 2166136261U;
+  for (size_t i = 0; i < len; i++) h = (h ^ uint8_t(progmem ? pgm_read_byte(name + i) : name[i])) * 16777619U;
+  return h ^ (h >> 8) ^ (h >> 16) ^ (h >> 24);
+}
+
+// at most 255 modes in 256 slots, so there is always an empty slot to stop probing
+// an existing entry of id is removed first (mode data may have changed), reserved slots are not indexed
+void WS2812FX::indexModeName(uint8_t id) {
+  auto insert = [this](uint8_t i) {
+    unsigned slot = modeNameHash(_modeData[i], _modeInfo[i].nameLen, true);
+    while (_modeNameIndex[slot] != 255) slot = (slot + 1) & 0xFF;
+    _modeNameIndex[slot] = i;
+  };
+  for (unsigned slot = 0; slot < 256; slot++) {
+    if (_modeNameIndex[slot] != id) continue;
+    _modeNameIndex[slot] = 255;
+    // entries following in the same probe sequence may have probed past the removed one: insert them again
+    for (unsigned next = (slot + 1) & 0xFF; _modeNameIndex[next] != 255; next = (next + 1) & 0xFF) {
+      const uint8_t other = _modeNameIndex[next];
+      _modeNameIndex[next] = 255;
+      insert(other);
+    }
+    break;
+  }
+  if (!(_modeInfo[id].flags & FX_INFO_RESERVED)) insert(id);
+}
+
+uint8_t WS2812FX::getModeByName(const char *name) const {
+  size_t len = name ? strlen(name) : 0;
+  if (len == 0 || len > UINT8_MAX) return 255;
+  for (unsigned slot = modeNameHash(name, len, false); _modeNameIndex[slot] != 255; slot = (slot + 1) & 0xFF) {
+    const uint8_t id = _modeNameIndex[slot];
+    if (_modeInfo[id].nameLen == len && strncmp_P(name, _modeData[id], len) == 0) return id;
+  }
+  return 255;
+}
+
 void WS2812FX::setupEffectData() {
   // Solid must be first! (assuming vector is empty upon call to setup)
   _mode.push_back(&mode_static);
   _modeData.push_back(_data_FX_MODE_STATIC);
+  setModeInfo(0);
   // fill reserved word in case there will be any gaps in the array
   for (size_t i=1; i<_modeCount; i++) {
     _mode.push_back(&mode_static);
     _modeData.push_back(_data_RESERVED);
+    setModeInfo(i);
   }
   // now replace all pre-allocated effects
   addEffect(FX_MODE_COPY, &mode_copy_segment, _data_FX_MODE_COPY);
@@ -11240,4 +11346,8 @@ addEffect(FX_MODE_PS1DSONICBOOM, &mode_particle1DsonicBoom, _data_FX_MODE_PS_SON
 addEffect(FX_MODE_PS1DSPRINGY, &mode_particleSpringy, _data_FX_MODE_PS_SPRINGY);
 #endif // WLED_DISABLE_PARTICLESYSTEM1D
 
+  // built-in effects keep their state in SEGENV (particle systems included) and may be rendered by any FX worker, except:
+  for (unsigned id = 0; id < _mode.size() && id < MODE_COUNT; id++) setParallelSafe(id, true);
+  setParallelSafe(FX_MODE_COPY,  false); // reads other segment's pixels
+  setParallelSafe(FX_MODE_IMAGE, false); // single (global) GIF decoder
 }
@@ -79,6 +79,20 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #endif
 #define FPS_UNLIMITED    0
 
+// parallel effect rendering (opt-in): independent segments are rendered on both cores of a dual-core ESP32
+// (loop() + a worker task pinned to the other core); host builds use std::thread for the worker
+#if defined(WLED_ENABLE_PARALLEL_FX) && defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_FREERTOS_UNICORE)
+  #define WLED_FX_WORKERS 2
+#elif defined(WLED_ENABLE_PARALLEL_FX) && !defined(ARDUINO)
+  #define WLED_FX_WORKERS 2
+#else
+  #define WLED_FX_WORKERS 1
+#endif
+#if WLED_FX_WORKERS > 1
+  #include <atomic>
+  #include "render_queue.h"
+#endif
+
 // FPS calculation (can be defined as compile flag for debugging)
 #ifndef FPS_CALC_AVG
 #define FPS_CALC_AVG 7 // average FPS calculation over this many frames (moving average)
@@ -112,8 +126,8 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #define MIN_SHOW_DELAY   (_frametime < 16 ? 8 : 15)
 
 #define NUM_COLORS       3 /* number of colors per segment */
-#define SEGMENT          (*strip._currentSegment)
-#define SEGENV           (*strip._currentSegment)
+#define SEGMENT          (*strip.getCurrentSegment())
+#define SEGENV           (*strip.getCurrentSegment())
 #define SEGCOLOR(x)      Segment::getCurrentColor(x)
 #define SEGPALETTE       Segment::getCurrentPalette()
 #define SEGLEN           Segment::vLength()
@@ -381,6 +395,26 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #define FX_MODE_PARTICLEGALAXY         217
 #define MODE_COUNT                     218
 
+// effect descriptor flags (compiled from mode data string, see WS2812FX::setModeInfo())
+#define FX_INFO_DATA                   0x01  // has UI control data ("name@...")
+#define FX_INFO_DEFAULTS               0x02  // has default values section ("...;sx=16,ix=240")
+#define FX_INFO_RESERVED               0x04  // unused (reserved) effect slot
+#define FX_INFO_0D                     0x08  // flags section: "0" single color (0D) effect
+#define FX_INFO_1D                     0x10  // flags section: "1"
+#define FX_INFO_2D                     0x20  // flags section: "2"
+#define FX_INFO_VOLUME                 0x40  // flags section: "v" audio reactive (volume)
+#define FX_INFO_FREQ                   0x80  // flags section: "f" audio reactive (frequency)
+
+// effect controls present in slider section of mode data ("name@sx,ix,c1,c2,c3,o1,o2,o3;..."), see WS2812FX::getModeControls()
+#define FX_CTRL_SX                     0x01  // speed slider
+#define FX_CTRL_IX                     0x02  // intensity slider
+#define FX_CTRL_C1                     0x04  // custom 1 slider
+#define FX_CTRL_C2                     0x08  // custom 2 slider
+#define FX_CTRL_C3                     0x10  // custom 3 slider
+#define FX_CTRL_O1                     0x20  // checkbox 1
+#define FX_CTRL_O2                     0x40  // checkbox 2
+#define FX_CTRL_O3                     0x80  // checkbox 3
+
 
 #define BLEND_STYLE_FADE            0x00  // universal
 #define BLEND_STYLE_FAIRY_DUST      0x01  // universal
@@ -421,7 +455,28 @@ typedef enum mapping1D2D {
 
 class WS2812FX;
 
-// segment, 76 bytes
+// returns index of the render worker executing the caller (used to select per-worker drawing state)
+// fxTaskId() identifies the calling task, as other tasks may run on the same core as a worker
+#if WLED_FX_WORKERS > 1
+  #ifdef ARDUINO_ARCH_ESP32
+extern TaskHandle_t fxWorkerTask;                          // FX worker task (see WS2812FX::startFXWorker())
+inline unsigned fxWorkerId() { return xTaskGetCurrentTaskHandle() == fxWorkerTask; } // bound to task: other tasks may run on worker's core
+inline const void *fxTaskId() { return xTaskGetCurrentTaskHandle(); }
+  #else
+extern thread_local unsigned fxWorkerIndex;               // set by FX worker thread (host build)
+inline unsigned fxWorkerId() { return fxWorkerIndex; }
+inline const void *fxTaskId() { return &fxWorkerIndex; }  // thread local, so unique per thread
+  #endif
+#else
+inline unsigned fxWorkerId() { return 0; }
+  #ifdef ARDUINO_ARCH_ESP32
+inline const void *fxTaskId() { return xTaskGetCurrentTaskHandle(); } // async_tcp and audio tasks run concurrently with loop()
+  #else
+inline const void *fxTaskId() { return nullptr; }
+  #endif
+#endif
+
+// segment, 80 bytes
 class Segment {
   public:
     uint32_t colors[NUM_COLORS];
@@ -463,6 +518,7 @@ class Segment {
       //uint8_t blendMode : 4;      // segment blending modes: top, bottom, add, subtract, difference, multiply, divide, lighten, darken, screen, overlay, hardlight, softlight, dodge, burn
     };
     uint8_t   blendMode;          // segment blending modes: top, bottom, add, subtract, difference, multiply, divide, lighten, darken, screen, overlay, hardlight, softlight, dodge, burn
+    uint16_t  seed;               // random seed for effects (0 = hardware RNG, otherwise reproducible random numbers, see WS2812FX::runEffect())
     char     *name;               // segment name
 
     // runtime data
@@ -475,9 +531,24 @@ class Segment {
 
     static uint16_t maxWidth, maxHeight;  // these define matrix width & height (max. segment dimensions)
 
+    // drawing state of a single effect call, set up by beginDraw()
+    // used to speed up effect calculations by stashing common pre-calculated values
+    struct RenderContext {
+      Segment      *segment;              // segment being rendered (SEGMENT & SEGENV)
+      uint8_t       segmentIndex;         // index of rendered segment (strip.getCurrSegmentId())
+      bool          previousMode;         // rendering old effect of a transition (isPreviousMode())
+      int           pinwheelRays[2];      // previous two rays drawn in pinwheel expansion (M12_sPinwheel)
+      unsigned      vLength;              // 1D dimension used for current effect
+      unsigned      vWidth, vHeight;      // 2D dimensions used for current effect
+      uint32_t      colors[NUM_COLORS];   // colors used for current effect (faster access from effect functions)
+      CRGBPalette16 palette;              // palette used for current effect (includes transition, used in color_from_palette())
+      uint32_t      randomState;          // per-frame PRNG state of seeded segment (see hw_random())
+    };
+
   private:
     uint32_t *pixels;                 // pixel data
     unsigned _dataLen;
+    mutable uint16_t *_map12;         // cached 1D-to-2D mapping table for arc, corner & pinwheel expansion (see getMappingTable())
     uint8_t  _default_palette;        // palette number that gets assigned to pal0
     union {
       mutable uint8_t _capabilities;  // determines segment capabilities in terms of what is available: RGB, W, CCT, manual W, etc.
@@ -489,17 +560,22 @@ class Segment {
       };
     };
 
+    // render context bound to each FX worker (see WLED_FX_WORKERS); legacy effects and drawing functions reach it via SEGMENT,
+    // SEGENV and vLength()/getCurrentColor()/... while render kernels also get it as argument (see WS2812FX::runEffect())
+    static RenderContext  _idleContext[WLED_FX_WORKERS]; // bound while no effect is running (zero initialised, palette is black)
+    static RenderContext *_context[WLED_FX_WORKERS];
+    inline static RenderContext &drawContext() { return *Segment::_context[fxWorkerId()]; }
+
     // static variables are use to speed up effect calculations by stashing common pre-calculated values
+  #if WLED_FX_WORKERS > 1
+    static std::atomic<unsigned> _usedSegmentData; // amount of data used by all segments (effects on any FX worker may allocate)
+  #else
     static unsigned      _usedSegmentData;    // amount of data used by all segments
-    static unsigned      _vLength;            // 1D dimension used for current effect
-    static unsigned      _vWidth, _vHeight;   // 2D dimensions used for current effect
-    static uint32_t      _currentColors[NUM_COLORS]; // colors used for current effect (faster access from effect functions)
-    static CRGBPalette16 _currentPalette;     // palette used for current effect (includes transition, used in color_from_palette())
+  #endif
     static CRGBPalette16 _randomPalette;      // actual random palette
     static CRGBPalette16 _newRandomPalette;   // target random palette
     static uint16_t      _lastPaletteChange;  // last random palette change time (in seconds)
     static uint16_t      _nextPaletteBlend;   // next due time for random palette morph (in millis())
-    static bool          _modeBlend;          // mode/effect blending semaphore
     // clipping rectangle used for blending
     static uint16_t      _clipStart, _clipStop;
     static uint8_t       _clipStartY, _clipStopY;
@@ -548,6 +624,13 @@ class Segment {
     inline uint32_t getPixelColorXYRaw(unsigned x, unsigned y) const              { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; return pixels[XY(x,y)]; };
   #endif
     void resetIfRequired();         // sets all SEGENV variables to 0 and clears data buffer
+    inline void freeMappingTable() const { p_free(_map12); _map12 = nullptr; }
+  #ifndef WLED_DISABLE_2D
+    const uint16_t *getMappingTable(unsigned vW, unsigned vH) const; // (re)builds mapping table if expansion mode or dimensions changed
+    size_t getMappingTableSize() const;
+  #else
+    inline size_t getMappingTableSize() const { return 0; }
+  #endif
     CRGBPalette16 &loadPalette(CRGBPalette16 &tgt, uint8_t pal);
 
     // transition functions
@@ -560,9 +643,8 @@ class Segment {
     inline uint16_t progress() const          { return isInTransition() ? _t->_progress : 0xFFFFU; } // relies on handleTransition()/updateTransitionProgress() to update progression variable
     inline Segment *getOldSegment() const     { return isInTransition() ? _t->_oldSegment : nullptr; }
 
-    inline static void modeBlend(bool blend)  { Segment::_modeBlend = blend; }
     inline static void setClippingRect(int startX, int stopX, int startY = 0, int stopY = 1) { _clipStart = startX; _clipStop = stopX; _clipStartY = startY; _clipStopY = stopY; };
-    inline static bool isPreviousMode()       { return Segment::_modeBlend; }    // needed for determining CCT/opacity during non-BLEND_STYLE_FADE transition
+    inline static bool isPreviousMode()       { return drawContext().previousMode; } // needed for determining CCT/opacity during non-BLEND_STYLE_FADE transition
 
     static void handleRandomPalette();
 
@@ -591,6 +673,7 @@ class Segment {
     , check2(false)
     , check3(false)
     , blendMode(0)
+    , seed(0)
     , name(nullptr)
     , next_time(0)
     , step(0)
@@ -599,6 +682,7 @@ class Segment {
     , aux1(0)
     , data(nullptr)
     , _dataLen(0)
+    , _map12(nullptr)
     , _default_palette(6)
     , _capabilities(0)
     , _t(nullptr)
@@ -631,13 +715,14 @@ class Segment {
       #endif
       deallocateData();
       p_free(pixels);
+      freeMappingTable();
     }
 
     Segment& operator= (const Segment &orig); // copy assignment
     Segment& operator= (Segment &&orig) noexcept; // move assignment
 
 #ifdef WLED_DEBUG
-    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (pixels?length()*sizeof(uint32_t):0); }
+    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (pixels?length()*sizeof(uint32_t):0) + getMappingTableSize(); }
 #endif
 
     inline bool     getOption(uint8_t n)   const { return ((options >> n) & 0x01); }
@@ -656,15 +741,16 @@ class Segment {
     inline Segment &clearName()                  { p_free(name); name = nullptr; return *this; }
     inline Segment &setName(const String &name)  { return setName(name.c_str()); }
 
-    inline static unsigned vLength()                       { return Segment::_vLength; }
-    inline static unsigned vWidth()                        { return Segment::_vWidth; }
-    inline static unsigned vHeight()                       { return Segment::_vHeight; }
-    inline static uint32_t getCurrentColor(unsigned i)     { return Segment::_currentColors[i<NUM_COLORS?i:0]; }
-    inline static const CRGBPalette16 &getCurrentPalette() { return Segment::_currentPalette; }
+    inline static unsigned vLength()                       { return drawContext().vLength; }
+    inline static unsigned vWidth()                        { return drawContext().vWidth; }
+    inline static unsigned vHeight()                       { return drawContext().vHeight; }
+    inline static uint32_t getCurrentColor(unsigned i)     { return drawContext().colors[i<NUM_COLORS?i:0]; }
+    inline static const CRGBPalette16 &getCurrentPalette() { return drawContext().palette; }
 
-    inline void setDrawDimensions() const { Segment::_vWidth = virtualWidth(); Segment::_vHeight = virtualHeight(); Segment::_vLength = virtualLength(); }
+    inline void setDrawDimensions(RenderContext &ctx) const { ctx.vWidth = virtualWidth(); ctx.vHeight = virtualHeight(); ctx.vLength = virtualLength(); }
+    inline void setDrawDimensions() const { setDrawDimensions(drawContext()); } // sets dimensions of bound context
 
-    void    beginDraw(uint16_t prog = 0xFFFFU);         // set up parameters for current effect
+    void    beginDraw(RenderContext &ctx, uint16_t prog = 0xFFFFU); // set up render context for effect of this segment
     void    setGeometry(uint16_t i1, uint16_t i2, uint8_t grp=1, uint8_t spc=0, uint16_t ofs=UINT16_MAX, uint16_t i1Y=0, uint16_t i2Y=1, uint8_t m12=0);
     Segment &setColor(uint8_t slot, uint32_t c);
     Segment &setCCT(uint16_t k);
@@ -823,7 +909,8 @@ class Segment {
 
 // main "strip" class (108 bytes)
 class WS2812FX {
-  typedef uint16_t (*mode_ptr)(); // pointer to mode function
+  typedef uint16_t (*mode_ptr)(); // pointer to mode function (legacy effect, uses SEGMENT/SEGENV)
+  typedef uint16_t (*render_ptr)(Segment::RenderContext &); // pointer to render kernel (effect getting its render context as argument)
   typedef void (*show_callback)(); // pre show callback
   typedef struct ModeData {
     uint8_t     _id;   // mode (effect) id
@@ -831,6 +918,12 @@ class WS2812FX {
     const char *_data; // mode (effect) name and its UI control data
     ModeData(uint8_t id, uint16_t (*fcn)(void), const char *data) : _id(id), _fcn(fcn), _data(data) {}
   } mode_data_t;
+  typedef struct ModeInfo {
+    uint16_t defaults; // offset of default values section in mode data
+    uint8_t  nameLen;  // length of mode (effect) name (without UI control data)
+    uint8_t  flags;    // FX_INFO_* flags
+    uint8_t  controls; // FX_CTRL_* bits, sliders and checkboxes shown by UI
+  } mode_info_t;
 
   public:
 
@@ -846,6 +939,11 @@ class WS2812FX {
 #endif
       correctWB(false),
       cctFromRgb(false),
+      parallelFX(WLED_FX_WORKERS > 1),
+      canvasWidth(0),
+      canvasHeight(0),
+      canvasX(0),
+      canvasY(0),
       // true private variables
       _pixels(nullptr),
       _pixelCCT(nullptr),
@@ -860,18 +958,28 @@ class WS2812FX {
       _isOffRefreshRequired(false),
       _hasWhiteChannel(false),
       _triggered(false),
-      _segment_index(0),
       _mainSegment(0),
       _modeCount(MODE_COUNT),
+      _renderKernel{0},
+      _parallelSafe{0},
       _callback(nullptr),
       customMappingTable(nullptr),
       customMappingSize(0),
       _lastShow(0),
-      _lastServiceShow(0)
+      _lastServiceShow(0),
+      _frameSyncEpoch(0),
+      _frameSyncPeriod(0),
+      _frameSyncPhase(0),
+      _tileX(0),
+      _tileY(0),
+      _tileWidth(0),
+      _tileHeight(0)
     {
       _mode.reserve(_modeCount);     // allocate memory to prevent initial fragmentation (does not increase size())
       _modeData.reserve(_modeCount); // allocate memory to prevent initial fragmentation (does not increase size())
-      if (_mode.capacity() <= 1 || _modeData.capacity() <= 1) _modeCount = 1; // memory allocation failed only show Solid
+      _modeInfo.reserve(_modeCount);
+      memset(_modeNameIndex, 255, sizeof(_modeNameIndex)); // empty
+      if (_mode.capacity() <= 1 || _modeData.capacity() <= 1 || _modeInfo.capacity() <= 1) _modeCount = 1; // memory allocation failed only show Solid
       else setupEffectData();
     }
 
@@ -881,6 +989,7 @@ class WS2812FX {
       d_free(customMappingTable);
       _mode.clear();
       _modeData.clear();
+      _modeInfo.clear();
       _segments.clear();
 #ifndef WLED_DISABLE_2D
       panel.clear();
@@ -934,6 +1043,7 @@ class WS2812FX {
     inline bool isServicing() const          { return _isServicing; }           // returns true if strip.service() is executing
     inline bool hasWhiteChannel() const      { return _hasWhiteChannel; }       // returns true if strip contains separate white chanel
     inline bool isOffRefreshRequired() const { return _isOffRefreshRequired; }  // returns true if strip requires regular updates (i.e. TM1814 chipset)
+    inline bool isFrameRefreshRequired() const { return _isOffRefreshRequired || BusDigital::getDither(); } // returns true if static content must be shown every frame (temporal dithering)
     inline bool isSuspended() const          { return _suspend; }               // returns true if strip.service() execution is suspended
     inline bool needsUpdate() const          { return _triggered; }             // returns true if strip received a trigger() request
 
@@ -943,11 +1053,13 @@ class WS2812FX {
     uint8_t getLastActiveSegmentId() const;
     uint8_t getActiveSegsLightCapabilities(bool selectedOnly = false) const;
     uint8_t addEffect(uint8_t id, mode_ptr mode_fn, const char *mode_name);         // add effect to the list; defined in FX.cpp;
+    uint8_t addEffect(uint8_t id, render_ptr render_fn, const char *mode_name);     // add render kernel to the list; defined in FX.cpp;
+    inline void setParallelSafe(uint8_t id, bool safe) { if (safe) _parallelSafe[id >> 5] |= 1U << (id & 31); else _parallelSafe[id >> 5] &= ~(1U << (id & 31)); } // effect may run on any FX worker (no statics, globals or other segments)
 
     inline uint8_t getBrightness() const    { return _brightness; }       // returns current strip brightness
     inline static constexpr unsigned getMaxSegments() { return MAX_NUM_SEGMENTS; }  // returns maximum number of supported segments (fixed value)
     inline uint8_t getSegmentsNum() const   { return _segments.size(); }  // returns currently present segments
-    inline uint8_t getCurrSegmentId() const { return _segment_index; }    // returns current segment index (only valid while strip.isServicing())
+    inline uint8_t getCurrSegmentId() const { return Segment::drawContext().segmentIndex; } // returns current segment index (only valid while strip.isServicing())
     inline uint8_t getMainSegmentId() const { return _mainSegment; }      // returns main segment index
     inline uint8_t getTargetFps() const     { return _targetFps; }        // returns rough FPS value for las 2s interval
     inline uint8_t getModeCount() const     { return _modeCount; }        // returns number of registered modes/effects
@@ -969,9 +1081,28 @@ class WS2812FX {
     inline uint32_t getPixelColor(unsigned n) const { return (getMappedPixelIndex(n) < getLengthTotal()) ? _pixels[n] : 0; } // returns color of pixel n, black if out of (mapped) bounds
     inline uint32_t getPixelColorNoMap(unsigned n) const { return (n < getLengthTotal()) ? _pixels[n] : 0; } // ignores mapping table
     inline uint32_t getLastShow() const             { return _lastShow; }                 // returns millis() timestamp of last strip.show() call
+    inline uint32_t getLastFrameStart() const       { return _lastServiceShow; }          // returns millis() timestamp of the frame start (grid aligned when frame synced)
+    inline bool isFrameDue(unsigned long nowUp) const {                                   // returns true if next service() renders a new frame (on the frame clock)
+      unsigned long elapsed = nowUp - _lastServiceShow;
+      if (elapsed <= MIN_FRAME_DELAY) return false;
+      if (_frameSyncPeriod) return elapsed >= _frameSyncPeriod;
+      return _targetFps == FPS_UNLIMITED || elapsed >= _frametime;
+    }
+
+    // frame sync: start frames on a shared grid (epoch + n*period, in strip time) instead of the local frame time
+    inline void setFrameSync(unsigned long epoch, uint16_t period) { _frameSyncEpoch = epoch; _frameSyncPeriod = period; }
+    inline void clearFrameSync()                    { _frameSyncPeriod = 0; _frameSyncPhase = 0; }
+    inline uint16_t getFrameSyncPeriod() const      { return _frameSyncPeriod; }          // returns frame grid period (in ms), 0 if not frame synced
+    inline int16_t  getFrameSyncPhase() const       { return _frameSyncPhase; }           // returns how late the last frame started after its grid point (in ms)
 
     const char *getModeData(unsigned id = 0) const  { return (id && id < _modeCount) ? _modeData[id] : PSTR("Solid"); }
     inline const char **getModeDataSrc()            { return &(_modeData[0]); }           // vectors use arrays for underlying data
+    inline uint8_t getModeFlags(unsigned id) const  { return id < _modeInfo.size() ? _modeInfo[id].flags : 0; }    // returns FX_INFO_* flags of mode
+    inline uint8_t getModeControls(unsigned id) const { return id < _modeInfo.size() ? _modeInfo[id].controls : FX_CTRL_SX | FX_CTRL_IX; } // returns FX_CTRL_* bits of mode
+    inline uint8_t getModeNameLength(unsigned id) const { return (id < _modeCount && id < _modeInfo.size()) ? _modeInfo[id].nameLen : strlen_P(getModeData(id)); } // returns length of mode name in getModeData()
+    inline const char *getModeUIData(unsigned id) const   { return getModeFlags(id) & FX_INFO_DATA     ? _modeData[id] + _modeInfo[id].nameLen + 1 : nullptr; } // UI control data (PROGMEM) after "@"
+    inline const char *getModeDefaults(unsigned id) const { return getModeFlags(id) & FX_INFO_DEFAULTS ? _modeData[id] + _modeInfo[id].defaults    : nullptr; } // default values section (PROGMEM)
+    uint8_t getModeByName(const char *name) const;          // returns id of mode with (exact) name or 255; defined in FX.cpp
 
     Segment&        getSegment(unsigned id);
     inline Segment& getFirstSelectedSeg() { return _segments[getFirstSelectedSegId()]; }  // returns reference to first segment that is "selected"
@@ -1007,11 +1138,32 @@ class WS2812FX {
 #endif
 
     void setUpMatrix();     // sets up automatic matrix ledmap from panel configuration
+#ifdef WLED_ENABLE_FX_GOLDEN
+    int runGoldenTest(bool record); // renders all effects and compares frame hashes with /fxgolden.bin (or records it); defined in fx_golden.cpp
+#endif
 
-    inline void     setPixelColorXY(unsigned x, unsigned y, uint32_t c) const { setPixelColor(y * Segment::maxWidth + x, c); }
+    inline void     setPixelColorXY(unsigned x, unsigned y, uint32_t c) const { int i = getCanvasIndex(x, y); if (i >= 0) setPixelColor(i, c); }
     inline void     setPixelColorXY(unsigned x, unsigned y, byte r, byte g, byte b, byte w = 0) const { setPixelColorXY(x, y, RGBW32(r,g,b,w)); }
     inline void     setPixelColorXY(unsigned x, unsigned y, CRGB c) const     { setPixelColorXY(x, y, RGBW32(c.r,c.g,c.b,0)); }
-    inline uint32_t getPixelColorXY(unsigned x, unsigned y) const             { return getPixelColor(y * Segment::maxWidth + x); }
+    inline uint32_t getPixelColorXY(unsigned x, unsigned y) const             { int i = getCanvasIndex(x, y); return i >= 0 ? getPixelColor(i) : 0; }
+
+    // distributed canvas: Segment::maxWidth x Segment::maxHeight is the whole (logical) canvas, local matrix is a tile of it
+    inline bool     isCanvasTile() const    { return _tileWidth; }                                      // returns true if local matrix is a tile of a larger canvas
+    inline uint16_t getMatrixWidth() const  { return _tileWidth  ? _tileWidth  : Segment::maxWidth; }  // returns width of the local matrix (the part in _pixels)
+    inline uint16_t getMatrixHeight() const { return _tileHeight ? _tileHeight : Segment::maxHeight; } // returns height of the local matrix
+    inline int getCanvasIndex(unsigned x, unsigned y) const {             // converts canvas coordinates into local pixel index, -1 if pixel is rendered by another controller
+      if (!_tileWidth) return x + y * Segment::maxWidth;
+      if (y == 0 && x >= unsigned(Segment::maxWidth * Segment::maxHeight)) { const int i = int(x) + getTrailingOffset(); return i < getLengthTotal() ? i : -1; } // trailing strip
+      x -= _tileX; y -= _tileY;                                           // wraps (and fails the test below) if left/above the tile
+      return (x < _tileWidth && y < _tileHeight) ? int(x + y * _tileWidth) : -1;
+    }
+    // trailing 1D strip follows the canvas in segment coordinates but follows the tile in _pixels
+    inline int      getTrailingOffset() const    { return int(getMatrixWidth() * getMatrixHeight()) - int(Segment::maxWidth * Segment::maxHeight); } // add to segment index to get _pixels index
+    inline unsigned getCanvasLengthTotal() const { return getLengthTotal() - getTrailingOffset(); } // segment address space: canvas and trailing strip
+    inline bool     isOnTile(const Segment &seg) const {                   // returns true if segment has pixels in local frame buffer
+      return !_tileWidth || seg.start >= Segment::maxWidth * Segment::maxHeight
+          || (seg.start < _tileX + _tileWidth && seg.stop > _tileX && seg.startY < _tileY + _tileHeight && seg.stopY > _tileY);
+    }
 
   // end 2D support
 
@@ -1020,9 +1172,12 @@ class WS2812FX {
       bool autoSegments : 1;
       bool correctWB    : 1;
       bool cctFromRgb   : 1;
+      bool parallelFX   : 1; // render independent segments on all FX workers (only if WLED_FX_WORKERS > 1)
     };
+    uint16_t canvasWidth, canvasHeight; // logical canvas spanning several controllers (0 = local matrix only)
+    uint16_t canvasX, canvasY;          // position of the local matrix on the canvas
 
-    Segment *_currentSegment;
+    inline Segment *getCurrentSegment() const { return Segment::drawContext().segment; } // segment being rendered by calling worker (SEGMENT & SEGENV)
 
   private:
     uint32_t *_pixels;
@@ -1047,12 +1202,15 @@ class WS2812FX {
       bool _triggered            : 1;
     };
 
-    uint8_t _segment_index;
     uint8_t _mainSegment;
 
     uint8_t                  _modeCount;
     std::vector<mode_ptr>    _mode;     // SRAM footprint: 4 bytes per element
     std::vector<const char*> _modeData; // mode (effect) name and its slider control data array
+    std::vector<mode_info_t> _modeInfo; // compiled mode data descriptors (6 bytes per element)
+    uint8_t  _modeNameIndex[256];       // open addressing hash table: mode id by hash of its name (255 = empty slot)
+    uint32_t _renderKernel[8];          // bit set if _mode[id] holds a render_ptr (cast to mode_ptr)
+    uint32_t _parallelSafe[8];          // bit set if effect keeps all its state in its segment (see setParallelSafe())
 
     show_callback _callback;
 
@@ -1061,6 +1219,28 @@ class WS2812FX {
 
     unsigned long _lastShow;
     unsigned long _lastServiceShow;
+    unsigned long _frameSyncEpoch;
+    uint16_t      _frameSyncPeriod;
+    int16_t       _frameSyncPhase;
+
+    uint16_t _tileX, _tileY;            // effective canvas tile (set by setUpMatrix(), _tileWidth == 0 if not a tile)
+    uint16_t _tileWidth, _tileHeight;
+
+    void renderSegment(Segment &seg, unsigned long nowUp);  // runs effect function(s) of a due segment and schedules its next frame
+#ifdef WLED_ENABLE_FX_GOLDEN
+    uint32_t renderGoldenFrame(unsigned frame);
+#endif
+    uint16_t runEffect(uint8_t id, Segment::RenderContext &ctx) const; // binds ctx to calling FX worker and runs effect
+    inline bool isRenderKernel(uint8_t id) const  { return _renderKernel[id >> 5] & (1U << (id & 31)); }
+    inline void setRenderKernel(uint8_t id, bool k) { if (k) _renderKernel[id >> 5] |= 1U << (id & 31); else _renderKernel[id >> 5] &= ~(1U << (id & 31)); }
+    void setModeInfo(uint8_t id);                           // compiles descriptor from mode data; defined in FX.cpp
+    void indexModeName(uint8_t id);                         // (re)indexes mode name in _modeNameIndex; defined in FX.cpp
+  #if WLED_FX_WORKERS > 1
+    bool isParallelSafe(const Segment &seg) const;          // segment may be rendered by any FX worker
+    bool startFXWorker();                                   // creates FX worker task/thread (if not yet running)
+    void renderQueue();                                     // renders queued segments until the queue is drained (called by all workers)
+    static void fxWorker(void *);                           // FX worker task/thread function
+  #endif
 
     friend class Segment;
 };
@@ -21,23 +21,38 @@
 void WS2812FX::setUpMatrix() {
 #ifndef WLED_DISABLE_2D
   // isMatrix is set in cfg.cpp or set.cpp
+  _tileWidth = _tileHeight = 0;
   if (isMatrix) {
     // calculate width dynamically because it may have gaps
-    Segment::maxWidth = 1;
-    Segment::maxHeight = 1;
+    unsigned matrixWidth = 1;
+    unsigned matrixHeight = 1;
     for (const Panel &p : panel) {
-      if (p.xOffset + p.width > Segment::maxWidth) {
-        Segment::maxWidth = p.xOffset + p.width;
+      if (p.xOffset + p.width > matrixWidth) {
+        matrixWidth = p.xOffset + p.width;
       }
-      if (p.yOffset + p.height > Segment::maxHeight) {
-        Segment::maxHeight = p.yOffset + p.height;
+      if (p.yOffset + p.height > matrixHeight) {
+        matrixHeight = p.yOffset + p.height;
       }
     }
+    Segment::maxWidth = matrixWidth;
+    Segment::maxHeight = matrixHeight;
+
+    // distributed canvas: segments and effects use canvas coordinates, _pixels only holds the local matrix (tile)
+    if (canvasWidth > 1 && canvasHeight > 1) {
+      _tileX = canvasX;
+      _tileY = canvasY;
+      _tileWidth = matrixWidth;
+      _tileHeight = matrixHeight;
+      Segment::maxWidth  = std::max(unsigned(canvasWidth),  canvasX + matrixWidth);  // canvas must contain the tile
+      Segment::maxHeight = std::max(unsigned(canvasHeight), canvasY + matrixHeight);
+      DEBUG_PRINTF_P(PSTR("Canvas %dx%d, tile %dx%d at %d,%d\n"), Segment::maxWidth, Segment::maxHeight, matrixWidth, matrixHeight, canvasX, canvasY);
+    }
 
     // safety check
-    if (Segment::maxWidth * Segment::maxHeight > MAX_LEDS || Segment::maxWidth > 255 || Segment::maxHeight > 255 || Segment::maxWidth <= 1 || Segment::maxHeight <= 1) {
+    if (matrixWidth * matrixHeight > MAX_LEDS || Segment::maxWidth > 255 || Segment::maxHeight > 255 || matrixWidth <= 1 || matrixHeight <= 1) {
       DEBUG_PRINTLN(F("2D Bounds error."));
       isMatrix = false;
+      _tileWidth = _tileHeight = 0;
       Segment::maxWidth = _length;
       Segment::maxHeight = 1;
       panel.clear(); // release memory allocated by panels
@@ -49,7 +64,7 @@ void WS2812FX::setUpMatrix() {
     customMappingSize = 0; // prevent use of mapping if anything goes wrong
 
     d_free(customMappingTable);
-    // Segment::maxWidth and Segment::maxHeight are set according to panel layout
+    // matrixWidth and matrixHeight are set according to panel layout
     // and the product will include at least all leds in matrix
     // if actual LEDs are more, getLengthTotal() will return correct number of LEDs
     customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer to not use SPI RAM
@@ -58,7 +73,7 @@ void WS2812FX::setUpMatrix() {
       customMappingSize = getLengthTotal();
 
       // fill with empty in case we don't fill the entire matrix
-      unsigned matrixSize = Segment::maxWidth * Segment::maxHeight;
+      unsigned matrixSize = matrixWidth * matrixHeight;
       for (unsigned i = 0; i<matrixSize; i++) customMappingTable[i] = 0xFFFFU;
       for (unsigned i = matrixSize; i<getLengthTotal(); i++) customMappingTable[i] = i; // trailing LEDs for ledmap (after matrix) if it exist
 
@@ -105,7 +120,7 @@ void WS2812FX::setUpMatrix() {
             y = (p.vertical?p.rightStart:p.bottomStart) ? v-j-1 : j;
             x = (p.vertical?p.bottomStart:p.rightStart) ? h-i-1 : i;
             x = p.serpentine && j%2 ? h-x-1 : x;
-            size_t index = (p.yOffset + (p.vertical?x:y)) * Segment::maxWidth + p.xOffset + (p.vertical?y:x);
+            size_t index = (p.yOffset + (p.vertical?x:y)) * matrixWidth + p.xOffset + (p.vertical?y:x);
             if (!gapTable || (gapTable && gapTable[index] >  0)) customMappingTable[index] = pix; // a useful pixel (otherwise -1 is retained)
             if (!gapTable || (gapTable && gapTable[index] >= 0)) pix++; // not a missing pixel
           }
@@ -118,7 +133,7 @@ void WS2812FX::setUpMatrix() {
       #ifdef WLED_DEBUG
       DEBUG_PRINT(F("Matrix ledmap:"));
       for (unsigned i=0; i<customMappingSize; i++) {
-        if (!(i%Segment::maxWidth)) DEBUG_PRINTLN();
+        if (!(i%matrixWidth)) DEBUG_PRINTLN();
         DEBUG_PRINTF_P(PSTR("%4d,"), customMappingTable[i]);
       }
       DEBUG_PRINTLN();
@@ -126,6 +141,7 @@ void WS2812FX::setUpMatrix() {
     } else { // memory allocation error
       DEBUG_PRINTLN(F("ERROR 2D LED map allocation error."));
       isMatrix = false;
+      _tileWidth = _tileHeight = 0;
       panel.clear();
       Segment::maxWidth = _length;
       Segment::maxHeight = 1;
@@ -244,44 +260,15 @@ void Segment::blur2D(uint8_t blur_x, uint8_t blur_y, bool smear) const {
   if (!isActive()) return; // not active
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  const auto XY = [&](unsigned x, unsigned y){ return x + y*cols; };
   if (blur_x) {
     const uint8_t keepx = smear ? 255 : 255 - blur_x;
     const uint8_t seepx = blur_x >> 1;
-    for (unsigned row = 0; row < rows; row++) { // blur rows (x direction)
-      // handle first pixel in row to avoid conditional in loop (faster)
-      uint32_t cur = getPixelColorRaw(XY(0, row));
-      uint32_t carryover = fast_color_scale(cur, seepx);
-      setPixelColorRaw(XY(0, row), fast_color_scale(cur, keepx));
-      for (unsigned x = 1; x < cols; x++) {
-         cur = getPixelColorRaw(XY(x, row));
-        uint32_t part = fast_color_scale(cur, seepx);
-        cur = fast_color_scale(cur, keepx);
-        cur = color_add(cur, carryover);
-        setPixelColorRaw(XY(x - 1, row), color_add(getPixelColorRaw(XY(x-1, row)), part)); // previous pixel
-        setPixelColorRaw(XY(x, row), cur); // current pixel
-        carryover = part;
-      }
-    }
+    for (unsigned row = 0; row < rows; row++) color_blur_span(pixels + row*cols, cols, 1, keepx, seepx);  // blur rows (x direction)
   }
   if (blur_y) {
     const uint8_t keepy = smear ? 255 : 255 - blur_y;
     const uint8_t seepy = blur_y >> 1;
-    for (unsigned col = 0; col < cols; col++) {
-      // handle first pixel in column
-      uint32_t cur = getPixelColorRaw(XY(col, 0));
-      uint32_t carryover = fast_color_scale(cur, seepy);
-      setPixelColorRaw(XY(col, 0), fast_color_scale(cur, keepy));
-      for (unsigned y = 1; y < rows; y++) {
-        cur = getPixelColorRaw(XY(col, y));
-        uint32_t part = fast_color_scale(cur, seepy);
-        cur = fast_color_scale(cur, keepy);
-        cur = color_add(cur, carryover);
-        setPixelColorRaw(XY(col, y - 1), color_add(getPixelColorRaw(XY(col, y-1)), part)); // previous pixel
-        setPixelColorRaw(XY(col, y), cur); // current pixel
-        carryover = part;
-      }
-    }
+    for (unsigned col = 0; col < cols; col++) color_blur_span(pixels + col, rows, cols, keepy, seepy); // blur columns (y direction)
   }
 }
 
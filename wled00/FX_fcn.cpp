@@ -11,6 +11,11 @@
 */
 #include "wled.h"
 #include "FXparticleSystem.h"  // TODO: better define the required function (mem service) in FX.h?
+#if WLED_FX_WORKERS > 1 && !defined(ARDUINO_ARCH_ESP32)
+  #include <thread>
+  #include <mutex>
+  #include <condition_variable>
+#endif
 
 /*
   Custom per-LED mapping has moved!
@@ -36,20 +41,30 @@
 ///////////////////////////////////////////////////////////////////////////////
 // Segment class implementation
 ///////////////////////////////////////////////////////////////////////////////
+#if WLED_FX_WORKERS > 1
+std::atomic<unsigned> Segment::_usedSegmentData(0U); // amount of RAM all segments use for their data[]
+  #ifdef ARDUINO_ARCH_ESP32
+TaskHandle_t fxWorkerTask = nullptr;     // created by WS2812FX::startFXWorker()
+  #else
+thread_local unsigned fxWorkerIndex = 0; // 0 for loop(), 1 for FX worker thread
+  #endif
+#else
 unsigned      Segment::_usedSegmentData   = 0U; // amount of RAM all segments use for their data[]
+#endif
 uint16_t      Segment::maxWidth           = DEFAULT_LED_COUNT;
 uint16_t      Segment::maxHeight          = 1;
-unsigned      Segment::_vLength           = 0;
-unsigned      Segment::_vWidth            = 0;
-unsigned      Segment::_vHeight           = 0;
-uint32_t      Segment::_currentColors[NUM_COLORS] = {0,0,0};
-CRGBPalette16 Segment::_currentPalette    = CRGBPalette16(CRGB::Black);
+Segment::RenderContext  Segment::_idleContext[WLED_FX_WORKERS]; // zero initialised (palette is black)
+Segment::RenderContext *Segment::_context[WLED_FX_WORKERS] = { &Segment::_idleContext[0]
+#if WLED_FX_WORKERS > 1
+  , &Segment::_idleContext[1]
+#endif
+};
+hw_random_t    hwRandomState[WLED_FX_WORKERS] = {};               // bound by WS2812FX::runEffect() for seeded segments
 CRGBPalette16 Segment::_randomPalette     = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 CRGBPalette16 Segment::_newRandomPalette  = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 uint16_t      Segment::_lastPaletteChange = 0; // in seconds; perhaps it should be per segment
 uint16_t      Segment::_nextPaletteBlend  = 0; // in millis
 
-bool     Segment::_modeBlend = false;
 uint16_t Segment::_clipStart = 0;
 uint16_t Segment::_clipStop = 0;
 uint8_t  Segment::_clipStartY = 0;
@@ -64,6 +79,7 @@ Segment::Segment(const Segment &orig) {
   data = nullptr;
   _dataLen = 0;
   pixels = nullptr;
+  _map12 = nullptr; // mapping table is rebuilt on first use
   if (!stop) return;  // nothing to do if segment is inactive/invalid
   if (orig.pixels) {
     // allocate pixel buffer: prefer IRAM/PSRAM
@@ -89,6 +105,7 @@ Segment::Segment(Segment &&orig) noexcept {
   orig.data = nullptr;
   orig._dataLen = 0;
   orig.pixels = nullptr;
+  orig._map12 = nullptr;
 }
 
 // copy assignment
@@ -100,12 +117,14 @@ Segment& Segment::operator= (const Segment &orig) {
     if (_t) stopTransition(); // also erases _t
     deallocateData();
     p_free(pixels);
+    freeMappingTable();
     // copy source
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     // erase pointers to allocated data
     data = nullptr;
     _dataLen = 0;
     pixels = nullptr;
+    _map12 = nullptr;
     if (!stop) return *this;  // nothing to do if segment is inactive/invalid
     // copy source data
     if (orig.pixels) {
@@ -133,12 +152,14 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     if (_t) stopTransition(); // also erases _t
     deallocateData(); // free old runtime data
     p_free(pixels);   // free old pixel buffer
+    freeMappingTable();
     // move source data
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     orig.name = nullptr;
     orig.data = nullptr;
     orig._dataLen = 0;
     orig.pixels = nullptr;
+    orig._map12 = nullptr;
     orig._t = nullptr; // old segment cannot be in transition
   }
   return *this;
@@ -365,29 +386,30 @@ uint8_t Segment::currentBri() const {
 // and blends colors and palettes if necessary
 // prog is the progress of the transition (0-65535) and is passed to the function as it may be called in the context of old segment
 // which does not have transition structure
-void Segment::beginDraw(uint16_t prog) {
-  setDrawDimensions();
-  // load colors into _currentColors
-  for (unsigned i = 0; i < NUM_COLORS; i++) _currentColors[i] = colors[i];
-  // load palette into _currentPalette
-  loadPalette(Segment::_currentPalette, palette);
+void Segment::beginDraw(RenderContext &ctx, uint16_t prog) {
+  setDrawDimensions(ctx);
+  ctx.pinwheelRays[0] = ctx.pinwheelRays[1] = INT_MAX;
+  // load colors into current colors
+  for (unsigned i = 0; i < NUM_COLORS; i++) ctx.colors[i] = colors[i];
+  // load palette into current palette
+  loadPalette(ctx.palette, palette);
   if (isInTransition() && prog < 0xFFFFU && blendingStyle == BLEND_STYLE_FADE) {
     // blend colors
-    for (unsigned i = 0; i < NUM_COLORS; i++) _currentColors[i] = color_blend16(_t->_colors[i], colors[i], prog);
+    for (unsigned i = 0; i < NUM_COLORS; i++) ctx.colors[i] = color_blend16(_t->_colors[i], colors[i], prog);
     // blend palettes
     // there are about 255 blend passes of 48 "blends" to completely blend two palettes (in _dur time)
     // minimum blend time is 100ms maximum is 65535ms
     #ifndef WLED_SAVE_RAM
     unsigned noOfBlends = ((255U * prog) / 0xFFFFU) - _t->_prevPaletteBlends;
     if(noOfBlends > 255) noOfBlends = 255; // safety check
-    for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, Segment::_currentPalette, 48);
-    Segment::_currentPalette = _t->_palT; // copy transitioning/temporary palette
+    for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, ctx.palette, 48);
+    ctx.palette = _t->_palT; // copy transitioning/temporary palette
     #else
     unsigned noOfBlends = ((255U * prog) / 0xFFFFU);
     CRGBPalette16 tmpPalette;
     loadPalette(tmpPalette, _t->_palette);
-    for (unsigned i = 0; i < noOfBlends; i++) nblendPaletteTowardPalette(tmpPalette, Segment::_currentPalette, 48);
-    Segment::_currentPalette = tmpPalette; // copy transitioning/temporary palette
+    for (unsigned i = 0; i < noOfBlends; i++) nblendPaletteTowardPalette(tmpPalette, ctx.palette, 48);
+    ctx.palette = tmpPalette; // copy transitioning/temporary palette
     #endif
   }
 }
@@ -417,7 +439,7 @@ void Segment::handleRandomPalette() {
 
 // sets Segment geometry (length or width/height and grouping, spacing and offset as well as 2D mapping)
 // strip must be suspended (strip.suspend()) before calling this function
-// this function may call fill() to clear pixels if spacing or mapping changed (which requires setting _vWidth, _vHeight, _vLength or beginDraw())
+// this function may call fill() to clear pixels if spacing or mapping changed (which requires setDrawDimensions() or beginDraw())
 void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, uint16_t ofs, uint16_t i1Y, uint16_t i2Y, uint8_t m12) {
   // return if neither bounds nor grouping have changed
   bool boundsUnchanged = (start == i1 && stop == i2);
@@ -435,6 +457,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
     spacing = 0;
   }
   if (ofs < UINT16_MAX) offset = ofs;
+  if (!boundsUnchanged || m12 != map1D2D) freeMappingTable(); // rebuilt on first use
   map1D2D  = constrain(m12, 0, 7);
 
   if (boundsUnchanged) return;
@@ -457,8 +480,8 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
     stop = 0;
     return;
   }
-  if (i1 < Segment::maxWidth || (i1 >= Segment::maxWidth*Segment::maxHeight && i1 < strip.getLengthTotal())) start = i1; // Segment::maxWidth equals strip.getLengthTotal() for 1D
-  stop = i2 > Segment::maxWidth*Segment::maxHeight && i1 >= Segment::maxWidth*Segment::maxHeight ? MIN(i2,strip.getLengthTotal()) : constrain(i2, 1, Segment::maxWidth); // check for 2D trailing strip
+  if (i1 < Segment::maxWidth || (i1 >= Segment::maxWidth*Segment::maxHeight && i1 < strip.getCanvasLengthTotal())) start = i1; // Segment::maxWidth equals strip.getLengthTotal() for 1D
+  stop = i2 > Segment::maxWidth*Segment::maxHeight && i1 >= Segment::maxWidth*Segment::maxHeight ? MIN(i2,strip.getCanvasLengthTotal()) : constrain(i2, 1, Segment::maxWidth); // check for 2D trailing strip (follows canvas)
   startY = 0;
   stopY  = 1;
   #ifndef WLED_DISABLE_2D
@@ -550,31 +573,37 @@ Segment &Segment::setOption(uint8_t n, bool val) {
 
 Segment &Segment::setMode(uint8_t fx, bool loadDefaults) {
   // skip reserved
-  while (fx < strip.getModeCount() && strncmp_P("RSVD", strip.getModeData(fx), 4) == 0) fx++;
+  while (fx < strip.getModeCount() && (strip.getModeFlags(fx) & FX_INFO_RESERVED)) fx++;
   if (fx >= strip.getModeCount()) fx = 0; // set solid mode
   // if we have a valid mode & is not reserved
   if (fx != mode) {
     startTransition(strip.getTransition(), true); // set effect transitions (must create segment copy)
     mode = fx;
     int sOpt;
+    // copy defaults section of effect string once (located by effect descriptor), values are parsed from RAM
+    char defaults[128] = {'\0'};
+    if (strip.getModeDefaults(fx)) {
+      strncpy_P(defaults, strip.getModeDefaults(fx), sizeof(defaults)-1);
+      defaults[sizeof(defaults)-1] = '\0';
+    }
     // load default values from effect string
     if (loadDefaults) {
-      sOpt = extractModeDefaults(fx, "sx");  speed     = (sOpt >= 0) ? sOpt : DEFAULT_SPEED;
-      sOpt = extractModeDefaults(fx, "ix");  intensity = (sOpt >= 0) ? sOpt : DEFAULT_INTENSITY;
-      sOpt = extractModeDefaults(fx, "c1");  custom1   = (sOpt >= 0) ? sOpt : DEFAULT_C1;
-      sOpt = extractModeDefaults(fx, "c2");  custom2   = (sOpt >= 0) ? sOpt : DEFAULT_C2;
-      sOpt = extractModeDefaults(fx, "c3");  custom3   = (sOpt >= 0) ? sOpt : DEFAULT_C3;
-      sOpt = extractModeDefaults(fx, "o1");  check1    = (sOpt >= 0) ? (bool)sOpt : false;
-      sOpt = extractModeDefaults(fx, "o2");  check2    = (sOpt >= 0) ? (bool)sOpt : false;
-      sOpt = extractModeDefaults(fx, "o3");  check3    = (sOpt >= 0) ? (bool)sOpt : false;
-      sOpt = extractModeDefaults(fx, "m12"); if (sOpt >= 0) map1D2D   = constrain(sOpt, 0, 7); else map1D2D = M12_Pixels;  // reset mapping if not defined (2D FX may not work)
-      sOpt = extractModeDefaults(fx, "si");  if (sOpt >= 0) soundSim  = constrain(sOpt, 0, 3);
-      sOpt = extractModeDefaults(fx, "rev"); if (sOpt >= 0) reverse   = (bool)sOpt;
-      sOpt = extractModeDefaults(fx, "mi");  if (sOpt >= 0) mirror    = (bool)sOpt; // NOTE: setting this option is a risky business
-      sOpt = extractModeDefaults(fx, "rY");  if (sOpt >= 0) reverse_y = (bool)sOpt;
-      sOpt = extractModeDefaults(fx, "mY");  if (sOpt >= 0) mirror_y  = (bool)sOpt; // NOTE: setting this option is a risky business
+      sOpt = parseModeDefault(defaults, "sx");  speed     = (sOpt >= 0) ? sOpt : DEFAULT_SPEED;
+      sOpt = parseModeDefault(defaults, "ix");  intensity = (sOpt >= 0) ? sOpt : DEFAULT_INTENSITY;
+      sOpt = parseModeDefault(defaults, "c1");  custom1   = (sOpt >= 0) ? sOpt : DEFAULT_C1;
+      sOpt = parseModeDefault(defaults, "c2");  custom2   = (sOpt >= 0) ? sOpt : DEFAULT_C2;
+      sOpt = parseModeDefault(defaults, "c3");  custom3   = (sOpt >= 0) ? sOpt : DEFAULT_C3;
+      sOpt = parseModeDefault(defaults, "o1");  check1    = (sOpt >= 0) ? (bool)sOpt : false;
+      sOpt = parseModeDefault(defaults, "o2");  check2    = (sOpt >= 0) ? (bool)sOpt : false;
+      sOpt = parseModeDefault(defaults, "o3");  check3    = (sOpt >= 0) ? (bool)sOpt : false;
+      sOpt = parseModeDefault(defaults, "m12"); if (sOpt >= 0) map1D2D   = constrain(sOpt, 0, 7); else map1D2D = M12_Pixels;  // reset mapping if not defined (2D FX may not work)
+      sOpt = parseModeDefault(defaults, "si");  if (sOpt >= 0) soundSim  = constrain(sOpt, 0, 3);
+      sOpt = parseModeDefault(defaults, "rev"); if (sOpt >= 0) reverse   = (bool)sOpt;
+      sOpt = parseModeDefault(defaults, "mi");  if (sOpt >= 0) mirror    = (bool)sOpt; // NOTE: setting this option is a risky business
+      sOpt = parseModeDefault(defaults, "rY");  if (sOpt >= 0) reverse_y = (bool)sOpt;
+      sOpt = parseModeDefault(defaults, "mY");  if (sOpt >= 0) mirror_y  = (bool)sOpt; // NOTE: setting this option is a risky business
     }
-    sOpt = extractModeDefaults(fx, "pal"); // always extract 'pal' to set _default_palette
+    sOpt = parseModeDefault(defaults, "pal"); // always extract 'pal' to set _default_palette
     if (sOpt >= 0 && loadDefaults) setPalette(sOpt);
     if (sOpt <= 0) sOpt = 6; // partycolors if zero or not set
     _default_palette = sOpt; // _deault_palette is loaded into pal0 in loadPalette() (if selected)
@@ -646,6 +675,233 @@ static void setPinwheelParameters(int i, int vW, int vH, int& startx, int& start
   startx = (vW * Fixed_Scale) / 2; // + cosVal[0] / 4; // starting position = center + 1/4 pixel (in fixed point)
   starty = (vH * Fixed_Scale) / 2; // + sinVal[0] / 4;
 }
+
+// draw classes of pixels set by a pinwheel ray, pixels on a line shared with adjacent ray are only drawn if that ray
+// was not drawn just before (see Segment::setPixelColor())
+enum : uint8_t {
+  M12_DRAW_ALWAYS = 0,  // pixel between the two lines of a ray (or at its outer edge)
+  M12_DRAW_FIRST,       // pixel on first line only
+  M12_DRAW_LAST,        // pixel on last line only
+  M12_DRAW_BOTH,        // pixel on both lines
+  M12_DRAW_CLASSES
+};
+
+// calls fn(x, y, drawClass) for each pixel set by 1D index i in arc, corner and pinwheel expansion (pixel may fall outside of segment)
+template<typename F>
+static void forEachMappedPixel(unsigned map, int i, int vW, int vH, F fn) {
+  switch (map) {
+    case M12_pArc:
+      // expand in circular fashion from center
+      if (i == 0)
+        fn(0, 0, M12_DRAW_ALWAYS);
+      else {
+        float r = i;
+        float step = HALF_PI / (2.8284f * r + 4); // we only need (PI/4)/(r/sqrt(2)+1) steps
+        for (float rad = 0.0f; rad <= (HALF_PI/2)+step/2; rad += step) {
+          int x = roundf(sin_t(rad) * r);
+          int y = roundf(cos_t(rad) * r);
+          // exploit symmetry
+          fn(x, y, M12_DRAW_ALWAYS);
+          fn(y, x, M12_DRAW_ALWAYS);
+        }
+        // Bresenham’s Algorithm (may not fill every pixel)
+        //int d = 3 - (2*i);
+        //int y = i, x = 0;
+        //while (y >= x) {
+        //  setPixelColorXY(x, y, col);
+        //  setPixelColorXY(y, x, col);
+        //  x++;
+        //  if (d > 0) {
+        //    y--;
+        //    d += 4 * (x - y) + 10;
+        //  } else {
+        //    d += 4 * x + 6;
+        //  }
+        //}
+      }
+      break;
+    case M12_pCorner:
+      for (int x = 0; x <= i; x++) fn(x, i, M12_DRAW_ALWAYS); // note: <= to include i=0. Relies on caller's overflow check
+      for (int y = 0; y <  i; y++) fn(i, y, M12_DRAW_ALWAYS);
+      break;
+    case M12_sPinwheel: {
+      // Uses Bresenham's algorithm to place coordinates of two lines in arrays then fills between them
+      int startX, startY, cosVal[2], sinVal[2]; // in fixed point scale
+      setPinwheelParameters(i, vW, vH, startX, startY, cosVal, sinVal);
+
+      unsigned maxLineLength = max(vW, vH) + 2; // pixels drawn is always smaller than dx or dy, +1 pair for rounding errors
+      uint16_t lineCoords[2][maxLineLength];    // uint16_t to save ram
+      int lineLength[2] = {0};
+
+      int closestEdgeIdx = INT_MAX; // index of the closest edge pixel
+
+      for (int lineNr = 0; lineNr < 2; lineNr++) {
+        int x0 = startX; // x, y coordinates in fixed scale
+        int y0 = startY;
+        int x1 = (startX + (cosVal[lineNr] << 9)); // outside of grid
+        int y1 = (startY + (sinVal[lineNr] << 9)); // outside of grid
+        const int dx =  abs(x1-x0), sx = x0<x1 ? 1 : -1; // x distance & step
+        const int dy = -abs(y1-y0), sy = y0<y1 ? 1 : -1; // y distance & step
+        uint16_t* coordinates = lineCoords[lineNr]; // 1D access is faster
+        int* length = &lineLength[lineNr];          // faster access
+        x0 /= Fixed_Scale; // convert to pixel coordinates
+        y0 /= Fixed_Scale;
+
+        // Bresenham's algorithm
+        int idx = 0;
+        int err = dx + dy;
+        while (true) {
+          if ((unsigned)x0 >= (unsigned)vW || (unsigned)y0 >= (unsigned)vH) {
+            closestEdgeIdx = min(closestEdgeIdx, idx-2);
+            break; // stop if outside of grid (exploit unsigned int overflow)
+          }
+          coordinates[idx++] = x0;
+          coordinates[idx++] = y0;
+          (*length)++;
+          // note: since endpoint is out of grid, no need to check if endpoint is reached
+          int e2 = 2 * err;
+          if (e2 >= dy) { err += dy; x0 += sx; }
+          if (e2 <= dx) { err += dx; y0 += sy; }
+        }
+      }
+
+      // fill up the shorter line with missing coordinates, so block filling works correctly and efficiently
+      int diff = lineLength[0] - lineLength[1];
+      int longLineIdx = (diff > 0) ? 0 : 1;
+      int shortLineIdx = longLineIdx ? 0 : 1;
+      if (diff != 0) {
+        int idx = (lineLength[shortLineIdx] - 1) * 2; // last valid coordinate index
+        int lastX = lineCoords[shortLineIdx][idx++];
+        int lastY = lineCoords[shortLineIdx][idx++];
+        bool keepX = lastX == 0 || lastX == vW - 1;
+        for (int d = 0; d < abs(diff); d++) {
+          lineCoords[shortLineIdx][idx] = keepX ? lastX :lineCoords[longLineIdx][idx];
+          idx++;
+          lineCoords[shortLineIdx][idx] =  keepX ? lineCoords[longLineIdx][idx] : lastY;
+          idx++;
+        }
+      }
+
+      // block-fill the line coordinates. Note: block filling only efficient if angle between lines is small
+      closestEdgeIdx += 2;
+      for (int idx = 0; idx < lineLength[longLineIdx] * 2;) {
+        int x1 = lineCoords[0][idx];
+        int x2 = lineCoords[1][idx++];
+        int y1 = lineCoords[0][idx];
+        int y2 = lineCoords[1][idx++];
+        int minX, maxX, minY, maxY;
+        (x1 < x2) ? (minX = x1, maxX = x2) : (minX = x2, maxX = x1);
+        (y1 < y2) ? (minY = y1, maxY = y2) : (minY = y2, maxY = y1);
+
+        // fill the block between the two x,y points
+        bool alwaysDraw = (idx > closestEdgeIdx)  || // Edge pixels on uneven lines are always drawn
+                          (i == 0 && idx == 2);      // Center pixel special case
+        for (int x = minX; x <= maxX; x++) {
+          for (int y = minY; y <= maxY; y++) {
+            bool onLine1 = x == x1 && y == y1;
+            bool onLine2 = x == x2 && y == y2;
+            fn(x, y, (alwaysDraw || (!onLine1 && !onLine2)) ? M12_DRAW_ALWAYS : // middle pixels
+                     (onLine1 && onLine2) ? M12_DRAW_BOTH : onLine1 ? M12_DRAW_FIRST : M12_DRAW_LAST);
+          }
+        }
+      }
+      break;
+    }
+  }
+}
+
+// returns coordinates of the pixel getPixelColor() uses for 1D index i in arc, corner and pinwheel expansion
+static void getMappedPixel(unsigned map, int i, int vW, int vH, int &x, int &y) {
+  x = y = 0;
+  switch (map) {
+    case M12_pArc:
+      if (i > vW && i > vH) {
+        x = y = sqrt32_bw(i*i/2);
+        break; // use diagonal
+      }
+      // otherwise fallthrough
+    case M12_pCorner:
+      // use longest dimension
+      if (vW > vH) x = i;
+      else         y = i;
+      break;
+    case M12_sPinwheel: {
+      // not 100% accurate, returns pixel at outer edge
+      int cosVal[2], sinVal[2];
+      setPinwheelParameters(i, vW, vH, x, y, cosVal, sinVal, true);
+      int maxX = (vW-1) * Fixed_Scale;
+      int maxY = (vH-1) * Fixed_Scale;
+      // trace ray from center until we hit any edge - to avoid rounding problems, we use fixed point coordinates
+      while ((x < maxX)  && (y < maxY) && (x > Fixed_Scale) && (y > Fixed_Scale)) {
+        x += cosVal[0]; // advance to next position
+        y += sinVal[0];
+      }
+      x /= Fixed_Scale;
+      y /= Fixed_Scale;
+      break;
+    }
+  }
+}
+
+// mapping table layout (uint16_t): header [map1D2D, vW, vH, vLen], vLen*classes+1 offsets into pixel list (pixels of each 1D index
+// are grouped by draw class), vLen pixels returned by getPixelColor() (0xFFFF if outside segment) and pixel list (x + y*vW)
+// a header-only table (vLen == 0) marks that the table could not be allocated for the current geometry
+constexpr unsigned M12_HEADER = 4;
+static inline unsigned mappingClasses(unsigned map) { return map == M12_sPinwheel ? M12_DRAW_CLASSES : 1; }
+
+// returns cached mapping table for current expansion mode and virtual dimensions (builds it if geometry changed)
+// returns nullptr if pixels need to be calculated on the fly (not enough RAM)
+const uint16_t *Segment::getMappingTable(unsigned vW, unsigned vH) const {
+  if (_map12 && _map12[0] == map1D2D && _map12[1] == vW && _map12[2] == vH) return _map12[3] ? _map12 : nullptr;
+  freeMappingTable();
+  const unsigned vLen    = vLength();
+  const unsigned classes = mappingClasses(map1D2D);
+  // 1st pass: count pixels (offsets and pixel indices must fit 16 bits)
+  size_t count = 0;
+  for (unsigned i = 0; i < vLen; i++) forEachMappedPixel(map1D2D, i, vW, vH, [&](int x, int y, unsigned) { if ((unsigned)x < vW && (unsigned)y < vH) count++; });
+  if (count < 0xFFFFU && vW * vH < 0xFFFFU) {
+    _map12 = static_cast<uint16_t*>(allocate_buffer((M12_HEADER + vLen * classes + 1 + vLen + count) * sizeof(uint16_t), BFRALLOC_PREFER_PSRAM));
+  }
+  if (!_map12) {
+    DEBUGFX_PRINTF_P(PSTR("!!! No RAM for 1D2D map (%u pixels) !!!\n"), (unsigned)count);
+    _map12 = static_cast<uint16_t*>(allocate_buffer(M12_HEADER * sizeof(uint16_t), BFRALLOC_PREFER_DRAM));
+    if (_map12) { _map12[0] = map1D2D; _map12[1] = vW; _map12[2] = vH; _map12[3] = 0; }
+    return nullptr;
+  }
+  _map12[0] = map1D2D;
+  _map12[1] = vW;
+  _map12[2] = vH;
+  _map12[3] = vLen;
+  uint16_t *ofs = _map12 + M12_HEADER;
+  uint16_t *rev = ofs + vLen * classes + 1;
+  uint16_t *px  = rev + vLen;
+  // 2nd pass: store pixel indices grouped by draw class (consecutive duplicates are skipped)
+  unsigned n = 0;
+  for (unsigned i = 0; i < vLen; i++) {
+    for (unsigned c = 0; c < classes; c++) {
+      const unsigned first = n;
+      ofs[i * classes + c] = n;
+      forEachMappedPixel(map1D2D, i, vW, vH, [&](int x, int y, unsigned cls) {
+        if (cls != c || (unsigned)x >= vW || (unsigned)y >= vH) return;
+        const unsigned xy = x + y * vW;
+        if (n == first || px[n-1] != xy) px[n++] = xy;
+      });
+    }
+    int x, y;
+    getMappedPixel(map1D2D, i, vW, vH, x, y);
+    rev[i] = ((unsigned)x < vW && (unsigned)y < vH) ? x + y * vW : 0xFFFFU;
+  }
+  ofs[vLen * classes] = n;
+  return _map12;
+}
+
+size_t Segment::getMappingTableSize() const {
+  if (!_map12) return 0;
+  const unsigned vLen = _map12[3];
+  if (!vLen) return M12_HEADER * sizeof(uint16_t);
+  const unsigned classes = mappingClasses(_map12[0]);
+  return (M12_HEADER + vLen * classes + 1 + vLen + _map12[M12_HEADER + vLen * classes]) * sizeof(uint16_t);
+}
 #endif
 
 // 1D strip
@@ -743,132 +999,29 @@ void WLED_O2_ATTR Segment::setPixelColor(int i, uint32_t col) const
         else for (int x = 0; x < vW; x++) setPixelColorRaw(XY(x, vH - i - 1), col);
         break;
       case M12_pArc:
-        // expand in circular fashion from center
-        if (i == 0)
-          setPixelColorRaw(XY(0, 0), col);
-        else {
-          float r = i;
-          float step = HALF_PI / (2.8284f * r + 4); // we only need (PI/4)/(r/sqrt(2)+1) steps
-          for (float rad = 0.0f; rad <= (HALF_PI/2)+step/2; rad += step) {
-            int x = roundf(sin_t(rad) * r);
-            int y = roundf(cos_t(rad) * r);
-            // exploit symmetry
-            setPixelColorXY(x, y, col);
-            setPixelColorXY(y, x, col);
-          }
-          // Bresenham’s Algorithm (may not fill every pixel)
-          //int d = 3 - (2*i);
-          //int y = i, x = 0;
-          //while (y >= x) {
-          //  setPixelColorXY(x, y, col);
-          //  setPixelColorXY(y, x, col);
-          //  x++;
-          //  if (d > 0) {
-          //    y--;
-          //    d += 4 * (x - y) + 10;
-          //  } else {
-          //    d += 4 * x + 6;
-          //  }
-          //}
-        }
-        break;
       case M12_pCorner:
-        for (int x = 0; x <= i; x++) setPixelColorXY(x, i, col); // note: <= to include i=0. Relies on overflow check in sPC()
-        for (int y = 0; y <  i; y++) setPixelColorXY(i, y, col);
-        break;
       case M12_sPinwheel: {
-        // Uses Bresenham's algorithm to place coordinates of two lines in arrays then draws between them
-        int startX, startY, cosVal[2], sinVal[2]; // in fixed point scale
-        setPinwheelParameters(i, vW, vH, startX, startY, cosVal, sinVal);
-
-        unsigned maxLineLength = max(vW, vH) + 2; // pixels drawn is always smaller than dx or dy, +1 pair for rounding errors
-        uint16_t lineCoords[2][maxLineLength];    // uint16_t to save ram
-        int lineLength[2] = {0};
-
-        static int prevRays[2] = {INT_MAX, INT_MAX}; // previous two ray numbers
-        int closestEdgeIdx = INT_MAX; // index of the closest edge pixel
-
-        for (int lineNr = 0; lineNr < 2; lineNr++) {
-          int x0 = startX; // x, y coordinates in fixed scale
-          int y0 = startY;
-          int x1 = (startX + (cosVal[lineNr] << 9)); // outside of grid
-          int y1 = (startY + (sinVal[lineNr] << 9)); // outside of grid
-          const int dx =  abs(x1-x0), sx = x0<x1 ? 1 : -1; // x distance & step
-          const int dy = -abs(y1-y0), sy = y0<y1 ? 1 : -1; // y distance & step
-          uint16_t* coordinates = lineCoords[lineNr]; // 1D access is faster
-          int* length = &lineLength[lineNr];          // faster access
-          x0 /= Fixed_Scale; // convert to pixel coordinates
-          y0 /= Fixed_Scale;
-
-          // Bresenham's algorithm
-          int idx = 0;
-          int err = dx + dy;
-          while (true) {
-            if ((unsigned)x0 >= (unsigned)vW || (unsigned)y0 >= (unsigned)vH) {
-              closestEdgeIdx = min(closestEdgeIdx, idx-2);
-              break; // stop if outside of grid (exploit unsigned int overflow)
-            }
-            coordinates[idx++] = x0;
-            coordinates[idx++] = y0;
-            (*length)++;
-            // note: since endpoint is out of grid, no need to check if endpoint is reached
-            int e2 = 2 * err;
-            if (e2 >= dy) { err += dy; x0 += sx; }
-            if (e2 <= dx) { err += dx; y0 += sy; }
-          }
+        unsigned draw = 1U << M12_DRAW_ALWAYS; // draw classes of pixels to set
+        if (map1D2D == M12_sPinwheel) {
+          RenderContext &ctx = drawContext(); // previous rays are tracked per effect call
+          const int maxI = vL - 1;
+          const bool drawFirst = !(ctx.pinwheelRays[0] == i - 1 || (i == 0 && ctx.pinwheelRays[0] == maxI)); // draw first line if previous ray was not adjacent including wrap
+          const bool drawLast  = !(ctx.pinwheelRays[0] == i + 1 || (i == maxI && ctx.pinwheelRays[0] == 0)); // same as above for last line
+          const bool drawAll   = (drawFirst && drawLast) || i == ctx.pinwheelRays[1]; // no adjacent rays or effect drawing twice in 1 frame
+          if (drawFirst || drawAll) draw |= 1U << M12_DRAW_FIRST;
+          if (drawLast  || drawAll) draw |= 1U << M12_DRAW_LAST;
+          if (drawAll)              draw |= 1U << M12_DRAW_BOTH;
+          ctx.pinwheelRays[1] = ctx.pinwheelRays[0];
+          ctx.pinwheelRays[0] = i;
         }
-
-        // fill up the shorter line with missing coordinates, so block filling works correctly and efficiently
-        int diff = lineLength[0] - lineLength[1];
-        int longLineIdx = (diff > 0) ? 0 : 1;
-        int shortLineIdx = longLineIdx ? 0 : 1;
-        if (diff != 0) {
-          int idx = (lineLength[shortLineIdx] - 1) * 2; // last valid coordinate index
-          int lastX = lineCoords[shortLineIdx][idx++];
-          int lastY = lineCoords[shortLineIdx][idx++];
-          bool keepX = lastX == 0 || lastX == vW - 1;
-          for (int d = 0; d < abs(diff); d++) {
-            lineCoords[shortLineIdx][idx] = keepX ? lastX :lineCoords[longLineIdx][idx];
-            idx++;
-            lineCoords[shortLineIdx][idx] =  keepX ? lineCoords[longLineIdx][idx] : lastY;
-            idx++;
-          }
-        }
-
-        // draw and block-fill the line coordinates. Note: block filling only efficient if angle between lines is small
-        closestEdgeIdx += 2;
-        int max_i = getPinwheelLength(vW, vH) - 1;
-        bool drawFirst = !(prevRays[0] == i - 1 || (i == 0 && prevRays[0] == max_i)); // draw first line if previous ray was not adjacent including wrap
-        bool drawLast  = !(prevRays[0] == i + 1 || (i == max_i && prevRays[0] == 0)); // same as above for last line
-        for (int idx = 0; idx < lineLength[longLineIdx] * 2;) { //!! should be long line idx!
-          int x1 = lineCoords[0][idx];
-          int x2 = lineCoords[1][idx++];
-          int y1 = lineCoords[0][idx];
-          int y2 = lineCoords[1][idx++];
-          int minX, maxX, minY, maxY;
-          (x1 < x2) ? (minX = x1, maxX = x2) : (minX = x2, maxX = x1);
-          (y1 < y2) ? (minY = y1, maxY = y2) : (minY = y2, maxY = y1);
-
-          // fill the block between the two x,y points
-          bool alwaysDraw = (drawFirst && drawLast) || // No adjacent rays, draw all pixels
-                            (idx > closestEdgeIdx)  || // Edge pixels on uneven lines are always drawn
-                            (i == 0 && idx == 2)    || // Center pixel special case
-                            (i == prevRays[1]);        // Effect drawing twice in 1 frame
-          for (int x = minX; x <= maxX; x++) {
-            for (int y = minY; y <= maxY; y++) {
-              bool onLine1 = x == x1 && y == y1;
-              bool onLine2 = x == x2 && y == y2;
-              if ((alwaysDraw) ||
-                  (!onLine1 && (!onLine2 || drawLast))  || // Middle pixels and line2 if drawLast
-                  (!onLine2 && (!onLine1 || drawFirst))    // Middle pixels and line1 if drawFirst
-                ) {
-                setPixelColorXY(x, y, col);
-              }
-            }
-          }
+        if (const uint16_t *map = getMappingTable(vW, vH)) {
+          const unsigned classes = mappingClasses(map1D2D);
+          const uint16_t *ofs = map + M12_HEADER + i * classes;
+          const uint16_t *px  = map + M12_HEADER + vL * classes + 1 + vL;
+          for (unsigned c = 0; c < classes; c++) if (draw & (1U << c)) for (unsigned n = ofs[c]; n < ofs[c+1]; n++) setPixelColorRaw(px[n], col);
+        } else {
+          forEachMappedPixel(map1D2D, i, vW, vH, [&](int x, int y, unsigned cls) { if (draw & (1U << cls)) setPixelColorXY(x, y, col); });
         }
-        prevRays[1] = prevRays[0];
-        prevRays[0] = i;
         break;
       }
     }
@@ -947,31 +1100,15 @@ uint32_t WLED_O2_ATTR Segment::getPixelColor(int i) const
         else            { y = vH - i - 1; };
         break;
       case M12_pArc:
-        if (i > vW && i > vH) {
-          x = y = sqrt32_bw(i*i/2);
-          break; // use diagonal
-        }
-        // otherwise fallthrough
       case M12_pCorner:
-        // use longest dimension
-        if (vW > vH) x = i;
-        else         y = i;
-        break;
-      case M12_sPinwheel: {
-        // not 100% accurate, returns pixel at outer edge
-        int cosVal[2], sinVal[2];
-        setPinwheelParameters(i, vW, vH, x, y, cosVal, sinVal, true);
-        int maxX = (vW-1) * Fixed_Scale;
-        int maxY = (vH-1) * Fixed_Scale;
-        // trace ray from center until we hit any edge - to avoid rounding problems, we use fixed point coordinates
-        while ((x < maxX)  && (y < maxY) && (x > Fixed_Scale) && (y > Fixed_Scale)) {
-          x += cosVal[0]; // advance to next position
-          y += sinVal[0];
+      case M12_sPinwheel:
+        if (const uint16_t *map = getMappingTable(vW, vH)) {
+          const unsigned vL  = vLength();
+          const unsigned xy  = map[M12_HEADER + vL * mappingClasses(map1D2D) + 1 + i];
+          return xy < 0xFFFFU ? getPixelColorRaw(xy) : 0;
         }
-        x /= Fixed_Scale;
-        y /= Fixed_Scale;
+        getMappedPixel(map1D2D, i, vW, vH, x, y);
         break;
-      }
     }
     return getPixelColorXY(x, y);
   }
@@ -989,8 +1126,9 @@ void Segment::refreshLightCapabilities() const {
 
   // we must traverse each pixel in segment to determine its capabilities (as pixel may be mapped)
   for (unsigned y = startY; y < stopY; y++) for (unsigned x = start; x < stop; x++) {
-    unsigned index = x + Segment::maxWidth * y;
-    index = strip.getMappedPixelIndex(index); // convert logical address to physical
+    int local = strip.getCanvasIndex(x, y);
+    if (local < 0) continue;        // pixel belongs to another controller's tile
+    unsigned index = strip.getMappedPixelIndex(local); // convert logical address to physical
     if (index == 0xFFFF) continue;  // invalid/missing  pixel
     for (unsigned b = 0; b < BusManager::getNumBusses(); b++) {
       const Bus *bus = BusManager::getBus(b);
@@ -1019,7 +1157,8 @@ void Segment::refreshLightCapabilities() const {
  */
 void Segment::fill(uint32_t c) const {
   if (!isActive()) return; // not active
-  for (unsigned i = 0; i < length(); i++) setPixelColorRaw(i,c); // always fill all pixels (blending will take care of grouping, spacing and clipping)
+  const size_t len = length(); // always fill all pixels (blending will take care of grouping, spacing and clipping)
+  for (size_t i = 0; i < len; i++) pixels[i] = c; // direct buffer write, compiles to a tight store loop
 }
 
 /*
@@ -1031,37 +1170,19 @@ void Segment::fade_out(uint8_t rate) const {
   if (!isActive()) return; // not active
   rate = (256-rate) >> 1;
   const int mappedRate = 256 / (rate + 1);
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned j = 0; j < rlength; j++) {
-    uint32_t color = getPixelColorRaw(j);
-    if (color == colors[1]) continue; // already at target color
-    for (int i = 0; i < 32; i += 8) {
-      uint8_t c2 = (colors[1]>>i);  // get background channel
-      uint8_t c1 = (color>>i);      // get foreground channel
-      // we can't use bitshift since we are using int
-      int delta = (c2 - c1) * mappedRate / 256;
-      // if fade isn't complete, make sure delta is at least 1 (fixes rounding issues)
-      if (delta == 0) delta += (c2 == c1) ? 0 : (c2 > c1) ? 1 : -1;
-      // stuff new value back into color
-      color &= ~(0xFF<<i);
-      color |= ((c1 + delta) & 0xFF) << i;
-    }
-    setPixelColorRaw(j, color);
-  }
+  color_fade_out_span(pixels, rawLength(), colors[1], mappedRate); // fade towards background color
 }
 
 // fades all pixels to secondary color
 void Segment::fadeToSecondaryBy(uint8_t fadeBy) const {
   if (!isActive() || fadeBy == 0) return;   // optimization - no scaling to apply
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned i = 0; i < rlength; i++) setPixelColorRaw(i, color_blend(getPixelColorRaw(i), colors[1], fadeBy));
+  color_blend_span(pixels, rawLength(), colors[1], fadeBy);
 }
 
 // fades all pixels to black using nscale8()
 void Segment::fadeToBlackBy(uint8_t fadeBy) const {
   if (!isActive() || fadeBy == 0) return;   // optimization - no scaling to apply
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned i = 0; i < rlength; i++) setPixelColorRaw(i, fast_color_scale(getPixelColorRaw(i), 255-fadeBy));
+  color_scale_span(pixels, rawLength(), 255-fadeBy);
 }
 
 /*
@@ -1080,20 +1201,7 @@ void Segment::blur(uint8_t blur_amount, bool smear) const {
 #endif
   uint8_t keep = smear ? 255 : 255 - blur_amount;
   uint8_t seep = blur_amount >> 1;
-  unsigned vlength = vLength();
-  // handle first pixel to avoid conditional in loop (faster)
-  uint32_t cur = getPixelColorRaw(0);
-  uint32_t carryover = fast_color_scale(cur, seep);
-  setPixelColorRaw(0, fast_color_scale(cur, keep));
-  for (unsigned i = 1; i < vlength; i++) {
-    cur = getPixelColorRaw(i);
-    uint32_t part = fast_color_scale(cur, seep);
-    cur = fast_color_scale(cur, keep);
-    cur = color_add(cur, carryover);
-    setPixelColorRaw(i - 1, color_add(getPixelColorRaw(i - 1), part)); // previous pixel
-    setPixelColorRaw(i, cur); // current pixel
-    carryover = part;
-  }
+  color_blur_span(pixels, vLength(), 1, keep, seep);
 }
 
 /*
@@ -1135,7 +1243,7 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool moving, uint
     case 1: blend = LINEARBLEND; break;
     case 2: blend = LINEARBLEND_NOWRAP; break;
   }
-  CRGBW palcol = ColorFromPalette(_currentPalette, paletteIndex, pbri, blend);
+  CRGBW palcol = ColorFromPalette(getCurrentPalette(), paletteIndex, pbri, blend);
   palcol.w = W(color);
 
   return palcol.color32;
@@ -1237,10 +1345,12 @@ void WS2812FX::finalizeInit() {
     bus->setBrightness(scaledBri(bri));
   }
   BusManager::initializeABL(); // init brightness limiter
+  BusManager::updateColorOrderSpans(); // resolve color order map for each bus
   DEBUG_PRINTF_P(PSTR("Heap after buses: %d\n"), ESP.getFreeHeap());
 
   Segment::maxWidth  = _length;
   Segment::maxHeight = 1;
+  _tileWidth = _tileHeight = 0;
 
   //segments are created in makeAutoSegments();
   DEBUG_PRINTLN(F("Loading custom palettes"));
@@ -1256,19 +1366,160 @@ void WS2812FX::finalizeInit() {
   DEBUG_PRINTF_P(PSTR("Heap after strip init: %uB\n"), getFreeHeapSize());
 }
 
+// outgoing effect of a transition is not rendered for blending styles selected in transitionSnapshot
+// blendSegment() then uses the old segment's pixels as they were copied at the start of transition (its last frame)
+static inline bool isTransitionSnapshot() { return (transitionSnapshot >> blendingStyle) & 1U; }
+
+// effects drawing from FastLED's random8()/random16() (global seed), usermod effects are unknown
+static bool usesRandom16(uint8_t mode) {
+  switch (mode) {
+    case FX_MODE_RANDOM_CHASE:               // also save and restore the seed
+    case FX_MODE_TWINKLEUP:
+    case FX_MODE_2DCRAZYBEES:
+    case FX_MODE_2DGAMEOFLIFE:
+    case FX_MODE_PARTICLEFIREWORKS:
+      return true;
+  }
+  return mode >= MODE_COUNT;
+}
+
+// binds render context to the calling FX worker and runs effect function
+// legacy effects (mode_ptr) reach the context through SEGMENT/SEGENV, render kernels (render_ptr) also get it as argument
+// a segment with a seed gets reproducible random numbers: hw_random*() (and FastLED's random8()/random16()) draw from
+// a PRNG seeded with segment seed, segment id and frame counter, so the same frame of an effect looks the same on every
+// run and on every synced controller (strip.timebase is not used as it is an offset to each controller's own millis())
+uint16_t WS2812FX::runEffect(uint8_t id, Segment::RenderContext &ctx) const {
+  const unsigned worker = fxWorkerId();
+  Segment::RenderContext *&bound = Segment::_context[worker];
+  Segment::RenderContext *prev = bound;
+  const hw_random_t prevRandom = hwRandomState[worker];
+  bound = &ctx;
+  if (ctx.segment->seed) {
+    ctx.randomState = segmentRandomState(ctx.segment->seed, ctx.segmentIndex, ctx.previousMode, ctx.segment->call);
+    hwRandomState[worker] = { fxTaskId(), &ctx.randomState };
+    if (usesRandom16(id)) random16_set_seed(hw_random16()); // FastLED has a single global seed, such effects are never rendered in parallel
+  } else {
+    hwRandomState[worker].state = nullptr;
+  }
+  unsigned frameDelay = isRenderKernel(id) ? (*reinterpret_cast<render_ptr>(_mode[id]))(ctx) : (*_mode[id])();
+  hwRandomState[worker] = prevRandom;
+  bound = prev; // never leave a dangling (stack) context bound
+  return frameDelay;
+}
+
+// runs effect function of a due segment (and effect of its old segment if in transition)
+// each effect gets its own render context so it may run concurrently for different segments (see isParallelSafe())
+void WS2812FX::renderSegment(Segment &seg, unsigned long nowUp) {
+  unsigned frameDelay = FRAMETIME;
+
+  if (!isOnTile(seg)) frameDelay = 350; // distributed canvas: segment is rendered by other controllers only
+  else if (!seg.freeze) { //only run effect function if not frozen
+    Segment::RenderContext ctx;
+    ctx.segment      = &seg;
+    ctx.segmentIndex = &seg - _segments.data();
+    ctx.previousMode = false;
+    // Effect blending
+    uint16_t prog = seg.progress();
+    seg.beginDraw(ctx, prog);           // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
+    // workaround for on/off transition to respect blending style
+    frameDelay = runEffect(seg.mode, ctx); // run new/current mode (needed for bri workaround)
+    seg.call++;
+    // if segment is in transition and no old segment exists we don't need to run the old mode
+    // (blendSegments() takes care of On/Off transitions and clipping)
+    Segment *segO = seg.getOldSegment();
+    if (segO && segO->isActive() && !isTransitionSnapshot() && (seg.mode != segO->mode || blendingStyle != BLEND_STYLE_FADE ||
+        (segO->name != seg.name && segO->name && seg.name && strncmp(segO->name, seg.name, WLED_MAX_SEGNAME_LEN) != 0))) {
+      // old segment is drawn in the same context (new effect has finished with it), nothing needs restoring afterwards
+      ctx.segment      = segO;
+      ctx.previousMode = true;
+      segO->beginDraw(ctx, prog);       // set up palette & colors (also sets draw dimensions), parent segment has transition progress
+      // workaround for on/off transition to respect blending style
+      frameDelay = min(frameDelay, (unsigned)runEffect(segO->mode, ctx)); // run old mode (needed for bri workaround)
+      segO->call++;                     // increment old mode run counter
+    }
+    if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
+  }
+
+  seg.next_time = nowUp + frameDelay;
+}
+
+#if WLED_FX_WORKERS > 1
+static RenderQueue<MAX_NUM_SEGMENTS> _renderQueue;          // indices of due segments that may be rendered by any FX worker
+static unsigned long         _renderQueueNow = 0;            // millis() of current frame
+#ifndef ARDUINO_ARCH_ESP32
+static std::thread          *_fxWorkerThread = nullptr;
+static std::mutex            _fxWorkerMutex;
+static std::condition_variable _fxWorkerWake;
+static unsigned              _fxWorkerGen = 0;
+#endif
+
+// effects relying on state outside their segment or on global semaphores must be rendered by loop() after all other segments
+// each effect opts in with setParallelSafe() (built-in effects in setupEffectData(), usermod effects are not parallel by default)
+bool WS2812FX::isParallelSafe(const Segment &seg) const {
+  const Segment *segO = seg.getOldSegment(); // old effect is rendered by the same worker
+  if (segO && !isTransitionSnapshot() && !isParallelSafe(*segO)) return false;
+  if (usesRandom16(seg.mode)) return false;  // FastLED's random8()/random16() share a single global seed
+  return seg.mode < _mode.size() && (_parallelSafe[seg.mode >> 5] & (1U << (seg.mode & 31)));
+}
+
+void WS2812FX::renderQueue() {
+  _renderQueue.drain([this](uint8_t i) { if (!_suspend) renderSegment(_segments[i], _renderQueueNow); });
+}
+
+void WS2812FX::fxWorker(void *) {
+#ifdef ARDUINO_ARCH_ESP32
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // wait for service() to fill render queue
+    strip.renderQueue();
+  }
+#else
+  fxWorkerIndex = 1;
+  unsigned gen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(_fxWorkerMutex);
+      _fxWorkerWake.wait(lock, [&gen]{ return gen != _fxWorkerGen; });
+      gen = _fxWorkerGen;
+    }
+    strip.renderQueue();
+  }
+#endif
+}
+
+bool WS2812FX::startFXWorker() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (fxWorkerTask) return true;
+  // pin to the core not running loop(), stack size is same as loop() task as the worker runs the same effect functions
+  xTaskCreatePinnedToCore(fxWorker, "FXworker", 8192, nullptr, 1, &fxWorkerTask, xPortGetCoreID() ? 0 : 1);
+  return fxWorkerTask != nullptr;
+#else
+  if (!_fxWorkerThread) _fxWorkerThread = new(std::nothrow) std::thread(fxWorker, nullptr);
+  return _fxWorkerThread != nullptr;
+#endif
+}
+#endif
+
 void WS2812FX::service() {
   unsigned long nowUp = millis(); // Be aware, millis() rolls over every 49 days
   now = nowUp + timebase;
   unsigned long elapsed = nowUp - _lastServiceShow;
+  BusManager::showPending();                            // send previous frame if buses were still busy when it was shown
   if (_suspend || elapsed <= MIN_FRAME_DELAY) return;   // keep wifi alive - no matter if triggered or unlimited
-  if (!_triggered && (_targetFps != FPS_UNLIMITED)) {   // unlimited mode = no frametime
+  if (_frameSyncPeriod) {                               // frame synced: leader's frame time replaces our own
+    if (!_triggered && elapsed < _frameSyncPeriod) return;
+  } else if (!_triggered && (_targetFps != FPS_UNLIMITED)) { // unlimited mode = no frametime
     if (elapsed < _frametime) return;                   // too early for service
   }
 
   bool doShow = false;
 
   _isServicing = true;
-  _segment_index = 0;
+
+#if WLED_FX_WORKERS > 1
+  uint8_t  deferred[MAX_NUM_SEGMENTS];  // due segments that need to be rendered by loop()
+  unsigned queueLen = 0, deferredLen = 0;
+  if (parallelFX && !startFXWorker()) parallelFX = false; // fall back to serial rendering
+#endif
 
   for (Segment &seg : _segments) {
     if (_suspend) break; // immediately stop processing segments if suspend requested during service()
@@ -1284,37 +1535,37 @@ void WS2812FX::service() {
     if (nowUp > seg.next_time || _triggered || (doShow && seg.mode == FX_MODE_STATIC))
     {
       doShow = true;
-      unsigned frameDelay = FRAMETIME;
-
-      if (!seg.freeze) { //only run effect function if not frozen
-        // Effect blending
-        uint16_t prog = seg.progress();
-        seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
-        _currentSegment = &seg;             // set current segment for effect functions (SEGMENT & SEGENV)
-        // workaround for on/off transition to respect blending style
-        frameDelay = (*_mode[seg.mode])();  // run new/current mode (needed for bri workaround)
-        seg.call++;
-        // if segment is in transition and no old segment exists we don't need to run the old mode
-        // (blendSegments() takes care of On/Off transitions and clipping)
-        Segment *segO = seg.getOldSegment();
-        if (segO && segO->isActive() && (seg.mode != segO->mode || blendingStyle != BLEND_STYLE_FADE ||
-            (segO->name != seg.name && segO->name && seg.name && strncmp(segO->name, seg.name, WLED_MAX_SEGNAME_LEN) != 0))) {
-          Segment::modeBlend(true);         // set semaphore for beginDraw() to blend colors and palette
-          segO->beginDraw(prog);            // set up palette & colors (also sets draw dimensions), parent segment has transition progress
-          _currentSegment = segO;           // set current segment
-          // workaround for on/off transition to respect blending style
-          frameDelay = min(frameDelay, (unsigned)(*_mode[segO->mode])());  // run old mode (needed for bri workaround; semaphore!!)
-          segO->call++;                     // increment old mode run counter
-          Segment::modeBlend(false);        // unset semaphore
-        }
-        if (seg.isInTransition() && frameDelay > FRAMETIME) frameDelay = FRAMETIME; // force faster updates during transition
+#if WLED_FX_WORKERS > 1
+      if (parallelFX) {
+        // defer rendering until all due segments are known
+        if (isParallelSafe(seg)) _renderQueue.entries()[queueLen++] = &seg - _segments.data();
+        else                     deferred[deferredLen++]   = &seg - _segments.data();
+        continue;
       }
-
-      seg.next_time = nowUp + frameDelay;
+#endif
+      renderSegment(seg, nowUp);
     }
-    _segment_index++;
   }
 
+#if WLED_FX_WORKERS > 1
+  if (queueLen > 1) {
+    // publish new queue (new generation) and let FX worker help drain it
+    _renderQueueNow = nowUp;
+    _renderQueue.publish(queueLen);
+    #ifdef ARDUINO_ARCH_ESP32
+    xTaskNotifyGive(fxWorkerTask);
+    #else
+    { std::lock_guard<std::mutex> lock(_fxWorkerMutex); _fxWorkerGen++; }
+    _fxWorkerWake.notify_one();
+    #endif
+    renderQueue();
+    while (!_renderQueue.isDone()) yield(); // wait for FX worker to finish its last segment
+  } else if (queueLen) {
+    renderSegment(_segments[_renderQueue.entries()[0]], nowUp); // no need to involve FX worker
+  }
+  for (unsigned i = 0; i < deferredLen && !_suspend; i++) renderSegment(_segments[deferred[i]], nowUp);
+#endif
+
   #ifdef WLED_DEBUG
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow effects %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
   #endif
@@ -1322,6 +1573,13 @@ void WS2812FX::service() {
     yield();
     Segment::handleRandomPalette(); // slowly transition random palette; move it into for loop when each segment has individual random palette
     _lastServiceShow = nowUp; // update timestamp, for precise FPS control
+    if (_frameSyncPeriod) {
+      // move frame start back onto the shared grid so that the next deadline lands on the same grid point as the leader's
+      int32_t phase = int32_t(now - _frameSyncEpoch) % _frameSyncPeriod;
+      if (phase < 0) phase += _frameSyncPeriod;
+      _lastServiceShow -= phase;
+      _frameSyncPhase = phase;
+    }
     show();
   }
   #ifdef WLED_DEBUG
@@ -1376,7 +1634,8 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
   const int     width      = topSegment.width();
   const int     height     = topSegment.height();
   const auto    XY         = [](int x, int y){ return x + y*Segment::maxWidth; };
-  const size_t  matrixSize = Segment::maxWidth * Segment::maxHeight;
+  const size_t  matrixSize = Segment::maxWidth * Segment::maxHeight; // whole canvas (segment coordinates)
+  const int     pixelsLen  = getLengthTotal();      // local frame buffer (tile and trailing strip)
   const size_t  startIndx  = XY(topSegment.start, topSegment.startY);
   const size_t  stopIndx   = startIndx + length;
   const unsigned progress  = topSegment.progress();
@@ -1450,27 +1709,24 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
     const int oCols = segO ? segO->virtualWidth() : nCols;
     const int oRows = segO ? segO->virtualHeight() : nRows;
 
+    const auto setCanvasPixel = [&](int x, int y, uint32_t c, uint8_t o) {
+      const int indx = getCanvasIndex(x, y); // address in local frame buffer
+      if (indx < 0) return;                  // pixel is rendered by another controller (canvas tile)
+      _pixels[indx] = color_blend(_pixels[indx], blend(c, _pixels[indx]), o);
+      if (_pixelCCT) _pixelCCT[indx] = cct;
+    };
+
     const auto setMirroredPixel = [&](int x, int y, uint32_t c, uint8_t o) {
       const int baseX = topSegment.start  + x;
       const int baseY = topSegment.startY + y;
-      size_t indx = XY(baseX, baseY); // absolute address on strip
-      _pixels[indx] = color_blend(_pixels[indx], blend(c, _pixels[indx]), o);
-      if (_pixelCCT) _pixelCCT[indx] = cct;
+      setCanvasPixel(baseX, baseY, c, o);
       // Apply mirroring
       if (topSegment.mirror || topSegment.mirror_y) {
         const int mirrorX = topSegment.start  + width  - x - 1;
         const int mirrorY = topSegment.startY + height - y - 1;
-        const size_t idxMX = XY(topSegment.transpose ? baseX : mirrorX, topSegment.transpose ? mirrorY : baseY);
-        const size_t idxMY = XY(topSegment.transpose ? mirrorX : baseX, topSegment.transpose ? baseY : mirrorY);
-        const size_t idxMM = XY(mirrorX, mirrorY);
-        if (topSegment.mirror)                        _pixels[idxMX] = color_blend(_pixels[idxMX], blend(c, _pixels[idxMX]), o);
-        if (topSegment.mirror_y)                      _pixels[idxMY] = color_blend(_pixels[idxMY], blend(c, _pixels[idxMY]), o);
-        if (topSegment.mirror && topSegment.mirror_y) _pixels[idxMM] = color_blend(_pixels[idxMM], blend(c, _pixels[idxMM]), o);
-        if (_pixelCCT) {
-          if (topSegment.mirror)                        _pixelCCT[idxMX] = cct;
-          if (topSegment.mirror_y)                      _pixelCCT[idxMY] = cct;
-          if (topSegment.mirror && topSegment.mirror_y) _pixelCCT[idxMM] = cct;
-        }
+        if (topSegment.mirror)                        setCanvasPixel(topSegment.transpose ? baseX : mirrorX, topSegment.transpose ? mirrorY : baseY, c, o);
+        if (topSegment.mirror_y)                      setCanvasPixel(topSegment.transpose ? mirrorX : baseX, topSegment.transpose ? baseY : mirrorY, c, o);
+        if (topSegment.mirror && topSegment.mirror_y) setCanvasPixel(mirrorX, mirrorY, c, o);
       }
     };
 
@@ -1535,6 +1791,21 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
     const int nLen = topSegment.virtualLength();
     const Segment *segO = topSegment.getOldSegment();
     const int oLen = segO ? segO->virtualLength() : nLen;
+    const int pixelsOffset = getTrailingOffset(); // trailing strip of a canvas tile follows the tile in _pixels (0 otherwise)
+    if (int(topSegment.stop) + pixelsOffset > pixelsLen) { blendingStyle = orgBS; Segment::setClippingRect(0, 0); return; } // never write past _pixels
+
+    // additive blending of a plain segment (no transition, grouping, mirroring or reversal): add whole span at once
+    if (func == _add && opacity == 255 && !segO && !topSegment.isInTransition() && (bri == briT || blendingStyle == BLEND_STYLE_FADE)
+        && topSegment.groupLength() == 1 && !topSegment.mirror && !topSegment.reverse && nLen == length) {
+      const unsigned first = length - topSegment.offset % length; // segment pixel that lands on topSegment.start (offset/phase)
+      uint32_t *dst = _pixels + topSegment.start + pixelsOffset;
+      color_add_span(dst + length - first, topSegment.pixels, first);
+      color_add_span(dst, topSegment.pixels + first, length - first);
+      if (_pixelCCT) memset(_pixelCCT + topSegment.start + pixelsOffset, cct, length);
+      blendingStyle = orgBS;
+      Segment::setClippingRect(0, 0);
+      return;
+    }
 
     const auto setMirroredPixel = [&](int i, uint32_t c, uint8_t o) {
       int indx = topSegment.start + i;
@@ -1543,11 +1814,13 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         unsigned indxM = topSegment.stop - i - 1;
         indxM += topSegment.offset; // offset/phase
         if (indxM >= topSegment.stop) indxM -= length; // wrap
+        indxM += pixelsOffset;
         _pixels[indxM] = color_blend(_pixels[indxM], blend(c, _pixels[indxM]), o);
         if (_pixelCCT) _pixelCCT[indxM] = cct;
       }
       indx += topSegment.offset; // offset/phase
       if (indx >= topSegment.stop) indx -= length; // wrap
+      indx += pixelsOffset;
       _pixels[indx] = color_blend(_pixels[indx], blend(c, _pixels[indx]), o);
       if (_pixelCCT) _pixelCCT[indx] = cct;
     };
@@ -1615,7 +1888,7 @@ void WS2812FX::show() {
     // clear frame buffer
     for (size_t i = 0; i < totalLen; i++) _pixels[i] = BLACK; // memset(_pixels, 0, sizeof(uint32_t) * getLengthTotal());
     // blend all segments into (cleared) buffer
-    for (Segment &seg : _segments) if (seg.isActive() && (seg.on || seg.isInTransition())) {
+    for (Segment &seg : _segments) if (seg.isActive() && (seg.on || seg.isInTransition()) && isOnTile(seg)) {
       blendSegment(seg);              // blend segment's buffer into frame buffer
     }
   }
@@ -1624,11 +1897,31 @@ void WS2812FX::show() {
   show_callback callback = _callback;
   if (callback) callback(); // will call setPixelColor or setRealtimePixelColor
 
-  // paint actual pixels
+  const bool applyGamma = !(realtimeMode && arlsDisableGammaCorrection);
+  const bool useLedmap  = customMappingSize > 0 && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps);
   int oldCCT = Bus::getCCT(); // store original CCT value (since it is global)
   // when cctFromRgb is true we implicitly calculate WW and CW from RGB values (cct==-1)
   if (cctFromRgb) BusManager::setSegmentCCT(-1);
-  for (size_t i = 0; i < totalLen; i++) {
+
+  // estimate current of composited frame and calculate brightness limit before painting, so the limit applies to the same frame
+  BusManager::estimateCurrent(_pixels, totalLen, applyGamma, useLedmap ? customMappingTable : nullptr, customMappingSize, _pixelCCT, correctWB);
+  BusManager::applyABL(); // updates _gMilliAmpsUsed
+  BusManager::applyBrightness(); // brightness limit is applied together with brightness when pixels are set
+
+  // paint actual pixels
+  const bool highDepth = BusManager::hasHighDepthOutput(); // 16 bit buses or temporal dithering: gamma and brightness are applied by buses
+  if (!highDepth && !_pixelCCT && !useLedmap) {
+    // common case: consecutive pixels go to consecutive bus pixels, paint in runs (bus type and color order are resolved once per run)
+    uint32_t buf[64];
+    for (size_t i = 0; i < totalLen; i += sizeof(buf)/sizeof(buf[0])) {
+      const size_t n = std::min(totalLen - i, sizeof(buf)/sizeof(buf[0]));
+      for (size_t j = 0; j < n; j++) {
+        uint32_t c = _pixels[i+j];
+        buf[j] = (c > 0 && applyGamma) ? gamma32(c) : c;
+      }
+      BusManager::setPixels(i, buf, n);
+    }
+  } else for (size_t i = 0; i < totalLen; i++) {
     // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
     // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
     if (_pixelCCT) { // cctFromRgb already exluded at allocation
@@ -1636,7 +1929,11 @@ void WS2812FX::show() {
     }
 
     uint32_t c = _pixels[i]; // need a copy, do not modify _pixels directly (no byte access allowed on ESP32)
-    if(c > 0 && !(realtimeMode && arlsDisableGammaCorrection))
+    if (highDepth) {
+      BusManager::setPixelColor16(getMappedPixelIndex(i), c, applyGamma);
+      continue;
+    }
+    if (c > 0 && applyGamma)
         c = gamma32(c); // apply gamma correction if enabled note: applying gamma after brightness has too much color loss
     BusManager::setPixelColor(getMappedPixelIndex(i), c);
   }
@@ -1766,7 +2063,7 @@ uint8_t WS2812FX::getActiveSegmentsNum() const {
 }
 
 uint16_t WS2812FX::getLengthTotal() const {
-  unsigned len = Segment::maxWidth * Segment::maxHeight; // will be _length for 1D (see finalizeInit()) but should cover whole matrix for 2D
+  unsigned len = getMatrixWidth() * getMatrixHeight(); // will be _length for 1D (see finalizeInit()) but should cover whole (local) matrix for 2D
   if (isMatrix && _length > len) len = _length; // for 2D with trailing strip
   return len;
 }
@@ -1851,8 +2148,13 @@ void WS2812FX::makeAutoSegments(bool forceReset) {
       segStops[s]  = segStarts[s] + bus->getLength();
 
       #ifndef WLED_DISABLE_2D
-      if (isMatrix && segStops[s] <= Segment::maxWidth*Segment::maxHeight) continue; // ignore buses comprising matrix
-      if (isMatrix && segStarts[s] < Segment::maxWidth*Segment::maxHeight) segStarts[s] = Segment::maxWidth*Segment::maxHeight;
+      if (isMatrix) {
+        const unsigned matrixSize = getMatrixWidth() * getMatrixHeight(); // bus indices cover local matrix (tile) only
+        if (segStops[s] <= matrixSize) continue; // ignore buses comprising matrix
+        if (segStarts[s] < matrixSize) segStarts[s] = matrixSize;
+        segStarts[s] -= getTrailingOffset(); // trailing strip follows the canvas in segment coordinates
+        segStops[s]  -= getTrailingOffset();
+      }
       #endif
 
       //check for overlap with previous segments
@@ -1907,8 +2209,9 @@ void WS2812FX::fixInvalidSegments() {
     #ifndef WLED_DISABLE_2D
       if (_segments[i].start >= Segment::maxWidth * Segment::maxHeight) {
         // 1D segment at the end of matrix
-        if (_segments[i].start >= _length || _segments[i].startY > 0 || _segments[i].stopY > 1) { _segments.erase(_segments.begin()+i); continue; }
-        if (_segments[i].stop  >  _length) _segments[i].stop = _length;
+        const unsigned canvasLen = getCanvasLengthTotal(); // trailing strip follows the canvas
+        if (_segments[i].start >= canvasLen || _segments[i].startY > 0 || _segments[i].stopY > 1) { _segments.erase(_segments.begin()+i); continue; }
+        if (_segments[i].stop  >  canvasLen) _segments[i].stop = canvasLen;
         continue;
       }
       if (_segments[i].start >= Segment::maxWidth || _segments[i].startY >= Segment::maxHeight) { _segments.erase(_segments.begin()+i); continue; }
@@ -1954,9 +2257,10 @@ void WS2812FX::printSize() {
   size_t size = 0;
   for (const Segment &seg : _segments) size += seg.getSize();
   DEBUG_PRINTF_P(PSTR("Segments: %d -> %u/%dB\n"), _segments.size(), size, Segment::getUsedSegmentData());
-  for (const Segment &seg : _segments) DEBUG_PRINTF_P(PSTR("  Seg: %d,%d [A=%d, 2D=%d, RGB=%d, W=%d, CCT=%d]\n"), seg.width(), seg.height(), seg.isActive(), seg.is2D(), seg.hasRGB(), seg.hasWhite(), seg.isCCT());
+  for (const Segment &seg : _segments) DEBUG_PRINTF_P(PSTR("  Seg: %d,%d [A=%d, 2D=%d, RGB=%d, W=%d, CCT=%d, 1D2D map=%uB]\n"), seg.width(), seg.height(), seg.isActive(), seg.is2D(), seg.hasRGB(), seg.hasWhite(), seg.isCCT(), (unsigned)seg.getMappingTableSize());
   DEBUG_PRINTF_P(PSTR("Modes: %d*%d=%uB\n"), sizeof(mode_ptr), _mode.size(), (_mode.capacity()*sizeof(mode_ptr)));
   DEBUG_PRINTF_P(PSTR("Data: %d*%d=%uB\n"), sizeof(const char *), _modeData.size(), (_modeData.capacity()*sizeof(const char *)));
+  DEBUG_PRINTF_P(PSTR("Info: %d*%d=%uB\n"), sizeof(mode_info_t), _modeInfo.size(), (_modeInfo.capacity()*sizeof(mode_info_t)));
   DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB\n"), sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
 }
 #endif
@@ -1999,6 +2303,7 @@ bool WS2812FX::deserializeMap(unsigned n) {
     Segment::maxWidth  = min(max(root[F("width")].as<int>(), 1), 255);
     Segment::maxHeight = min(max(root[F("height")].as<int>(), 1), 255);
     isMatrix = true;
+    _tileWidth = _tileHeight = 0; // ledmap defines the whole matrix, no canvas tile
     DEBUG_PRINTF_P(PSTR("LED map width=%d, height=%d\n"), Segment::maxWidth, Segment::maxHeight);
   }
 
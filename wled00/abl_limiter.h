@@ -0,0 +1,105 @@
+#pragma once
+#ifndef ABLLimiter_h
+#define ABLLimiter_h
+/*
+ * Automatic brightness limiter for one current budget (a bus or the PSU) and current estimate, see BusManager::applyABL()
+ * Estimates the current of a frame from its colors and returns the brightness that keeps it within the peak budget,
+ * optionally with smooth attack/release and a sustained budget for the rolling average.
+ */
+
+#include <stdint.h>
+
+#ifndef ABL_ATTACK_MS
+  #define ABL_ATTACK_MS    100    // smooth limiter: time to dim down to sustained budget
+#endif
+#ifndef ABL_RELEASE_MS
+  #define ABL_RELEASE_MS   1500   // smooth limiter: time to recover brightness
+#endif
+#ifndef ABL_AVERAGE_MS
+  #define ABL_AVERAGE_MS   30000  // time constant of rolling current average (PSU/thermal model)
+#endif
+#ifndef ABL_KNEE
+  #define ABL_KNEE         8      // sustained budget: frame budget starts dropping at (1 - 1/ABL_KNEE) of sustained current
+#endif
+
+// color value of one pixel for current estimate, c is color at full brightness (after gamma, auto white and white balance)
+// with WS2815 power model (LED current set to 255, see WLED issue #549) white is ignored and max of RGB is used
+inline uint32_t ablColorValue(uint32_t c, bool ws2815) {
+  if (ws2815) {
+    const uint8_t r = c >> 16, g = c >> 8, b = c;
+    return (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
+  }
+  const uint32_t lanes = (c & 0x00FF00FF) + ((c >> 8) & 0x00FF00FF); // W+G and R+B in two 16 bit lanes
+  return (lanes & 0xFFFF) + (lanes >> 16);
+}
+
+// estimated current (mA) of length LEDs from summed color values (see ablColorValue()) at brightness bri
+// each LED uses about 1mA in standby (WS2812: ~0.7mA, WS2815: ~2mA)
+inline uint32_t ablEstimateCurrent(uint64_t colorSum, uint8_t milliAmpsPerLed, uint8_t bri, bool hasWhite, uint32_t length) {
+  if (milliAmpsPerLed == 255) { // WS2815 power model
+    colorSum *= 3;       // sum is sum of max value for each color, need to multiply by three to account for clrUnitsPerChannel being 3*255
+    milliAmpsPerLed = 12; // from testing an actual strip
+  }
+  // colorSum has all the values of color channels summed, max would be length*(3*255 + (255 if hasWhite)): convert to milliAmps
+  const uint32_t clrUnitsPerChannel = hasWhite ? 4*255 : 3*255;
+  return (colorSum * milliAmpsPerLed * bri) / (clrUnitsPerChannel * 255) + length;
+}
+
+// Peak budget is enforced on every frame. With smoothing, brightness recovers slowly (no pumping with strobing effects).
+// With a sustained budget set, the rolling average current is kept below it while short peaks may still reach peak budget.
+// The frame budget follows the average continuously: it is the peak budget up to the knee and drops linearly to the
+// sustained budget when the average reaches it (the average current settles there instead of toggling between budgets).
+class ABLLimiter {
+  public:
+    // returns brightness to stay within budget (all currents in mA), dt is time since previous frame
+    // standby current cannot be dimmed, if peak budget is below it brightness is set to minimum
+    // sustainedPct is sustained budget in % of peak budget (100 = not used)
+    uint8_t limit(uint32_t demand, uint32_t peak, uint32_t standby, unsigned dt, bool smooth, uint8_t sustainedPct) {
+      if (peak <= standby) {
+        _gain = 0;
+        _current = standby;
+        _avg = standby << 8;
+        return 1;
+      }
+      const uint32_t dynamic = demand > standby ? demand - standby : 0; // current that can be dimmed
+      const uint32_t budget  = frameBudget(peak, standby, sustainedPct);
+      const uint32_t hardGain = dynamic > peak - standby   ? ((uint64_t)(peak - standby)   << 16) / dynamic : 0xFFFF;
+      const uint32_t target   = dynamic > budget - standby ? ((uint64_t)(budget - standby) << 16) / dynamic : 0xFFFF;
+      if (!smooth) _gain = target;
+      else {
+        // attack (dimming) and release (recovery) are exponential
+        const int32_t  diff = (int32_t)target - _gain;
+        const unsigned time = diff < 0 ? ABL_ATTACK_MS : ABL_RELEASE_MS;
+        _gain = (dt >= time) ? target : _gain + diff * (int32_t)dt / (int32_t)time;
+      }
+      if (_gain > hardGain) _gain = hardGain; // peak budget is never exceeded, no matter the smoothing
+      _current = standby + (((uint64_t)dynamic * _gain) >> 16);
+      // rolling average of limited current (PSU/thermal model)
+      if (dt >= ABL_AVERAGE_MS) _avg = _current << 8;
+      else _avg += ((int64_t)(_current << 8) - (int64_t)_avg) * dt / ABL_AVERAGE_MS;
+      return _gain >= 0xFF00 ? 255 : (_gain >> 8) + 1; // +1 to avoid 0 brightness
+    }
+
+    // budget (mA) of next frame, depends on rolling average if sustained budget is used
+    uint32_t frameBudget(uint32_t peak, uint32_t standby, uint8_t sustainedPct) const {
+      if (sustainedPct >= 100) return peak;
+      uint32_t sustained = peak * sustainedPct / 100;
+      if (sustained <= standby) sustained = standby + 1;
+      const uint32_t knee = sustained - sustained / ABL_KNEE;
+      const uint32_t avg  = getAverage();
+      if (avg <= knee) return peak;
+      if (avg >= sustained) return sustained;
+      return peak - (uint64_t)(peak - sustained) * (avg - knee) / (sustained - knee);
+    }
+
+    inline uint32_t getCurrent() const { return _current; }   // limited current of last frame (mA)
+    inline uint32_t getAverage() const { return _avg >> 8; }  // rolling average of limited current (mA)
+    inline void     reset()            { _gain = 0xFFFF; _avg = 0; _current = 0; }
+
+  private:
+    uint16_t _gain = 0xFFFF; // applied limit (16 bit fraction)
+    uint32_t _avg = 0;       // rolling average current (mA * 256)
+    uint32_t _current = 0;
+};
+
+#endif
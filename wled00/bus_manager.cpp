@@ -111,12 +111,7 @@ bool ColorOrderMap::add(uint16_t start, uint16_t len, uint8_t colorOrder) {
 }
 
 uint8_t IRAM_ATTR ColorOrderMap::getPixelColorOrder(uint16_t pix, uint8_t defaultColorOrder) const {
-  // upper nibble contains W swap information
-  // when ColorOrderMap's upper nibble contains value >0 then swap information is used from it, otherwise global swap is used
-  for (const auto& map : _mappings) {
-    if (pix >= map.start && pix < (map.start + map.len)) return map.colorOrder | ((map.colorOrder >> 4) ? 0 : (defaultColorOrder & 0xF0));
-  }
-  return defaultColorOrder;
+  return colorOrderAt(_mappings, pix, defaultColorOrder);
 }
 
 
@@ -157,6 +152,24 @@ uint32_t Bus::autoWhiteCalc(uint32_t c) const {
   return RGBW32(r, g, b, w);
 }
 
+// 16 bit version of autoWhiteCalc(), rgbw is {R,G,B,W}
+void Bus::autoWhiteCalc16(uint16_t *rgbw) const {
+  unsigned aWM = _autoWhiteMode;
+  if (_gAWM < AW_GLOBAL_DISABLED) aWM = _gAWM;
+  if (aWM == RGBW_MODE_MANUAL_ONLY) return;
+  if (rgbw[3] > 0 && aWM == RGBW_MODE_DUAL) return;
+  const uint16_t r = rgbw[0], g = rgbw[1], b = rgbw[2];
+  if (aWM == RGBW_MODE_MAX) { rgbw[3] = r > g ? (r > b ? r : b) : (g > b ? g : b); return; } // brightest RGB channel
+  const uint16_t w = r < g ? (r < b ? r : b) : (g < b ? g : b);
+  if (aWM == RGBW_MODE_AUTO_ACCURATE) { rgbw[0] -= w; rgbw[1] -= w; rgbw[2] -= w; } //subtract w in ACCURATE mode
+  rgbw[3] = w;
+}
+
+// buses without high bit depth support get 8 bit gamma corrected color
+void Bus::setPixelColor16(unsigned pix, uint32_t c, bool gamma) {
+  setPixelColor(pix, gamma ? gamma32(c) : c);
+}
+
 
 BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
 : Bus(bc.type, bc.start, bc.autoWhite, bc.count, bc.reversed, (bc.refreshReq || bc.type == TYPE_TM1814))
@@ -164,12 +177,16 @@ BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
 , _colorOrder(bc.colorOrder)
 , _milliAmpsPerLed(bc.milliAmpsPerLed)
 , _milliAmpsMax(bc.milliAmpsMax)
+, _milliAmpsLimit(0)
+, _ablBri(255)
+, _colorSum(0)
+, _milliAmpsTotal(0)
+, _milliAmpsDemand(0)
 {
   DEBUGBUS_PRINTLN(F("Bus: Creating digital bus."));
   if (!isDigital(bc.type) || !bc.count) { DEBUGBUS_PRINTLN(F("Not digial or empty bus!")); return; }
   if (!PinManager::allocatePin(bc.pins[0], true, PinOwner::BusDigital)) { DEBUGBUS_PRINTLN(F("Pin 0 allocated!")); return; }
   _frequencykHz = 0U;
-  _colorSum = 0;
   _pins[0] = bc.pins[0];
   if (is2Pin(bc.type)) {
     if (!PinManager::allocatePin(bc.pins[1], true, PinOwner::BusDigital)) {
@@ -189,6 +206,7 @@ BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
   if (bc.type == TYPE_WS2812_1CH_X3) lenToCreate = NUM_ICS_WS2812_1CH_3X(bc.count); // only needs a third of "RGB" LEDs for NeoPixelBus
   _busPtr = PolyBus::create(_iType, _pins, lenToCreate + _skip, nr);
   _valid = (_busPtr != nullptr) && bc.count > 0;
+  if (_valid) updateColorOrderSpans();
   // fix for wled#4759
   if (_valid) for (unsigned i = 0; i < _skip; i++) {
     PolyBus::setPixelColor(_busPtr, _iType, i, 0, COL_ORDER_GRB); // set sacrificial pixels to black (CO does not matter here)
@@ -214,62 +232,54 @@ BusDigital::BusDigital(const BusConfig &bc, uint8_t nr)
 
 // note on ABL implementation:
 // ABL is set up in finalizeInit()
-// scaled color channels are summed in BusDigital::setPixelColor()
-// the used current is estimated and limited in BusManager::show()
+// color channels of the composited frame are summed in BusManager::estimateCurrent() after gamma, auto white and white balance
+// the used current is estimated and limited in BusManager::applyABL() before any pixel is set (see WS2812FX::show())
+// the resulting limit is applied together with bus brightness when pixels are set, so each frame is limited by its own current
+// per bus limits and a global (PSU) limit can be used at the same time
+// each limit has its own ABLLimiter with optional smoothing and sustained budget
 // if limit is set too low, brightness is limited to 1 to at least show some light
 // to disable brightness limiter for a bus, set LED current to 0
 
-void BusDigital::estimateCurrent() {
-  uint32_t actualMilliampsPerLed = _milliAmpsPerLed;
-  if (_milliAmpsPerLed == 255) {
-    // use wacky WS2815 power model, see WLED issue #549
-    _colorSum *= 3; // sum is sum of max value for each color, need to multiply by three to account for clrUnitsPerChannel being 3*255
-    actualMilliampsPerLed = 12; // from testing an actual strip
+// colors are processed the same way as in setPixelColor() but summed at full brightness, bus brightness is accounted for in estimateCurrent()
+void BusDigital::addColorSum(const uint32_t *pixels, size_t count, bool gamma) {
+  if (!_valid || _milliAmpsPerLed == 0) return; // current not estimated for this bus
+  const bool aw = hasWhite();
+  const bool wb = Bus::_cct >= 1900;
+  const bool ws2815 = _milliAmpsPerLed == 255;
+  uint32_t sum = 0;
+  for (size_t i = 0; i < count; i++) {
+    uint32_t c = pixels[i];
+    if (c > 0 && gamma) c = gamma32(c);
+    if (aw) c = autoWhiteCalc(c);
+    if (wb) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
+    sum += ablColorValue(c, ws2815);
   }
-  // _colorSum has all the values of color channels summed, max would be getLength()*(3*255 + (255 if hasWhite()): convert to milliAmps
-  uint32_t clrUnitsPerChannel = hasWhite() ? 4*255 : 3*255;
-  _milliAmpsTotal = ((uint64_t)_colorSum * actualMilliampsPerLed) / clrUnitsPerChannel + getLength(); // add 1mA standby current per LED to total (WS2812: ~0.7mA, WS2815: ~2mA)
+  _colorSum += sum;
 }
 
-void BusDigital::applyBriLimit(uint8_t newBri) {
-  // a newBri of 0 means calculate per-bus brightness limit
-  _NPBbri = 255; // reset, intermediate value is set below, final value is calculated in bus::show()
-  if (newBri == 0) {
-    if (_milliAmpsLimit == 0 || _milliAmpsTotal == 0) return; // ABL not used for this bus
-    newBri = 255;
-
-    if (_milliAmpsLimit > getLength()) { // each LED uses about 1mA in standby
-      if (_milliAmpsTotal > _milliAmpsLimit) {
-        // scale brightness down to stay in current limit
-        newBri = ((uint32_t)_milliAmpsLimit * 255) / _milliAmpsTotal + 1; // +1 to avoid 0 brightness
-        _milliAmpsTotal = _milliAmpsLimit;
-      }
-    } else {
-      newBri = 1; // limit too low, set brightness to 1, this will dim down all colors to minimum since we use video scaling
-      _milliAmpsTotal = getLength(); // estimate bus current as minimum
-    }
-  }
+void BusDigital::estimateCurrent() {
+  _ablBri = 255; // reset limit, will be set in applyBriLimit()
+  _milliAmpsTotal = ablEstimateCurrent(_colorSum, _milliAmpsPerLed, _bri, hasWhite(), getLength());
+  _milliAmpsDemand = _milliAmpsTotal;
+  _colorSum = 0; // reset for next frame
+}
 
+void BusDigital::applyCurrentLimit(unsigned dt) {
+  if (_milliAmpsLimit == 0 || _milliAmpsTotal == 0) return; // ABL not used for this bus
+  _ablBri = _limiter.limit(_milliAmpsTotal, _milliAmpsLimit, getLength(), dt, BusManager::_ablSmooth, BusManager::_ablSustained); // each LED uses about 1mA in standby
+  _milliAmpsTotal = _limiter.getCurrent();
+}
+
+void BusDigital::applyBriLimit(uint8_t newBri) {
+  // global limit on top of (possible) per bus limit
   if (newBri < 255) {
-    _NPBbri = newBri; // store value so it can be updated in show() (must be updated even if ABL is not used)
-    uint8_t cctWW = 0, cctCW = 0;
-    unsigned hwLen = _len;
-    if (_type == TYPE_WS2812_1CH_X3) hwLen = NUM_ICS_WS2812_1CH_3X(_len); // only needs a third of "RGB" LEDs for NeoPixelBus
-    for (unsigned i = 0; i < hwLen; i++) {
-      uint8_t co = _colorOrderMap.getPixelColorOrder(i+_start, _colorOrder); // need to revert color order for correct color scaling and CCT calc in case white is swapped
-      uint32_t c = PolyBus::getPixelColor(_busPtr, _iType, i, co);
-      c = color_fade(c, newBri, true); // apply additional dimming  note: using inline version is a bit faster but overhead of getPixelColor() dominates the speed impact by far
-      if (hasCCT()) Bus::calculateCCT(c, cctWW, cctCW);
-      PolyBus::setPixelColor(_busPtr, _iType, i, c, co, (cctCW<<8) | cctWW); // repaint all pixels with new brightness
-    }
+    _ablBri = std::max(((unsigned)_ablBri * newBri) / 255, 1U);
+    _milliAmpsTotal = ((_milliAmpsTotal - getLength()) * newBri) / 255 + getLength();
   }
-
-  _colorSum = 0; // reset for next frame
 }
 
 void BusDigital::show() {
   if (!_valid) return;
-  _NPBbri = (_NPBbri * _bri) / 255;      // total applied brightness for use in restoreColorLossy (see applyBriLimit())
   PolyBus::show(_busPtr, _iType, _skip); // faster if buffer consistency is not important (no skipped LEDs)
 }
 
@@ -282,7 +292,7 @@ bool BusDigital::canShow() const {
 //TODO only show if no new show due in the next 50ms
 void BusDigital::setStatusPixel(uint32_t c) {
   if (_valid && _skip) {
-    PolyBus::setPixelColor(_busPtr, _iType, 0, c, _colorOrderMap.getPixelColorOrder(_start, _colorOrder));
+    PolyBus::setPixelColor(_busPtr, _iType, 0, c, getPixelColorOrder(0));
     if (canShow()) PolyBus::show(_busPtr, _iType);
   }
 }
@@ -291,21 +301,81 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   if (!_valid) return;
   if (hasWhite()) c = autoWhiteCalc(c);
   if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
-  c = color_fade(c, _bri, true); // apply brightness
-
-  if (BusManager::_useABL) {
-    // if using ABL, sum all color channels to estimate current and limit brightness in show()
-    uint8_t r = R(c), g = G(c), b = B(c);
-    if (_milliAmpsPerLed < 255) { // normal ABL
-      _colorSum += r + g + b + W(c);
-    } else { // wacky WS2815 power model, ignore white channel, use max of RGB (issue #549)
-      _colorSum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b));
+  c = color_fade(c, _NPBbri, true); // apply brightness including ABL limit
+  setRawPixelColor(pix, c);
+}
+
+// high bit depth path: gamma, white balance and brightness are applied with 16 bit precision so low brightness
+// fades do not band; 16 bit buses get all 16 bits, 8 bit buses get temporally dithered values
+void IRAM_ATTR BusDigital::setPixelColor16(unsigned pix, uint32_t c, bool gamma) {
+  if (!_valid) return;
+  if (!is16bit() && !_dither) { setPixelColor(pix, gamma ? gamma32(c) : c); return; } // no extra work for plain 8 bit output
+  uint16_t rgbw[4] = { R(c), G(c), B(c), W(c) };
+  const bool useGamma = gamma && gammaCorrectCol;
+  for (unsigned i = 0; i < 4; i++) rgbw[i] = useGamma ? gamma16(rgbw[i]) : rgbw[i] * 257;
+  if (hasWhite()) autoWhiteCalc16(rgbw);
+  if (Bus::_cct >= 1900) { //color correction from CCT
+    const uint32_t balance = colorBalanceFromKelvin(Bus::_cct, 0x00FFFFFF);
+    rgbw[0] = (rgbw[0] * R(balance)) / 255;
+    rgbw[1] = (rgbw[1] * G(balance)) / 255;
+    rgbw[2] = (rgbw[2] * B(balance)) / 255;
+  }
+  for (unsigned i = 0; i < 4; i++) rgbw[i] = ((uint32_t)rgbw[i] * _NPBbri + 127) / 255; // apply brightness including ABL limit
+
+  if (!is16bit()) {
+    // temporal dithering: lower 8 bits decide how often (in 16 frames) the upper 8 bits are rounded up
+    static const uint8_t ditherPattern[16] = { 0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15 };
+    const unsigned threshold = (ditherPattern[(_ditherFrame + pix * 7) & 0x0F] << 4) | 0x08; // pixel offset avoids flicker in sync
+    uint8_t ch[4];
+    for (unsigned i = 0; i < 4; i++) ch[i] = std::min((rgbw[i] + threshold) >> 8, 255U);
+    setRawPixelColor(pix, RGBW32(ch[0], ch[1], ch[2], ch[3]));
+    return;
+  }
+
+  if (_reversed) pix = _len - pix -1;
+  pix += _skip;
+  const uint8_t co = getPixelColorOrder(pix);
+  uint32_t wwcw = 0;
+  if (hasCCT()) {
+    // split 16 bit white using 8 bit ratios
+    uint8_t cctWW = 0, cctCW = 0;
+    Bus::calculateCCT(RGBW32(rgbw[0] >> 8, rgbw[1] >> 8, rgbw[2] >> 8, 255), cctWW, cctCW);
+    wwcw = ((uint32_t)((rgbw[3] * cctCW) / 255) << 16) | ((rgbw[3] * cctWW) / 255);
+  }
+  PolyBus::setPixelColor16(_busPtr, _iType, pix, rgbw, co, wwcw);
+}
+
+// bulk version of setPixelColor(): bus type and color order are resolved once per run of pixels instead of once per pixel
+void IRAM_ATTR BusDigital::setPixels(unsigned start, const uint32_t *src, size_t count) {
+  if (!_valid || start >= _len) return;
+  if (count > _len - start) count = _len - start;
+  if (hasCCT() || _type == TYPE_WS2812_1CH_X3 || _coSpans.empty()) { Bus::setPixels(start, src, count); return; } // CCT and 3 LEDs per IC need per pixel handling
+  const bool aw = hasWhite();
+  const bool wb = Bus::_cct >= 1900;
+  uint32_t buf[64];
+  while (count) {
+    unsigned pix; // bus index of first pixel
+    size_t n;
+    const uint8_t co = _coSpans[colorOrderSpanRun(_coSpans, start, std::min(count, sizeof(buf)/sizeof(buf[0])), _len, _skip, _reversed, pix, n)].colorOrder;
+    for (size_t i = 0; i < n; i++) {
+      uint32_t c = src[i];
+      if (aw) c = autoWhiteCalc(c);
+      if (wb) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
+      buf[i] = c;
     }
+    color_fade_span(buf, n, _NPBbri, true); // apply brightness including ABL limit
+    PolyBus::setPixels(_busPtr, _iType, pix, _reversed ? -1 : 1, buf, n, co);
+    src   += n;
+    start += n;
+    count -= n;
   }
+}
 
+// sets color (with brightness already applied) handling reversal, skipped LEDs, color order and CCT
+void IRAM_ATTR BusDigital::setRawPixelColor(unsigned pix, uint32_t c) {
   if (_reversed) pix = _len - pix -1;
   pix += _skip;
-  const uint8_t co = _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder);
+  const uint8_t co = getPixelColorOrder(pix);
   if (_type == TYPE_WS2812_1CH_X3) { // map to correct IC, each controls 3 LEDs
     unsigned pOld = pix;
     pix = IC_INDEX_WS2812_1CH_3X(pix);
@@ -331,7 +401,7 @@ uint32_t IRAM_ATTR BusDigital::getPixelColor(unsigned pix) const {
   if (!_valid) return 0;
   if (_reversed) pix = _len - pix -1;
   pix += _skip;
-  const uint8_t co = _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder);
+  const uint8_t co = getPixelColorOrder(pix);
   uint32_t c = restoreColorLossy(PolyBus::getPixelColor(_busPtr, _iType, (_type==TYPE_WS2812_1CH_X3) ? IC_INDEX_WS2812_1CH_3X(pix) : pix, co),_NPBbri);
   if (_type == TYPE_WS2812_1CH_X3) { // map to correct IC, each controls 3 LEDs
     uint8_t r = R(c);
@@ -364,6 +434,16 @@ void BusDigital::setColorOrder(uint8_t colorOrder) {
   // upper nibble contains W swap information
   if ((colorOrder & 0x0F) > 5) return;
   _colorOrder = colorOrder;
+  updateColorOrderSpans();
+}
+
+// color order map is global (by absolute LED index) and may contain overlapping entries; here it is
+// resolved into consecutive spans covering this bus so the output path does not need to scan the map
+// spans are read by setPixels() so this must only be called from loop() (see doUpdateColorOrder)
+void BusDigital::updateColorOrderSpans() {
+  std::vector<ColorOrderMapEntry> spans;
+  _colorOrderMap.getSpans(_start, _len + _skip, _colorOrder, spans); // bus index includes skipped LEDs
+  _coSpans.swap(spans);
 }
 
 // credit @willmmiles & @netmindz https://github.com/wled/WLED/pull/4056
@@ -1235,6 +1315,7 @@ void BusManager::removeAll() {
   //prevents crashes due to deleting busses while in use.
   while (!canAllShow()) yield();
   busses.clear();
+  _deferredShow.clear();
   PolyBus::setParallelI2S1Output(false);
 }
 
@@ -1320,11 +1401,19 @@ void BusManager::off() {
   _gMilliAmpsUsed = 0; // reset, assume no LED idle current if relay is off
 }
 
+static_assert(WLED_MAX_BUSSES <= 64, "DeferredShow needs more bits");
+
+// double buffered output: pixels are set in NeoPixelBus buffer which is separate from the data being transmitted
+// (RMT editing/sending buffers, I2S/UART DMA buffer) so there is no need to wait here for the previous frame
+// to finish; next frame can be rendered and composited meanwhile and the deferred frame is sent by showPending()
 void BusManager::show() {
-  applyABL(); // apply brightness limit, updates _gMilliAmpsUsed
-  for (auto &bus : busses) {
-    bus->show();
-  }
+  BusDigital::nextDitherFrame();
+  _deferredShow.show(busses, micros());
+}
+
+// called from WLED::loop() regardless of strip.service() (realtime and off mode show frames without it)
+void BusManager::showPending() {
+  _deferredShow.flush(busses, micros());
 }
 
 void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
@@ -1334,6 +1423,34 @@ void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
   }
 }
 
+void IRAM_ATTR BusManager::setPixelColor16(unsigned pix, uint32_t c, bool gamma) {
+  for (auto &bus : busses) {
+    if (!bus->containsPixel(pix)) continue;
+    bus->setPixelColor16(pix - bus->getStart(), c, gamma);
+  }
+}
+
+void IRAM_ATTR BusManager::setPixels(unsigned start, const uint32_t *src, size_t count) {
+  const unsigned end = start + count;
+  for (auto &bus : busses) {
+    const unsigned busStart = bus->getStart();
+    const unsigned busEnd   = busStart + bus->getLength();
+    const unsigned first    = std::max(start, busStart);
+    const unsigned last     = std::min(end, busEnd);
+    if (first >= last) continue;
+    bus->setPixels(first - busStart, src + (first - start), last - first);
+  }
+}
+
+void BusManager::updateColorOrderSpans() {
+  for (auto &bus : busses) if (bus->isDigital()) static_cast<BusDigital&>(*bus).updateColorOrderSpans();
+}
+
+bool BusManager::hasHighDepthOutput() {
+  for (const auto &bus : busses) if (bus->isDigital() && (bus->is16bit() || BusDigital::getDither())) return true;
+  return false;
+}
+
 void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
   if (cct > 255) cct = 255;
   if (cct >= 0) {
@@ -1358,6 +1475,8 @@ bool BusManager::canAllShow() {
 
 void BusManager::initializeABL() {
   _useABL = false; // reset
+  _gLimiter.reset();
+  for (auto &bus : busses) if (bus->isDigital()) static_cast<BusDigital&>(*bus).setCurrentLimit(0); // reset per bus limits
   if (_gMilliAmpsMax > 0) {
     // check global brightness limit
     for (auto &bus : busses) {
@@ -1372,6 +1491,8 @@ void BusManager::initializeABL() {
     for (auto &bus : busses) {
       if (bus->isDigital() && bus->getLEDCurrent() > 0 && bus->getMaxCurrent() > 0)
         numABLbuses++; // count ABL enabled buses
+      if (bus->isDigital() && bus->getLEDCurrent() > 0 && _gMilliAmpsPSU > 0)
+        _useABL = true; // shared PSU budget is used even if no per bus limit is set
     }
     if (numABLbuses > 0) {
       _useABL = true; // at least one bus has ABL set
@@ -1384,7 +1505,7 @@ void BusManager::initializeABL() {
           uint32_t busMax    = busd.getMaxCurrent();
           if (busMax > ESPshare)  busMax -= ESPshare;
           if (busMax < busLength) busMax  = busLength; // give each LED 1mA, ABL will dim down to minimum
-          if (busDemand == 0) busMax = 0; // no LED current set, disable ABL for this bus
+          if (busDemand == 0 || busd.getMaxCurrent() == 0) busMax = 0; // no LED current or no limit set, disable per bus ABL for this bus
           busd.setCurrentLimit(busMax);
         }
       }
@@ -1392,47 +1513,73 @@ void BusManager::initializeABL() {
   }
 }
 
+// sums colors of composited frame for current estimate, pixels are mapped to buses and white balanced the same way they will be painted
+void BusManager::estimateCurrent(const uint32_t *pixels, size_t length, bool gamma, const uint16_t *map, size_t mapSize, const uint8_t *cct, bool correctWB) {
+  if (!map && !cct) {
+    // common case: each bus gets a consecutive slice of the frame
+    for (auto &bus : busses) {
+      if (!bus->isDigital() || !bus->isOk() || bus->getStart() >= length) continue;
+      static_cast<BusDigital&>(*bus).addColorSum(pixels + bus->getStart(), std::min<size_t>(bus->getLength(), length - bus->getStart()), gamma);
+    }
+    return;
+  }
+  const int16_t oldCCT = Bus::getCCT(); // CCT is global, restore it when done
+  BusDigital *busd = nullptr; // bus of previous pixel, consecutive pixels usually go to the same bus
+  for (size_t i = 0; i < length; i++) {
+    if (cct && (i == 0 || cct[i-1] != cct[i])) setSegmentCCT(cct[i], correctWB);
+    const unsigned pix = (map && i < mapSize) ? map[i] : i; // same as WS2812FX::getMappedPixelIndex()
+    if (!busd || !busd->containsPixel(pix)) {
+      busd = nullptr;
+      for (auto &bus : busses) if (bus->isDigital() && bus->isOk() && bus->containsPixel(pix)) { busd = static_cast<BusDigital*>(bus.get()); break; }
+      if (!busd) continue; // pixel is not on a digital bus (or is skipped by ledmap)
+    }
+    busd->addColorSum(pixels + i, 1, gamma);
+  }
+  Bus::setCCT(oldCCT);
+}
+
+// combines bus brightness with brightness limit calculated in applyABL(), it is applied when pixels are set
+void BusManager::applyBrightness() {
+  for (auto &bus : busses) if (bus->isDigital() && bus->isOk()) static_cast<BusDigital&>(*bus).applyBrightness();
+}
+
 void BusManager::applyABL() {
-  if (_useABL) {
-    unsigned milliAmpsSum = 0; // use temporary variable to always return a valid _gMilliAmpsUsed to UI
-    unsigned totalLEDs = 0;
+  static unsigned long lastABL = 0;
+  const unsigned long now = millis();
+  const unsigned dt = now - lastABL; // limiters use time since last frame for smoothing and rolling average
+  lastABL = now;
+
+  unsigned milliAmpsSum = 0; // use temporary variable to always return a valid _gMilliAmpsUsed to UI
+  unsigned demandSum = 0;
+  unsigned totalLEDs = 0;
+  for (auto &bus : busses) {
+    if (bus->isDigital() && bus->isOk()) {
+      BusDigital &busd = static_cast<BusDigital&>(*bus);
+      busd.estimateCurrent(); // sets _milliAmpsTotal and resets brightness limit, current is estimated for all buses even if they have the limit set to 0
+      if (_useABL) busd.applyCurrentLimit(dt); // apply per bus ABL limit (if set), updates _milliAmpsTotal if limit reached
+      demandSum += busd.getDemandCurrent();
+      milliAmpsSum += busd.getUsedCurrent();
+      totalLEDs += busd.getLength(); // sum total number of LEDs for global Limit
+    }
+  }
+  // check global current limit (single PSU or PSU shared by buses with their own limit), total current is summed above
+  const unsigned globalLimit = _gMilliAmpsMax > 0 ? _gMilliAmpsMax : _gMilliAmpsPSU;
+  if (_useABL && globalLimit > 0) {
+    uint32_t globalMax = globalLimit > MA_FOR_ESP ? globalLimit - MA_FOR_ESP : 1; // subtract ESP current consumption, fully limit if too low
+    uint8_t  newBri = _gLimiter.limit(milliAmpsSum, globalMax, totalLEDs, dt, _ablSmooth, _ablSustained); // sets brightness to minimum if budget is below standby current
+    milliAmpsSum = _gLimiter.getCurrent(); // update total used current
+
+    // apply brightness limit to each bus, if its 255 nothing changes
     for (auto &bus : busses) {
       if (bus->isDigital() && bus->isOk()) {
         BusDigital &busd = static_cast<BusDigital&>(*bus);
-        busd.estimateCurrent(); // sets _milliAmpsTotal, current is estimated for all buses even if they have the limit set to 0
-        if (_gMilliAmpsMax == 0)
-          busd.applyBriLimit(0); // apply per bus ABL limit, updates _milliAmpsTotal if limit reached
-        milliAmpsSum += busd.getUsedCurrent();
-        totalLEDs += busd.getLength(); // sum total number of LEDs for global Limit
+        if (busd.getLEDCurrent() > 0)  // skip buses with LED current set to 0
+          busd.applyBriLimit(newBri);
       }
     }
-    // check global current limit and apply global ABL limit, total current is summed above
-    if (_gMilliAmpsMax > 0) {
-      uint8_t  newBri = 255;
-      uint32_t globalMax = _gMilliAmpsMax > MA_FOR_ESP ? _gMilliAmpsMax - MA_FOR_ESP : 1; // subtract ESP current consumption, fully limit if too low
-      if (globalMax > totalLEDs) { // check if budget is larger than standby current
-        if (milliAmpsSum > globalMax) {
-          newBri = globalMax * 255 / milliAmpsSum + 1; // scale brightness down to stay in current limit, +1 to avoid 0 brightness
-          milliAmpsSum = globalMax; // update total used current
-        }
-      } else {
-        newBri = 1; // limit too low, set brightness to minimum
-        milliAmpsSum = totalLEDs; // estimate total used current as minimum
-      }
-
-      // apply brightness limit to each bus, if its 255 it will only reset _colorSum
-      for (auto &bus : busses) {
-        if (bus->isDigital() && bus->isOk()) {
-          BusDigital &busd = static_cast<BusDigital&>(*bus);
-          if (busd.getLEDCurrent() > 0)  // skip buses with LED current set to 0
-            busd.applyBriLimit(newBri);
-        }
-      }
-    }
-    _gMilliAmpsUsed = milliAmpsSum;
   }
-  else
-    _gMilliAmpsUsed = 0; // reset, we have no current estimation without ABL
+  _gMilliAmpsUsed   = _useABL ? milliAmpsSum : 0; // we have no current estimation without ABL
+  _gMilliAmpsDemand = _useABL ? demandSum : 0;
 }
 
 ColorOrderMap& BusManager::getColorOrderMap() { return _colorOrderMap; }
@@ -1445,9 +1592,16 @@ int16_t Bus::_cct = -1;
 uint8_t Bus::_cctBlend = 0; // 0 - 127
 uint8_t Bus::_gAWM = 255;
 
-uint16_t BusDigital::_milliAmpsTotal = 0;
+bool    BusDigital::_dither = false;
+uint8_t BusDigital::_ditherFrame = 0;
 
 std::vector<std::unique_ptr<Bus>> BusManager::busses;
 uint16_t BusManager::_gMilliAmpsUsed = 0;
 uint16_t BusManager::_gMilliAmpsMax = ABL_MILLIAMPS_DEFAULT;
+uint16_t BusManager::_gMilliAmpsPSU = 0;
+uint16_t BusManager::_gMilliAmpsDemand = 0;
 bool BusManager::_useABL = false;
+bool BusManager::_ablSmooth = false;
+uint8_t BusManager::_ablSustained = 100;
+ABLLimiter BusManager::_gLimiter;
+DeferredShow BusManager::_deferredShow;
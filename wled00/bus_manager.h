@@ -15,6 +15,9 @@
 
 #include "const.h"
 #include "pin_manager.h"
+#include "bus_show.h"
+#include "color_order.h"
+#include "abl_limiter.h"
 #include <vector>
 #include <memory>
 
@@ -69,13 +72,6 @@ uint16_t approximateKelvinFromRGB(uint32_t rgb);
 
 struct BusConfig; // forward declaration
 
-// Defines an LED Strip and its color ordering.
-typedef struct {
-  uint16_t start;
-  uint16_t len;
-  uint8_t colorOrder;
-} ColorOrderMapEntry;
-
 struct ColorOrderMap {
     bool add(uint16_t start, uint16_t len, uint8_t colorOrder);
 
@@ -93,6 +89,10 @@ struct ColorOrderMap {
     }
 
     [[gnu::hot]] uint8_t getPixelColorOrder(uint16_t pix, uint8_t defaultColorOrder) const;
+    // resolves map into consecutive spans covering a bus (see color_order.h)
+    inline void getSpans(unsigned busStart, unsigned total, uint8_t defaultColorOrder, std::vector<ColorOrderMapEntry> &spans) const {
+      resolveColorOrderSpans(_mappings, busStart, total, defaultColorOrder, spans);
+    }
 
   private:
     std::vector<ColorOrderMapEntry> _mappings;
@@ -129,6 +129,8 @@ class Bus {
     virtual bool     canShow() const                            { return true; }
     virtual void     setStatusPixel(uint32_t c)                 {}
     virtual void     setPixelColor(unsigned pix, uint32_t c)    = 0;
+    virtual void     setPixelColor16(unsigned pix, uint32_t c, bool gamma); // same as setPixelColor() but gamma is applied by bus (high bit depth)
+    virtual void     setPixels(unsigned start, const uint32_t *src, size_t count) { for (size_t i = 0; i < count; i++) setPixelColor(start + i, src[i]); }
     virtual void     setBrightness(uint8_t b)                   { _bri = b; };
     virtual void     setColorOrder(uint8_t co)                  {}
     virtual uint32_t getPixelColor(unsigned pix) const          { return 0; }
@@ -237,6 +239,7 @@ class Bus {
     static uint8_t _cctBlend;
 
     uint32_t autoWhiteCalc(uint32_t c) const;
+    void     autoWhiteCalc16(uint16_t *rgbw) const;
 };
 
 
@@ -249,6 +252,8 @@ class BusDigital : public Bus {
     bool canShow() const override;
     void setStatusPixel(uint32_t c) override;
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixelColor16(unsigned pix, uint32_t c, bool gamma) override;
+    [[gnu::hot]] void setPixels(unsigned start, const uint32_t *src, size_t count) override;
     void setColorOrder(uint8_t colorOrder) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     uint8_t  getColorOrder() const override  { return _colorOrder; }
@@ -256,18 +261,35 @@ class BusDigital : public Bus {
     unsigned skippedLeds() const override    { return _skip; }
     uint16_t getFrequency() const override   { return _frequencykHz; }
     uint16_t getLEDCurrent() const override  { return _milliAmpsPerLed; }
-    uint16_t getUsedCurrent() const override { return _milliAmpsTotal; }
+    uint16_t getUsedCurrent() const override { return std::min(_milliAmpsTotal, (uint32_t)UINT16_MAX); }
+    uint16_t getDemandCurrent() const        { return std::min(_milliAmpsDemand, (uint32_t)UINT16_MAX); } // estimated current without limit
+    uint16_t getCurrentLimit() const         { return _milliAmpsLimit; }
     uint16_t getMaxCurrent() const override  { return _milliAmpsMax; }
     void     setCurrentLimit(uint16_t milliAmps) { _milliAmpsLimit = milliAmps; }
-    void     estimateCurrent(); // estimate used current from summed colors
-    void     applyBriLimit(uint8_t newBri);
+    void     addColorSum(const uint32_t *pixels, size_t count, bool gamma); // sum colors of composited frame for current estimate (before pixels are set)
+    void     estimateCurrent(); // estimate used current from summed colors and bus brightness
+    void     applyCurrentLimit(unsigned dt); // per bus limit
+    void     applyBriLimit(uint8_t newBri);  // global limit
+    inline void applyBrightness()            { _NPBbri = (_bri * _ablBri + 254) / 255; } // brightness used in setPixelColor(), non-zero if both are
     size_t   getBusSize() const override;
     void begin() override;
     void cleanup();
 
     static std::vector<LEDType> getLEDTypes();
+    static inline bool getDither()           { return _dither; }
+    static inline void setDither(bool d)     { _dither = d; }
+    static inline void nextDitherFrame()     { _ditherFrame++; }
+    void     updateColorOrderSpans(); // resolve color order map for this bus, call when map or color order changes
 
   private:
+    [[gnu::hot]] void setRawPixelColor(unsigned pix, uint32_t c); // c already has brightness applied
+    // returns index of color order span containing pix (bus index including skipped LEDs)
+    inline size_t getColorOrderSpan(unsigned pix) const { return findColorOrderSpan(_coSpans, pix); }
+    inline uint8_t getPixelColorOrder(unsigned pix) const { return _coSpans.empty() ? _colorOrder : _coSpans[getColorOrderSpan(pix)].colorOrder; }
+
+    static bool    _dither;      // temporal dithering of 8 bit buses
+    static uint8_t _ditherFrame;
+
     uint8_t  _skip;
     uint8_t  _colorOrder;
     uint8_t  _pins[2];
@@ -276,11 +298,14 @@ class BusDigital : public Bus {
     uint16_t _milliAmpsMax;
     uint8_t  _milliAmpsPerLed;
     uint16_t _milliAmpsLimit;
-    uint32_t _colorSum; // total color value for the bus, updated in setPixelColor(), used to estimate current
+    uint8_t  _ablBri;   // brightness limit calculated by ABL, applied together with _bri in setPixelColor()
+    uint32_t _colorSum; // total color value for the bus, summed in addColorSum() before pixels are set, used to estimate current
+    uint32_t _milliAmpsTotal; // is overwitten/recalculated on each show()
+    uint32_t _milliAmpsDemand; // estimated current before limiting
+    std::vector<ColorOrderMapEntry> _coSpans; // consecutive color order spans covering the bus (bus index), see updateColorOrderSpans()
+    ABLLimiter _limiter;
     void    *_busPtr;
 
-    static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
-
     inline uint32_t restoreColorLossy(uint32_t c, uint8_t restoreBri) const {
       if (restoreBri < 255) {
         uint8_t* chan = (uint8_t*) &c;
@@ -480,7 +505,13 @@ namespace BusManager {
   //extern std::vector<Bus*> busses;
   extern uint16_t _gMilliAmpsUsed;
   extern uint16_t _gMilliAmpsMax;
+  extern uint16_t _gMilliAmpsPSU;
+  extern uint16_t _gMilliAmpsDemand;
   extern bool     _useABL;
+  extern bool     _ablSmooth;    // attack/release smoothing of brightness limit
+  extern uint8_t  _ablSustained; // sustained budget in % of (peak) limit, 100 = not used
+  extern ABLLimiter _gLimiter;
+  extern DeferredShow _deferredShow; // buses whose frame is waiting for previous transmission to finish
 
   #ifdef ESP32_DATA_IDLE_HIGH
   void    esp32RMTInvertIdle() ;
@@ -496,8 +527,18 @@ namespace BusManager {
   //inline uint16_t ablMilliampsMax()             { unsigned sum = 0; for (auto &bus : busses) sum += bus->getMaxCurrent(); return sum; }
   inline uint16_t ablMilliampsMax()             { return _gMilliAmpsMax; }  // used for compatibility reasons (and enabling virtual global ABL)
   inline void     setMilliampsMax(uint16_t max) { _gMilliAmpsMax = max;}
+  inline uint16_t ablMilliampsPSU()             { return _gMilliAmpsPSU; }  // PSU budget shared by buses with per bus limit
+  inline void     setMilliampsPSU(uint16_t max) { _gMilliAmpsPSU = max;}
+  inline uint16_t demandMilliamps()             { return _gMilliAmpsDemand + MA_FOR_ESP; } // estimated current without limit
+  inline uint16_t averageMilliamps()            { return _gLimiter.getAverage() + MA_FOR_ESP; } // rolling average (global limit only)
+  inline bool     getABLSmoothing()             { return _ablSmooth; }
+  inline void     setABLSmoothing(bool s)       { _ablSmooth = s; }
+  inline uint8_t  getABLSustained()             { return _ablSustained; }
+  inline void     setABLSustained(int pct)      { _ablSustained = pct < 10 ? 10 : (pct > 100 ? 100 : pct); }
   void            initializeABL();              // setup automatic brightness limiter parameters, call once after buses are initialized
-  void            applyABL();                   // apply automatic brightness limiter, global or per bus
+  void            estimateCurrent(const uint32_t *pixels, size_t length, bool gamma, const uint16_t *map = nullptr, size_t mapSize = 0, const uint8_t *cct = nullptr, bool correctWB = false); // sum colors of composited frame
+  void            applyABL();                   // estimate current and calculate brightness limit (global and/or per bus), call after estimateCurrent()
+  void            applyBrightness();            // combine bus brightness with brightness limit, call after applyABL() and before setting pixels
 
   void useParallelOutput(); // workaround for inaccessible PolyBus
   bool hasParallelOutput(); // workaround for inaccessible PolyBus
@@ -510,9 +551,17 @@ namespace BusManager {
   void off();
 
   [[gnu::hot]] void     setPixelColor(unsigned pix, uint32_t c);
+  [[gnu::hot]] void     setPixelColor16(unsigned pix, uint32_t c, bool gamma); // c is not gamma corrected
+  [[gnu::hot]] void     setPixels(unsigned start, const uint32_t *src, size_t count); // bulk setPixelColor() for consecutive pixels
+  bool                  hasHighDepthOutput(); // true if any bus uses setPixelColor16() path (16 bit or dithering)
+  void                  updateColorOrderSpans(); // call after color order map or buses changed (only from loop(), see doUpdateColorOrder)
   [[gnu::hot]] uint32_t getPixelColor(unsigned pix);
-  void        show();
+  void        show();               // does not block, buses that are still sending are flagged and sent by showPending()
+  void        showPending();        // call every loop() iteration, sends deferred frames once buses are idle
   bool        canAllShow();
+  inline bool     isShowPending()      { return _deferredShow.isPending(); }
+  inline uint32_t getShowWaitTime()    { return _deferredShow.getWaitTime(); } // average microseconds per frame spent waiting for canShow()
+  inline uint32_t getDroppedFrames()   { return _deferredShow.getDropped(); }
   inline void setStatusPixel(uint32_t c) { for (auto &bus : busses) bus->setStatusPixel(c);}
   inline void setBrightness(uint8_t b)   { for (auto &bus : busses) bus->setBrightness(b); }
   // for setSegmentCCT(), cct can only be in [-1,255] range; allowWBCorrection will convert it to K
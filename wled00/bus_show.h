@@ -0,0 +1,58 @@
+#pragma once
+#ifndef BusShow_h
+#define BusShow_h
+/*
+ * Bookkeeping for non-blocking BusManager::show()
+ * Buses that are still sending the previous frame are flagged and their frame is sent by flush()
+ * once they are idle. Also keeps the average time a frame waited and the number of frames that were
+ * overwritten before they could be sent (reported in the info JSON).
+ */
+
+#include <stdint.h>
+
+class DeferredShow {
+  public:
+    // shows all idle buses (anything providing canShow() and show()), flags the busy ones
+    // returns true if a frame had to be deferred
+    template<class C> bool show(C &buses, uint32_t nowUs) {
+      if (_pending) _dropped++; // previous frame was never sent, it has been overwritten by this one
+      uint64_t pending = 0;
+      unsigned i = 0;
+      for (auto &bus : buses) {
+        if (bus->canShow()) bus->show();
+        else pending |= 1ULL << i;
+        i++;
+      }
+      if (pending && !_pending) _pendingAt = nowUs; // keep original timestamp if frame was dropped
+      _pending = pending;
+      if (!pending) _waitUs -= _waitUs >> 4; // frame was not delayed
+      return pending;
+    }
+
+    // sends deferred frame to buses that became idle, must be called often (every loop() iteration)
+    template<class C> void flush(C &buses, uint32_t nowUs) {
+      if (!_pending) return;
+      unsigned i = 0;
+      for (auto &bus : buses) {
+        const uint64_t mask = 1ULL << i++;
+        if ((_pending & mask) && bus->canShow()) {
+          bus->show();
+          _pending &= ~mask;
+        }
+      }
+      if (!_pending) _waitUs += (nowUs - _pendingAt) - (_waitUs >> 4); // rolling average over 16 frames
+    }
+
+    inline bool     isPending() const   { return _pending != 0; }
+    inline uint32_t getWaitTime() const { return _waitUs >> 4; } // average microseconds a frame waited for canShow()
+    inline uint32_t getDropped() const  { return _dropped; }     // frames overwritten before they could be sent
+    inline void     clear()             { _pending = 0; }        // buses removed
+
+  private:
+    uint64_t _pending   = 0; // bit per bus
+    uint32_t _pendingAt = 0; // micros() when frame was deferred
+    uint32_t _waitUs    = 0; // x16 fixed point
+    uint32_t _dropped   = 0;
+};
+
+#endif
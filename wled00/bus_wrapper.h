@@ -4,6 +4,7 @@
 
 //#define NPB_CONF_4STEP_CADENCE
 #include "NeoPixelBus.h"
+#include "color_order.h"
 
 //Hardware SPI Pins
 #define P_8266_HS_MOSI 13
@@ -904,6 +905,170 @@ class PolyBus {
     }
   }
 
+  // color channels in selected order (see setPixelColor())
+  static inline RgbwColor orderedColor(uint32_t c, uint8_t co) {
+    uint8_t wire[4]; // G, R, B, W
+    colorToWireOrder(c, co, wire);
+    return RgbwColor(wire[1], wire[0], wire[2], wire[3]);
+  }
+  // one instance per NeoPixelBus type used by setPixels(), 3 and 4 channel color objects
+  template<class B, class C = RgbColor> static void setPixels3(void* busPtr, uint16_t pix, int step, const uint32_t *c, size_t count, uint8_t co) {
+    B *bus = static_cast<B*>(busPtr);
+    for (size_t i = 0; i < count; i++, pix += step) bus->SetPixelColor(pix, C(RgbColor(orderedColor(c[i], co))));
+  }
+  template<class B, class C = RgbwColor> static void setPixels4(void* busPtr, uint16_t pix, int step, const uint32_t *c, size_t count, uint8_t co) {
+    B *bus = static_cast<B*>(busPtr);
+    for (size_t i = 0; i < count; i++, pix += step) bus->SetPixelColor(pix, C(orderedColor(c[i], co)));
+  }
+  // plain 8 bit GRB/GRBW features: byte order fast path, wire order bytes are written directly into the NeoPixelBus pixel buffer
+  // skipping per pixel bounds check, dirty flag and feature conversion; caller guarantees pix range
+  // NeoPixelBus still encodes that buffer into RMT items or I2S/UART bit patterns on Show() (a second pass over the frame)
+  template<class B, unsigned N> static void writePixels(void* busPtr, uint16_t pix, int step, const uint32_t *c, size_t count, uint8_t co) {
+    B *bus = static_cast<B*>(busPtr);
+    writeWireOrderPixels<N>(bus->Pixels(), pix, step, c, count, co);
+    bus->Dirty();
+  }
+
+  // bulk version of setPixelColor() for pixels with same color order, pix is index of 1st pixel, step is +1 or -1 (reversed)
+  // type dispatch happens once per call, CCT capable buses are not supported (use setPixelColor())
+  [[gnu::hot]] static void setPixels(void* busPtr, uint8_t busType, uint16_t pix, int step, const uint32_t *c, size_t count, uint8_t co) {
+    switch (busType) {
+    #ifdef ESP8266
+      case I_8266_U0_NEO_3: writePixels<B_8266_U0_NEO_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U1_NEO_3: writePixels<B_8266_U1_NEO_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_DM_NEO_3: writePixels<B_8266_DM_NEO_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_BB_NEO_3: writePixels<B_8266_BB_NEO_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U0_NEO_4: writePixels<B_8266_U0_NEO_4, 4>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U1_NEO_4: writePixels<B_8266_U1_NEO_4, 4>(busPtr, pix, step, c, count, co); break;
+      case I_8266_DM_NEO_4: writePixels<B_8266_DM_NEO_4, 4>(busPtr, pix, step, c, count, co); break;
+      case I_8266_BB_NEO_4: writePixels<B_8266_BB_NEO_4, 4>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U0_400_3: writePixels<B_8266_U0_400_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U1_400_3: writePixels<B_8266_U1_400_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_DM_400_3: writePixels<B_8266_DM_400_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_BB_400_3: writePixels<B_8266_BB_400_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U0_TM1_4: setPixels4<B_8266_U0_TM1_4>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U1_TM1_4: setPixels4<B_8266_U1_TM1_4>(busPtr, pix, step, c, count, co); break;
+      case I_8266_DM_TM1_4: setPixels4<B_8266_DM_TM1_4>(busPtr, pix, step, c, count, co); break;
+      case I_8266_BB_TM1_4: setPixels4<B_8266_BB_TM1_4>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U0_TM2_3: setPixels3<B_8266_U0_TM2_3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U1_TM2_3: setPixels3<B_8266_U1_TM2_3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_DM_TM2_3: setPixels3<B_8266_DM_TM2_3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_BB_TM2_3: setPixels3<B_8266_BB_TM2_3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U0_UCS_3: setPixels3<B_8266_U0_UCS_3, Rgb48Color>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U1_UCS_3: setPixels3<B_8266_U1_UCS_3, Rgb48Color>(busPtr, pix, step, c, count, co); break;
+      case I_8266_DM_UCS_3: setPixels3<B_8266_DM_UCS_3, Rgb48Color>(busPtr, pix, step, c, count, co); break;
+      case I_8266_BB_UCS_3: setPixels3<B_8266_BB_UCS_3, Rgb48Color>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U0_UCS_4: setPixels4<B_8266_U0_UCS_4, Rgbw64Color>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U1_UCS_4: setPixels4<B_8266_U1_UCS_4, Rgbw64Color>(busPtr, pix, step, c, count, co); break;
+      case I_8266_DM_UCS_4: setPixels4<B_8266_DM_UCS_4, Rgbw64Color>(busPtr, pix, step, c, count, co); break;
+      case I_8266_BB_UCS_4: setPixels4<B_8266_BB_UCS_4, Rgbw64Color>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U0_APA106_3: setPixels3<B_8266_U0_APA106_3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U1_APA106_3: setPixels3<B_8266_U1_APA106_3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_DM_APA106_3: writePixels<B_8266_DM_APA106_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_BB_APA106_3: writePixels<B_8266_BB_APA106_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U0_TM1914_3: setPixels3<B_8266_U0_TM1914_3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_U1_TM1914_3: setPixels3<B_8266_U1_TM1914_3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_DM_TM1914_3: setPixels3<B_8266_DM_TM1914_3>(busPtr, pix, step, c, count, co); break;
+      case I_8266_BB_TM1914_3: setPixels3<B_8266_BB_TM1914_3>(busPtr, pix, step, c, count, co); break;
+    #endif
+    #ifdef ARDUINO_ARCH_ESP32
+      // RMT buses
+      case I_32_RN_NEO_3: writePixels<B_32_RN_NEO_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_32_RN_NEO_4: writePixels<B_32_RN_NEO_4, 4>(busPtr, pix, step, c, count, co); break;
+      case I_32_RN_400_3: writePixels<B_32_RN_400_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_32_RN_TM1_4: setPixels4<B_32_RN_TM1_4>(busPtr, pix, step, c, count, co); break;
+      case I_32_RN_TM2_3: setPixels3<B_32_RN_TM2_3>(busPtr, pix, step, c, count, co); break;
+      case I_32_RN_UCS_3: setPixels3<B_32_RN_UCS_3, Rgb48Color>(busPtr, pix, step, c, count, co); break;
+      case I_32_RN_UCS_4: setPixels4<B_32_RN_UCS_4, Rgbw64Color>(busPtr, pix, step, c, count, co); break;
+      case I_32_RN_APA106_3: writePixels<B_32_RN_APA106_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_32_RN_TM1914_3: setPixels3<B_32_RN_TM1914_3>(busPtr, pix, step, c, count, co); break;
+      // I2S1 bus or paralell buses
+      #ifndef CONFIG_IDF_TARGET_ESP32C3
+      case I_32_I2_NEO_3: if (_useParallelI2S) writePixels<B_32_IP_NEO_3, 3>(busPtr, pix, step, c, count, co); else writePixels<B_32_I2_NEO_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_32_I2_NEO_4: if (_useParallelI2S) writePixels<B_32_IP_NEO_4, 4>(busPtr, pix, step, c, count, co); else writePixels<B_32_I2_NEO_4, 4>(busPtr, pix, step, c, count, co); break;
+      case I_32_I2_400_3: if (_useParallelI2S) writePixels<B_32_IP_400_3, 3>(busPtr, pix, step, c, count, co); else writePixels<B_32_I2_400_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_32_I2_TM1_4: if (_useParallelI2S) setPixels4<B_32_IP_TM1_4>(busPtr, pix, step, c, count, co); else setPixels4<B_32_I2_TM1_4>(busPtr, pix, step, c, count, co); break;
+      case I_32_I2_TM2_3: if (_useParallelI2S) setPixels3<B_32_IP_TM2_3>(busPtr, pix, step, c, count, co); else setPixels3<B_32_I2_TM2_3>(busPtr, pix, step, c, count, co); break;
+      case I_32_I2_UCS_3: if (_useParallelI2S) setPixels3<B_32_IP_UCS_3, Rgb48Color>(busPtr, pix, step, c, count, co); else setPixels3<B_32_I2_UCS_3, Rgb48Color>(busPtr, pix, step, c, count, co); break;
+      case I_32_I2_UCS_4: if (_useParallelI2S) setPixels4<B_32_IP_UCS_4, Rgbw64Color>(busPtr, pix, step, c, count, co); else setPixels4<B_32_I2_UCS_4, Rgbw64Color>(busPtr, pix, step, c, count, co); break;
+      case I_32_I2_APA106_3: if (_useParallelI2S) writePixels<B_32_IP_APA106_3, 3>(busPtr, pix, step, c, count, co); else writePixels<B_32_I2_APA106_3, 3>(busPtr, pix, step, c, count, co); break;
+      case I_32_I2_TM1914_3: if (_useParallelI2S) setPixels3<B_32_IP_TM1914_3>(busPtr, pix, step, c, count, co); else setPixels3<B_32_I2_TM1914_3>(busPtr, pix, step, c, count, co); break;
+      #endif
+    #endif
+      case I_HS_DOT_3: setPixels3<B_HS_DOT_3>(busPtr, pix, step, c, count, co); break;
+      case I_SS_DOT_3: setPixels3<B_SS_DOT_3>(busPtr, pix, step, c, count, co); break;
+      case I_HS_LPD_3: setPixels3<B_HS_LPD_3>(busPtr, pix, step, c, count, co); break;
+      case I_SS_LPD_3: setPixels3<B_SS_LPD_3>(busPtr, pix, step, c, count, co); break;
+      case I_HS_LPO_3: setPixels3<B_HS_LPO_3>(busPtr, pix, step, c, count, co); break;
+      case I_SS_LPO_3: setPixels3<B_SS_LPO_3>(busPtr, pix, step, c, count, co); break;
+      case I_HS_WS1_3: setPixels3<B_HS_WS1_3>(busPtr, pix, step, c, count, co); break;
+      case I_SS_WS1_3: setPixels3<B_SS_WS1_3>(busPtr, pix, step, c, count, co); break;
+      case I_HS_P98_3: setPixels3<B_HS_P98_3>(busPtr, pix, step, c, count, co); break;
+      case I_SS_P98_3: setPixels3<B_SS_P98_3>(busPtr, pix, step, c, count, co); break;
+      default: for (size_t i = 0; i < count; i++, pix += step) setPixelColor(busPtr, busType, pix, c[i], co); break;
+    }
+  }
+
+  // 16 bit per channel version of setPixelColor() for UCS8903, UCS8904 and SM16825, rgbw is {R,G,B,W}, wwcw is (CW<<16) | WW
+  [[gnu::hot]] static void setPixelColor16(void* busPtr, uint8_t busType, uint16_t pix, const uint16_t *rgbw, uint8_t co, uint32_t wwcw = 0) {
+    uint16_t r = rgbw[0];
+    uint16_t g = rgbw[1];
+    uint16_t b = rgbw[2];
+    uint16_t w = rgbw[3];
+    Rgbw64Color col;
+    uint16_t cctWW = wwcw & 0xFFFF, cctCW = (wwcw>>16) & 0xFFFF;
+
+    // reorder channels to selected order
+    switch (co & 0x0F) {
+      default: col.G = g; col.R = r; col.B = b; break; //0 = GRB, default
+      case  1: col.G = r; col.R = g; col.B = b; break; //1 = RGB, common for WS2811
+      case  2: col.G = b; col.R = r; col.B = g; break; //2 = BRG
+      case  3: col.G = r; col.R = b; col.B = g; break; //3 = RBG
+      case  4: col.G = b; col.R = g; col.B = r; break; //4 = BGR
+      case  5: col.G = g; col.R = b; col.B = r; break; //5 = GBR
+    }
+    // upper nibble contains W swap information
+    switch (co >> 4) {
+      default: col.W = w;                break; // no swapping
+      case  1: col.W = col.B; col.B = w; break; // swap W & B
+      case  2: col.W = col.G; col.G = w; break; // swap W & G
+      case  3: col.W = col.R; col.R = w; break; // swap W & R
+      case  4: std::swap(cctWW, cctCW);  break; // swap WW & CW
+    }
+
+    switch (busType) {
+    #ifdef ESP8266
+      case I_8266_U0_UCS_3: (static_cast<B_8266_U0_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_U1_UCS_3: (static_cast<B_8266_U1_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_DM_UCS_3: (static_cast<B_8266_DM_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_BB_UCS_3: (static_cast<B_8266_BB_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_8266_U0_UCS_4: (static_cast<B_8266_U0_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_U1_UCS_4: (static_cast<B_8266_U1_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_DM_UCS_4: (static_cast<B_8266_DM_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_BB_UCS_4: (static_cast<B_8266_BB_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_8266_U0_SM16825_5: (static_cast<B_8266_U0_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+      case I_8266_U1_SM16825_5: (static_cast<B_8266_U1_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+      case I_8266_DM_SM16825_5: (static_cast<B_8266_DM_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+      case I_8266_BB_SM16825_5: (static_cast<B_8266_BB_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+    #endif
+    #ifdef ARDUINO_ARCH_ESP32
+      // RMT buses
+      case I_32_RN_UCS_3: (static_cast<B_32_RN_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_32_RN_UCS_4: (static_cast<B_32_RN_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_32_RN_SM16825_5: (static_cast<B_32_RN_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+      // I2S1 bus or paralell buses
+      #ifndef CONFIG_IDF_TARGET_ESP32C3
+      case I_32_I2_UCS_3: if (_useParallelI2S) (static_cast<B_32_IP_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); else (static_cast<B_32_I2_UCS_3*>(busPtr))->SetPixelColor(pix, Rgb48Color(col.R, col.G, col.B)); break;
+      case I_32_I2_UCS_4: if (_useParallelI2S) (static_cast<B_32_IP_UCS_4*>(busPtr))->SetPixelColor(pix, col); else (static_cast<B_32_I2_UCS_4*>(busPtr))->SetPixelColor(pix, col); break;
+      case I_32_I2_SM16825_5: if (_useParallelI2S) (static_cast<B_32_IP_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); else (static_cast<B_32_I2_SM16825_5*>(busPtr))->SetPixelColor(pix, Rgbww80Color(col.R, col.G, col.B, cctWW, cctCW)); break;
+      #endif
+    #endif
+      default: // 8 bit bus
+        setPixelColor(busPtr, busType, pix, RGBW32(r>>8, g>>8, b>>8, w>>8), co, ((wwcw>>16) & 0xFF00) | ((wwcw>>8) & 0xFF));
+        break;
+    }
+  }
+
   [[gnu::hot]] static uint32_t getPixelColor(void* busPtr, uint8_t busType, uint16_t pix, uint8_t co) {
     RgbwColor col(0,0,0,0);
     switch (busType) {
@@ -158,6 +158,9 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   uint16_t total = hw_led[F("total")] | strip.getLengthTotal();
   uint16_t ablMilliampsMax = hw_led[F("maxpwr")] | BusManager::ablMilliampsMax();
   BusManager::setMilliampsMax(ablMilliampsMax);
+  BusManager::setMilliampsPSU(hw_led[F("psupwr")] | BusManager::ablMilliampsPSU());
+  BusManager::setABLSmoothing(hw_led[F("ablsm")] | BusManager::getABLSmoothing());
+  BusManager::setABLSustained(hw_led[F("ablsus")] | BusManager::getABLSustained());
   Bus::setGlobalAWMode(hw_led[F("rgbwm")] | AW_GLOBAL_DISABLED);
   CJSON(strip.correctWB, hw_led["cct"]);
   CJSON(strip.cctFromRgb, hw_led[F("cr")]);
@@ -168,6 +171,9 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   #if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32C3)
   CJSON(useParallelI2S, hw_led[F("prl")]);
   #endif
+  #if WLED_FX_WORKERS > 1
+  CJSON(strip.parallelFX, hw_led[F("pfx")]);
+  #endif
 
   #ifndef WLED_DISABLE_2D
   // 2D Matrix Settings
@@ -196,6 +202,11 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       }
     }
     strip.panel.shrink_to_fit();  // release unused memory (just in case)
+    JsonObject canvas = matrix[F("canvas")]; // this matrix is a tile of a larger canvas
+    CJSON(strip.canvasWidth,  canvas["w"]);
+    CJSON(strip.canvasHeight, canvas["h"]);
+    CJSON(strip.canvasX,      canvas["x"]);
+    CJSON(strip.canvasY,      canvas["y"]);
     // cannot call strip.deserializeLedmap()/strip.setUpMatrix() here due to already locked JSON buffer
     //if (!fromFS) doInit2D = true; // if called at boot (fromFS==true), WLED::beginStrip() will take care of setting up matrix
   }
@@ -335,6 +346,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
       uint8_t colorOrder = (int)entry[F("order")];
       if (!BusManager::getColorOrderMap().add(start, len, colorOrder)) break;
     }
+    doUpdateColorOrder = true; // resolve map for existing buses in loop()
   }
 
   // read multiple button configuration
@@ -518,6 +530,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
     gammaCorrectCol = false;
   }
   NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal); // fill look-up tables
+  BusDigital::setDither(light[F("dither")] | BusDigital::getDither());
 
   JsonObject light_tr = light["tr"];
   int tdd = light_tr["dur"] | -1;
@@ -525,6 +538,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   strip.setTransition(transitionDelayDefault);
   CJSON(randomPaletteChangeTime, light_tr[F("rpc")]);
   CJSON(useHarmonicRandomPalette, light_tr[F("hrp")]);
+  CJSON(transitionSnapshot, light_tr[F("snap")]);
 
   JsonObject light_nl = light["nl"];
   CJSON(nightlightMode, light_nl["mode"]);
@@ -538,6 +552,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject def = doc["def"];
   CJSON(bootPreset, def["ps"]);
   CJSON(turnOnAtBoot, def["on"]); // true
+  CJSON(earlyOutput, def[F("early")]);
   CJSON(briS, def["bri"]); // 128
 
   JsonObject interfaces = doc["if"];
@@ -549,6 +564,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
 #ifndef WLED_DISABLE_ESPNOW
   CJSON(useESPNowSync, if_sync[F("espnow")]);
 #endif
+  CJSON(frameSyncMode, if_sync[F("fsync")]);
+  if (frameSyncMode > 2) frameSyncMode = 0;
 
   JsonObject if_sync_recv = if_sync[F("recv")];
   CJSON(receiveNotificationBrightness, if_sync_recv["bri"]);
@@ -740,6 +757,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
     if (i > 14) break;
     CJSON(DMXFixtureMap[i],dmx_fixmap[i]);
   }
+  compileDMXOutput();
 
   CJSON(e131ProxyUniverse, dmx[F("e131proxy")]);
   #endif
@@ -758,12 +776,21 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
 }
 
 static const char s_cfg_json[] PROGMEM = "/cfg.json";
+static const char s_cfg_bin[]  PROGMEM = "/cfg.bin"; // binary snapshot of cfg.json, see below
+static int8_t cfgSnapshotState = -1; // -1 not checked, 0 invalid, 1 valid
+
+// must be called whenever cfg.json is modified other than by serializeConfigToFS() (upload, restore, reset)
+void removeConfigSnapshot() {
+  WLED_FS.remove(FPSTR(s_cfg_bin));
+  cfgSnapshotState = 0;
+}
 
 bool backupConfig() {
   return backupFile(s_cfg_json);
 }
 
 bool restoreConfig() {
+  removeConfigSnapshot();
   return restoreFile(s_cfg_json);
 }
 
@@ -783,10 +810,83 @@ void resetConfig() {
     char backupname[32];
     snprintf_P(backupname, sizeof(backupname), PSTR("/rst.%s"), &s_cfg_json[1]);
     WLED_FS.rename(s_cfg_json, backupname);
+    removeConfigSnapshot();
     doReboot = true;
   }
 }
 
+/*
+ * Binary (MessagePack) snapshot of cfg.json written together with it. It is loaded at boot instead of parsing
+ * (and validating) cfg.json as long as cfg.json was not modified (i.e. uploaded or restored) and firmware is the same.
+ * Validity is checked from size and modification time of cfg.json (file is not read), other writers of cfg.json
+ * remove the snapshot.
+ */
+#define CFG_SNAPSHOT_MAGIC   0x47464357 // "WCFG"
+#define CFG_SNAPSHOT_VERSION 2
+
+typedef struct CfgSnapshotHeader {
+  uint32_t magic;
+  uint16_t version;   // snapshot format
+  uint16_t reserved;
+  uint32_t vid;       // firmware that wrote the snapshot
+  uint32_t cfgTime;   // last write time of cfg.json
+  uint32_t cfgSize;
+} cfgsnap;
+
+// size and last write time of cfg.json (from file system metadata)
+static bool statConfigFile(uint32_t &time, uint32_t &size) {
+  File f = WLED_FS.open(FPSTR(s_cfg_json), "r");
+  if (!f) return false;
+  size = f.size();
+  time = f.getLastWrite();
+  f.close();
+  return true;
+}
+
+// reads snapshot header, true if cfg.bin matches cfg.json (which then need not be validated)
+static bool readConfigSnapshotHeader(File &f) {
+  CfgSnapshotHeader hdr;
+  uint32_t time, size;
+  return f.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr) &&
+         hdr.magic == CFG_SNAPSHOT_MAGIC && hdr.version == CFG_SNAPSHOT_VERSION && hdr.vid == VERSION &&
+         statConfigFile(time, size) && time == hdr.cfgTime && size == hdr.cfgSize;
+}
+
+bool configSnapshotValid() {
+  if (cfgSnapshotState >= 0) return cfgSnapshotState;
+  cfgSnapshotState = 0;
+  File f = WLED_FS.open(FPSTR(s_cfg_bin), "r");
+  if (!f) return false;
+  cfgSnapshotState = readConfigSnapshotHeader(f);
+  f.close();
+  DEBUG_PRINTF_P(PSTR("Config snapshot %s.\n"), cfgSnapshotState ? "valid" : "invalid");
+  return cfgSnapshotState;
+}
+
+// single read of cfg.bin: header check and MessagePack decode
+static bool readConfigSnapshot(JsonDocument *doc) {
+  if (cfgSnapshotState == 0) return false;
+  File f = WLED_FS.open(FPSTR(s_cfg_bin), "r");
+  if (!f) return false;
+  bool success = readConfigSnapshotHeader(f) && deserializeMsgPack(*doc, f) == DeserializationError::Ok;
+  f.close();
+  cfgSnapshotState = success;
+  return success;
+}
+
+// must be called after cfg.json is closed (so its metadata is final)
+static void writeConfigSnapshot(const JsonDocument *doc) {
+  uint32_t time, size;
+  if (!statConfigFile(time, size)) return;
+  File f = WLED_FS.open(FPSTR(s_cfg_bin), "w");
+  if (!f) return;
+  CfgSnapshotHeader hdr = { CFG_SNAPSHOT_MAGIC, CFG_SNAPSHOT_VERSION, 0, VERSION, time, size };
+  f.write(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr));
+  serializeMsgPack(*doc, f);
+  f.close();
+  cfgSnapshotState = 1;
+}
+
 bool deserializeConfigFromFS() {
   [[maybe_unused]] bool success = deserializeConfigSec();
   #ifdef WLED_ADD_EEPROM_SUPPORT
@@ -797,9 +897,15 @@ bool deserializeConfigFromFS() {
 
   if (!requestJSONBufferLock(1)) return false;
 
-  DEBUG_PRINTLN(F("Reading settings from /cfg.json..."));
-
-  success = readObjectFromFile(s_cfg_json, nullptr, pDoc);
+  bootFromSnapshot = readConfigSnapshot(pDoc);
+  if (bootFromSnapshot) {
+    DEBUG_PRINTLN(F("Reading settings from /cfg.bin..."));
+    success = true;
+  } else {
+    DEBUG_PRINTLN(F("Reading settings from /cfg.json..."));
+    success = readObjectFromFile(s_cfg_json, nullptr, pDoc);
+    if (success) writeConfigSnapshot(pDoc); // faster boot next time
+  }
 
   // NOTE: This routine deserializes *and* applies the configuration
   //       Therefore, must also initialize ethernet from this function
@@ -823,8 +929,11 @@ void serializeConfigToFS() {
   serializeConfig(root);
 
   File f = WLED_FS.open(FPSTR(s_cfg_json), "w");
-  if (f) serializeJson(root, f);
-  f.close();
+  if (f) {
+    serializeJson(root, f);
+    f.close();
+    writeConfigSnapshot(pDoc);
+  }
   releaseJSONBufferLock();
 
   configNeedsWrite = false;
@@ -926,6 +1035,9 @@ void serializeConfig(JsonObject root) {
   JsonObject hw_led = hw.createNestedObject("led");
   hw_led[F("total")] = strip.getLengthTotal(); //provided for compatibility on downgrade and per-output ABL
   hw_led[F("maxpwr")] = BusManager::ablMilliampsMax();
+  hw_led[F("psupwr")] = BusManager::ablMilliampsPSU();
+  hw_led[F("ablsm")] = BusManager::getABLSmoothing();
+  hw_led[F("ablsus")] = BusManager::getABLSustained();
 //  hw_led[F("ledma")] = 0; // no longer used
   hw_led["cct"] = strip.correctWB;
   hw_led[F("cr")] = strip.cctFromRgb;
@@ -936,6 +1048,9 @@ void serializeConfig(JsonObject root) {
   #if defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_IDF_TARGET_ESP32C3)
   hw_led[F("prl")] = BusManager::hasParallelOutput();
   #endif
+  #if WLED_FX_WORKERS > 1
+  hw_led[F("pfx")] = strip.parallelFX;
+  #endif
 
   #ifndef WLED_DISABLE_2D
   // 2D Matrix Settings
@@ -954,6 +1069,11 @@ void serializeConfig(JsonObject root) {
       pnl["h"] = strip.panel[i].height;
       pnl["w"] = strip.panel[i].width;
     }
+    JsonObject canvas = matrix.createNestedObject(F("canvas"));
+    canvas["w"] = strip.canvasWidth;
+    canvas["h"] = strip.canvasHeight;
+    canvas["x"] = strip.canvasX;
+    canvas["y"] = strip.canvasY;
   }
   #endif
 
@@ -1059,11 +1179,13 @@ void serializeConfig(JsonObject root) {
   light_gc["bri"] = (gammaCorrectBri) ? gammaCorrectVal : 1.0f;  // keep compatibility
   light_gc["col"] = (gammaCorrectCol) ? gammaCorrectVal : 1.0f;  // keep compatibility
   light_gc["val"] = gammaCorrectVal;
+  light[F("dither")] = BusDigital::getDither();
 
   JsonObject light_tr = light.createNestedObject("tr");
   light_tr["dur"] = transitionDelayDefault / 100;
   light_tr[F("rpc")] = randomPaletteChangeTime;
   light_tr[F("hrp")] = useHarmonicRandomPalette;
+  light_tr[F("snap")] = transitionSnapshot;
 
   JsonObject light_nl = light.createNestedObject("nl");
   light_nl["mode"] = nightlightMode;
@@ -1074,6 +1196,7 @@ void serializeConfig(JsonObject root) {
   JsonObject def = root.createNestedObject("def");
   def["ps"] = bootPreset;
   def["on"] = turnOnAtBoot;
+  def[F("early")] = earlyOutput;
   def["bri"] = briS;
 
   JsonObject interfaces = root.createNestedObject("if");
@@ -1085,6 +1208,7 @@ void serializeConfig(JsonObject root) {
 #ifndef WLED_DISABLE_ESPNOW
   if_sync[F("espnow")] = useESPNowSync;
 #endif
+  if_sync[F("fsync")] = frameSyncMode;
 
   JsonObject if_sync_recv = if_sync.createNestedObject(F("recv"));
   if_sync_recv["bri"] = receiveNotificationBrightness;
@@ -0,0 +1,113 @@
+#pragma once
+#ifndef ColorOrder_h
+#define ColorOrder_h
+/*
+ * Color order map resolution (used by ColorOrderMap and BusDigital) and color to wire order conversion (used by PolyBus)
+ * A bus resolves the (possibly overlapping) user mappings into consecutive spans once, so setPixels() can look up
+ * the color order once per run of pixels instead of scanning the mappings for every LED.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <algorithm>
+
+// Defines an LED Strip and its color ordering.
+typedef struct {
+  uint16_t start;
+  uint16_t len;
+  uint8_t colorOrder;
+} ColorOrderMapEntry;
+
+// color order of pix (absolute LED index), first matching mapping wins (mappings may overlap)
+// upper nibble contains W swap information: when mapping's upper nibble is >0 it is used, otherwise default (global) swap is used
+inline uint8_t colorOrderAt(const std::vector<ColorOrderMapEntry> &mappings, unsigned pix, uint8_t defaultColorOrder) {
+  for (const auto& map : mappings) {
+    if (pix >= map.start && pix < (unsigned)(map.start + map.len)) return map.colorOrder | ((map.colorOrder >> 4) ? 0 : (defaultColorOrder & 0xF0));
+  }
+  return defaultColorOrder;
+}
+
+// same as colorOrderAt(), also returns range [runStart, runEnd) around pix in which color order does not change
+// color order only changes at mapping boundaries, so the run is between the nearest boundaries around pix
+inline uint8_t colorOrderRunAt(const std::vector<ColorOrderMapEntry> &mappings, unsigned pix, uint8_t defaultColorOrder, unsigned &runStart, unsigned &runEnd) {
+  runStart = 0;
+  runEnd   = UINT16_MAX + 1;
+  for (const auto& map : mappings) {
+    const unsigned mapEnd = map.start + map.len;
+    if (pix < map.start)   runEnd   = std::min(runEnd, (unsigned)map.start);
+    else if (pix >= mapEnd) runStart = std::max(runStart, mapEnd);
+    else { runStart = std::max(runStart, (unsigned)map.start); runEnd = std::min(runEnd, mapEnd); }
+  }
+  return colorOrderAt(mappings, pix, defaultColorOrder);
+}
+
+// resolves mappings into consecutive spans covering a bus of total LEDs starting at busStart
+// span start is relative to the bus, equal neighbours are merged; result replaces spans
+inline void resolveColorOrderSpans(const std::vector<ColorOrderMapEntry> &mappings, unsigned busStart, unsigned total, uint8_t defaultColorOrder, std::vector<ColorOrderMapEntry> &spans) {
+  spans.clear();
+  unsigned pos = 0;
+  while (pos < total) {
+    unsigned runStart, runEnd;
+    const uint8_t co = colorOrderRunAt(mappings, pos + busStart, defaultColorOrder, runStart, runEnd);
+    const unsigned end = std::min(runEnd - busStart, total);
+    if (!spans.empty() && spans.back().colorOrder == co) spans.back().len += end - pos; // merge equal neighbours
+    else spans.push_back({(uint16_t)pos, (uint16_t)(end - pos), co});
+    pos = end;
+  }
+  spans.shrink_to_fit();
+}
+
+// index of span containing pix (spans as returned by resolveColorOrderSpans(), must not be empty)
+inline size_t findColorOrderSpan(const std::vector<ColorOrderMapEntry> &spans, unsigned pix) {
+  size_t i = 0;
+  while (i + 1 < spans.size() && pix >= (unsigned)(spans[i].start + spans[i].len)) i++;
+  return i;
+}
+
+// run of pixels sharing one color order span, starting at pixel start of a bus of len LEDs (used by BusDigital::setPixels())
+// pix is set to LED index of first pixel (reversal and skipped LEDs applied), following pixels are at pix+1 (pix-1 if reversed)
+// returns index of span, n is number of pixels in run (at most count)
+inline size_t colorOrderSpanRun(const std::vector<ColorOrderMapEntry> &spans, unsigned start, size_t count, unsigned len, unsigned skip, bool reversed, unsigned &pix, size_t &n) {
+  pix = (reversed ? len - start - 1 : start) + skip;
+  const size_t i = findColorOrderSpan(spans, pix);
+  n = reversed ? pix - spans[i].start + 1 : spans[i].start + spans[i].len - pix; // pixels until color order changes
+  n = std::min(n, count);
+  return i;
+}
+
+// converts c (WRGB) to bytes in GRB(W) wire order of NeoPixelBus features for color order co
+// lower nibble of co is RGB order, upper nibble swaps W with another channel
+inline void colorToWireOrder(uint32_t c, uint8_t co, uint8_t wire[4]) {
+  const uint8_t r = c >> 16;
+  const uint8_t g = c >> 8;
+  const uint8_t b = c >> 0;
+  const uint8_t w = c >> 24;
+  uint8_t &G = wire[0], &R = wire[1], &B = wire[2], &W = wire[3];
+  switch (co & 0x0F) {
+    default: G = g; R = r; B = b; break; //0 = GRB, default
+    case  1: G = r; R = g; B = b; break; //1 = RGB, common for WS2811
+    case  2: G = b; R = r; B = g; break; //2 = BRG
+    case  3: G = r; R = b; B = g; break; //3 = RBG
+    case  4: G = b; R = g; B = r; break; //4 = BGR
+    case  5: G = g; R = b; B = r; break; //5 = GBR
+  }
+  switch (co >> 4) {
+    default: W = w;         break; // no swapping
+    case  1: W = B; B = w;  break; // swap W & B
+    case  2: W = G; G = w;  break; // swap W & G
+    case  3: W = R; R = w;  break; // swap W & R
+  }
+}
+
+// writes count colors into buffer of N byte (3: GRB, 4: GRBW) pixels, pixel i goes to buf[(pix + i*step) * N] (used by PolyBus::writePixels())
+template<unsigned N> inline void writeWireOrderPixels(uint8_t *buf, unsigned pix, int step, const uint32_t *c, size_t count, uint8_t co) {
+  for (size_t i = 0; i < count; i++) {
+    uint8_t wire[4];
+    colorToWireOrder(c[i], co, wire);
+    uint8_t *p = buf + (pix + (int)i * step) * N;
+    for (unsigned k = 0; k < N; k++) p[k] = wire[k];
+  }
+}
+
+#endif
@@ -0,0 +1,182 @@
+#pragma once
+#ifndef WLED_COLOR_SPAN_H
+#define WLED_COLOR_SPAN_H
+/*
+ * Span variants of color functions (used by Segment fade/blur functions)
+ *
+ * pixels are processed as two 16 bit lanes per 32 bit word (R & B and W & G) like the single pixel functions, native builds
+ * process 4 pixels at once using SSE2 or NEON (unless WLED_COLOR_NO_SIMD is defined); results are identical to calling
+ * single pixel function for each pixel
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if !defined(ARDUINO) && !defined(WLED_COLOR_NO_SIMD) && defined(__SSE2__)
+  #include <emmintrin.h>
+  #define WLED_COLOR_SSE2   // native build on x86
+#elif !defined(ARDUINO) && !defined(WLED_COLOR_NO_SIMD) && defined(__ARM_NEON)
+  #include <arm_neon.h>
+  #define WLED_COLOR_NEON   // native build on ARM
+#endif
+
+// fast scaling function for colors, performs color*scale/256 for all four channels, speed over accuracy
+// note: inlining uses less code than actual function calls
+static inline uint32_t fast_color_scale(const uint32_t c, const uint8_t scale) {
+  uint32_t rb = (((c     & 0x00FF00FF) * scale) >> 8) &  0x00FF00FF;
+  uint32_t wg = (((c>>8) & 0x00FF00FF) * scale)       & ~0x00FF00FF;
+  return rb | wg;
+}
+
+// per-channel saturating add (same as color_add() without color ratio preservation)
+static inline uint32_t color_add_saturate(uint32_t c1, uint32_t c2) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  uint32_t rb = ( c1     & TWO_CHANNEL_MASK) + ( c2     & TWO_CHANNEL_MASK);
+  uint32_t wg = ((c1>>8) & TWO_CHANNEL_MASK) + ((c2>>8) & TWO_CHANNEL_MASK);
+  rb |= ((rb & 0x01000100) - ((rb >> 8) & 0x00010001)) & TWO_CHANNEL_MASK;
+  wg |= ((wg & 0x01000100) - ((wg >> 8) & 0x00010001)) & TWO_CHANNEL_MASK;
+  return (rb & TWO_CHANNEL_MASK) | ((wg & TWO_CHANNEL_MASK) << 8);
+}
+
+// fast_color_scale() each pixel
+inline void color_scale_span(uint32_t *buf, size_t n, uint8_t scale) {
+  size_t i = 0;
+#if defined(WLED_COLOR_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i mul  = _mm_set1_epi16(scale);
+  for (; i + 4 <= n; i += 4) {
+    __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i));
+    __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), mul), 8);
+    __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), mul), 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf + i), _mm_packus_epi16(lo, hi));
+  }
+#elif defined(WLED_COLOR_NEON)
+  const uint16x8_t mul = vdupq_n_u16(scale);
+  for (; i + 4 <= n; i += 4) {
+    uint8x16_t px = vreinterpretq_u8_u32(vld1q_u32(buf + i));
+    uint8x8_t  lo = vshrn_n_u16(vmulq_u16(vmovl_u8(vget_low_u8(px)),  mul), 8);
+    uint8x8_t  hi = vshrn_n_u16(vmulq_u16(vmovl_u8(vget_high_u8(px)), mul), 8);
+    vst1q_u32(buf + i, vreinterpretq_u32_u8(vcombine_u8(lo, hi)));
+  }
+#endif
+  for (; i < n; i++) buf[i] = fast_color_scale(buf[i], scale);
+}
+
+// color_fade() each pixel: scales channels by (amount+1)/256, video mode scales by amount/256 and keeps channels
+// that were lit (unless they are below 1/32 of the dominant RGB channel) at least 1
+inline void color_fade_span(uint32_t *buf, size_t n, uint8_t amount, bool video = false) {
+  if (amount == 255) return; // no change
+  if (!video) { color_scale_span(buf, n, amount + 1U); return; } // amount 0 gives black, same as color_fade()
+  for (size_t i = 0; i < n; i++) {
+    const uint32_t c = buf[i];
+    if (c == 0) continue;
+    const unsigned r = (c >> 16) & 0xFF, g = (c >> 8) & 0xFF, b = c & 0xFF;
+    const unsigned maxc = r > g ? (r > b ? r : b) : (g > b ? g : b);
+    uint32_t addRemains = (r && (r<<5) > maxc) ? 0x00010000 : 0;
+    addRemains |= (g && (g<<5) > maxc) ? 0x00000100 : 0;
+    addRemains |= (b && (b<<5) > maxc) ? 0x00000001 : 0;
+    addRemains |= (c >> 24) ? 0x01000000 : 0;
+    buf[i] = amount ? fast_color_scale(c, amount) + addRemains : 0;
+  }
+}
+
+// color_blend() each pixel with c
+inline void color_blend_span(uint32_t *buf, size_t n, uint32_t c, uint8_t blend) {
+  // color_blend() computes (c1 * (256 - blend) + c2 * (blend + 1)) >> 8 for each channel, c2 part is constant for the span
+  const unsigned keep = 256U - blend;
+  size_t i = 0;
+#if defined(WLED_COLOR_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i mul  = _mm_set1_epi16(keep);
+  const __m128i cc   = _mm_unpacklo_epi8(_mm_set1_epi32(c), zero);
+  const __m128i add  = _mm_mullo_epi16(cc, _mm_set1_epi16(blend + 1U)); // sum of both terms is at most 255*257 (fits 16 bit)
+  for (; i + 4 <= n; i += 4) {
+    __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + i));
+    __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(px, zero), mul), add), 8);
+    __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(px, zero), mul), add), 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf + i), _mm_packus_epi16(lo, hi));
+  }
+#elif defined(WLED_COLOR_NEON)
+  const uint16x8_t mul = vdupq_n_u16(keep);
+  const uint16x8_t add = vmulq_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(c))), vdupq_n_u16(blend + 1U));
+  for (; i + 4 <= n; i += 4) {
+    uint8x16_t px = vreinterpretq_u8_u32(vld1q_u32(buf + i));
+    uint8x8_t  lo = vshrn_n_u16(vmlaq_u16(add, vmovl_u8(vget_low_u8(px)),  mul), 8);
+    uint8x8_t  hi = vshrn_n_u16(vmlaq_u16(add, vmovl_u8(vget_high_u8(px)), mul), 8);
+    vst1q_u32(buf + i, vreinterpretq_u32_u8(vcombine_u8(lo, hi)));
+  }
+#endif
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  const uint32_t rb2 = ( c       & TWO_CHANNEL_MASK) * (blend + 1U);
+  const uint32_t wg2 = ((c >> 8) & TWO_CHANNEL_MASK) * (blend + 1U);
+  for (; i < n; i++) {
+    const uint32_t c1 = buf[i];
+    uint32_t rb = (((c1      & TWO_CHANNEL_MASK) * keep + rb2) >> 8) &  TWO_CHANNEL_MASK;
+    uint32_t wg = (((c1 >> 8) & TWO_CHANNEL_MASK) * keep + wg2)       & ~TWO_CHANNEL_MASK;
+    buf[i] = rb | wg;
+  }
+}
+
+// color_add() (without color ratio preservation) each pixel of src to dst
+inline void color_add_span(uint32_t *dst, const uint32_t *src, size_t n) {
+  size_t i = 0;
+#if defined(WLED_COLOR_SSE2)
+  for (; i + 4 <= n; i += 4) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_adds_epu8(a, b));
+  }
+#elif defined(WLED_COLOR_NEON)
+  for (; i + 4 <= n; i += 4) {
+    uint8x16_t a = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+    uint8x16_t b = vreinterpretq_u8_u32(vld1q_u32(src + i));
+    vst1q_u32(dst + i, vreinterpretq_u32_u8(vqaddq_u8(a, b)));
+  }
+#endif
+  for (; i < n; i++) dst[i] = color_add_saturate(dst[i], src[i]);
+}
+
+// used by Segment::fade_out(): each channel moves towards target by (target - channel) * rate / 256 (but at least by 1)
+// rate is 1-256, both channel directions are handled at once using masks of lanes where target >= channel
+inline void color_fade_out_span(uint32_t *buf, size_t n, uint32_t target, unsigned rate) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  const uint32_t LANE_CARRY       = 0x01000100; // 9th bit of each lane
+  const uint32_t LANE_ONE         = 0x00010001;
+  const uint32_t t[2] = { target & TWO_CHANNEL_MASK, (target >> 8) & TWO_CHANNEL_MASK };
+  for (size_t i = 0; i < n; i++) {
+    const uint32_t color = buf[i];
+    if (color == target) continue; // already at target color
+    uint32_t result = 0;
+    for (unsigned k = 0; k < 2; k++) {
+      const uint32_t c  = (color >> (8*k)) & TWO_CHANNEL_MASK;
+      const uint32_t up = ((((t[k] | LANE_CARRY) - c) >> 8) & LANE_ONE) * 0xFF;  // 0xFF in lanes where target >= channel
+      const uint32_t d  = ((((t[k] | LANE_CARRY) - c) & up) | (((c | LANE_CARRY) - t[k]) & ~up)) & TWO_CHANNEL_MASK; // |target - channel|
+      uint32_t step = ((d * rate) >> 8) & TWO_CHANNEL_MASK;
+      step |= (((d + TWO_CHANNEL_MASK) >> 8) & LANE_ONE) & ~(((step + TWO_CHANNEL_MASK) >> 8) & LANE_ONE); // at least 1 if not at target
+      const uint32_t lane = (((c + step) & up) | (((c | LANE_CARRY) - step) & ~up)) & TWO_CHANNEL_MASK;
+      result |= lane << (8*k);
+    }
+    buf[i] = result;
+  }
+}
+
+// 1D blur (FastLED blur1d) of n pixels that are stride apart: each pixel keeps keep/256 of its color and spreads seep/256 to each neighbour
+inline void color_blur_span(uint32_t *buf, size_t n, size_t stride, uint8_t keep, uint8_t seep) {
+  if (n == 0) return;
+  // handle first pixel to avoid conditional in loop (faster)
+  uint32_t cur = buf[0];
+  uint32_t carryover = fast_color_scale(cur, seep);
+  buf[0] = fast_color_scale(cur, keep);
+  uint32_t *prev = buf;
+  for (size_t i = 1; i < n; i++) {
+    uint32_t *p = prev + stride;
+    cur = *p;
+    uint32_t part = fast_color_scale(cur, seep);
+    *prev = color_add_saturate(*prev, part);                          // previous pixel
+    *p    = color_add_saturate(fast_color_scale(cur, keep), carryover); // current pixel
+    carryover = part;
+    prev = p;
+  }
+}
+
+#endif
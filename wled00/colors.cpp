@@ -53,7 +53,8 @@ uint32_t WLED_O2_ATTR color_add(uint32_t c1, uint32_t c2, bool preserveCR) //121
     // example without overflow: input: 0x007F007F -> (0x00000000 - 0x00000000) = 0x00000000 -> input|0x00000000 = input  (no change)
     rb |= ((rb & 0x01000100) - ((rb >> 8) & 0x00010001)) & 0x00FF00FF;
     wg |= ((wg & 0x01000100) - ((wg >> 8) & 0x00010001)) & 0x00FF00FF;
-    wg <<= 8; // restore WG position
+    rb &= TWO_CHANNEL_MASK;  // clear 9th bit so it does not leak into neighbouring channel
+    wg = (wg & TWO_CHANNEL_MASK) << 8; // restore WG position
   }
   return rb | wg;
 }
@@ -580,6 +581,7 @@ uint16_t approximateKelvinFromRGB(uint32_t rgb) {
 // gamma lookup tables used for color correction (filled on 1st use (cfg.cpp & set.cpp))
 uint8_t NeoGammaWLEDMethod::gammaT[256];
 uint8_t NeoGammaWLEDMethod::gammaT_inv[256];
+uint16_t NeoGammaWLEDMethod::gammaT16[256];
 
 // re-calculates & fills gamma tables
 void NeoGammaWLEDMethod::calcGammaTable(float gamma)
@@ -587,11 +589,13 @@ void NeoGammaWLEDMethod::calcGammaTable(float gamma)
   float gamma_inv = 1.0f / gamma; // inverse gamma
   for (size_t i = 1; i < 256; i++) {
     gammaT[i] = (int)(powf((float)i / 255.0f, gamma) * 255.0f + 0.5f);
+    gammaT16[i] = (int)(powf((float)i / 255.0f, gamma) * 65535.0f + 0.5f);
     gammaT_inv[i] = (int)(powf(((float)i - 0.5f) / 255.0f, gamma_inv) * 255.0f + 0.5f);
     //DEBUG_PRINTF_P(PSTR("gammaT[%d] = %d gammaT_inv[%d] = %d\n"), i, gammaT[i], i, gammaT_inv[i]);
   }
   gammaT[0] = 0;
   gammaT_inv[0] = 0;
+  gammaT16[0] = 0;
 }
 
 uint8_t NeoGammaWLEDMethod::Correct(uint8_t value)
@@ -7,6 +7,7 @@
  */
 #include <vector>
 #include "FastLED.h"
+#include "color_span.h" // span variants of color functions, fast_color_scale()
 
 #define ColorFromPalette ColorFromPaletteWLED // override fastled version
 
@@ -99,6 +100,7 @@ class NeoGammaWLEDMethod {
     [[gnu::hot]] static uint32_t inverseGamma32(uint32_t color);    // apply inverse Gamma to RGBW32 color
     static void calcGammaTable(float gamma);                        // re-calculates & fills gamma tables
     static inline uint8_t rawGamma8(uint8_t val) { return gammaT[val]; }  // get value from Gamma table (WLED specific, not used by NPB)
+    static inline uint16_t rawGamma16(uint8_t val) { return gammaT16[val]; } // get 16 bit value from Gamma table (for high bit depth output)
     static inline uint8_t rawInverseGamma8(uint8_t val) { return gammaT_inv[val]; }  // get value from inverse Gamma table (WLED specific, not used by NPB)
     static inline uint32_t Correct32(uint32_t color) { // apply Gamma to RGBW32 color (WLED specific, not used by NPB)
       if (!gammaCorrectCol) return color; // no gamma correction
@@ -109,9 +111,11 @@ class NeoGammaWLEDMethod {
   private:
     static uint8_t gammaT[];
     static uint8_t gammaT_inv[];
+    static uint16_t gammaT16[];
 };
 #define gamma32(c) NeoGammaWLEDMethod::Correct32(c)
 #define gamma8(c)  NeoGammaWLEDMethod::rawGamma8(c)
+#define gamma16(c) NeoGammaWLEDMethod::rawGamma16(c)
 #define gamma32inv(c) NeoGammaWLEDMethod::inverseGamma32(c)
 #define gamma8inv(c)  NeoGammaWLEDMethod::rawInverseGamma8(c)
 [[gnu::hot, gnu::pure]] uint32_t color_blend(uint32_t c1, uint32_t c2 , uint8_t blend);
@@ -140,14 +144,6 @@ uint32_t colorBalanceFromKelvin(uint16_t kelvin, uint32_t rgb);
 uint16_t approximateKelvinFromRGB(uint32_t rgb);
 void setRandomColor(byte* rgb);
 
-// fast scaling function for colors, performs color*scale/256 for all four channels, speed over accuracy
-// note: inlining uses less code than actual function calls
-static inline uint32_t fast_color_scale(const uint32_t c, const uint8_t scale) {
-  uint32_t rb = (((c     & 0x00FF00FF) * scale) >> 8) &  0x00FF00FF;
-  uint32_t wg = (((c>>8) & 0x00FF00FF) * scale)       & ~0x00FF00FF;
-  return rb | wg;
-}
-
 // palettes
 extern const TProgmemRGBPalette16* const fastledPalettes[];
 extern const uint8_t* const gGradientPalettes[];
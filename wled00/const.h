@@ -441,6 +441,21 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 #define ERR_OVERCURRENT 31  // An attached current sensor has measured a current above the threshold (not implemented)
 #define ERR_UNDERVOLT   32  // An attached voltmeter has measured a voltage below the threshold (not implemented)
 
+// Boot phases (index into bootTimes[])
+#define BOOT_PHASE_FS       0  // mount filesystem, boot loop detection, presets file
+#define BOOT_PHASE_CONFIG   1  // verify and apply configuration
+#define BOOT_PHASE_STRIP    2  // strip and bus initialisation
+#define BOOT_PHASE_USERMODS 3  // usermod setup
+#define BOOT_PHASE_SERVICES 4  // WiFi, web server, IR, DMX etc.
+#define BOOT_PHASE_LIGHT    5  // first frame shown (time since power-up)
+#define BOOT_PHASE_SETUP    6  // setup completed (time since power-up)
+#define BOOT_PHASES         7
+
+// Boot stages (early output mode defers parts of setup() to loop())
+#define BOOT_STAGE_DONE     0
+#define BOOT_STAGE_USERMODS 1  // usermod setup pending
+#define BOOT_STAGE_SERVICES 2  // network and interfaces setup pending
+
 // Timer mode types
 #define NL_MODE_SET               0            //After nightlight time elapsed, set to target brightness
 #define NL_MODE_FADE              1            //Fade to target brightness gradually
@@ -12,59 +12,72 @@
 
 #ifdef WLED_ENABLE_DMX
 
+#define DMX_UNIVERSE_SIZE 512
+#define DMX_CH_FIXED      0xFF // channel program entry that outputs a constant (incl. shutter) instead of a color channel
+
+// fixture map compiled into a channel program (one entry per fixture channel), see compileDMXOutput()
+static uint8_t  dmxShift[15];          // bit shift of color channel in 32 bit color or DMX_CH_FIXED
+static uint8_t  dmxFixed[15];          // value of fixed channels
+static uint16_t dmxShutterMask = 0;    // fixed channels that output brightness
+static uint8_t  dmxChannels = 0;       // channels per fixture
+static uint16_t dmxMaxFixtures = 0;    // number of fixtures that fit into the universe
+static uint8_t  dmxUniverse[DMX_UNIVERSE_SIZE];
+
+// call whenever DMX output settings change
+void compileDMXOutput()
+{
+  dmxChannels = std::min((unsigned)DMXChannels, 15U);
+  dmxShutterMask = 0;
+  for (unsigned j = 0; j < 15; j++) {
+    dmxShift[j] = DMX_CH_FIXED;
+    dmxFixed[j] = 0;
+    switch (DMXFixtureMap[j]) {
+      case 1: dmxShift[j] = 16; break;  // Red
+      case 2: dmxShift[j] =  8; break;  // Green
+      case 3: dmxShift[j] =  0; break;  // Blue
+      case 4: dmxShift[j] = 24; break;  // White
+      case 5: if (j < dmxChannels) dmxShutterMask |= 1 << j; break; // Shutter channel. Controls the brightness.
+      case 6: dmxFixed[j] = 255; break; // Sets this channel to 255. Like 0, but more wholesome.
+      default: break;                   // Set this channel to 0. Good way to tell strobe- and fade-functions to fuck right off.
+    }
+  }
+  // fixtures must not exceed last channel
+  unsigned first = std::max((int)DMXStart, 1) - 1;
+  if (first + dmxChannels > DMX_UNIVERSE_SIZE) dmxMaxFixtures = 0;
+  else if (DMXGap == 0)                        dmxMaxFixtures = UINT16_MAX; // all fixtures share the same channels
+  else dmxMaxFixtures = (DMX_UNIVERSE_SIZE - first - dmxChannels) / DMXGap + 1;
+}
+
 void handleDMXOutput()
 {
   // don't act, when in DMX Proxy mode
   if (e131ProxyUniverse != 0) return;
 
+  // scale colors by brightness if no shutter channel is set (lookup table replaces division by 255)
+  static uint8_t briLUT[256];
+  static int lutBri = -1;
   uint8_t brightness = strip.getBrightness();
+  uint8_t scale = dmxShutterMask ? 255 : brightness;
+  if (lutBri != scale) {
+    for (unsigned v = 0; v < 256; v++) briLUT[v] = (v * scale) / 255;
+    lutBri = scale;
+  }
+  uint8_t fixed[15];
+  for (unsigned j = 0; j < dmxChannels; j++) fixed[j] = (dmxShutterMask & (1 << j)) ? brightness : dmxFixed[j];
 
-  bool calc_brightness = true;
-
-   // check if no shutter channel is set
-   for (unsigned i = 0; i < DMXChannels; i++)
-   {
-     if (DMXFixtureMap[i] == 5) calc_brightness = false;
-   }
-
-  uint16_t len = strip.getLengthTotal();
-  for (int i = DMXStartLED; i < len; i++) {        // uses the amount of LEDs as fixture count
-
-    uint32_t in = strip.getPixelColor(i);     // get the colors for the individual fixtures as suggested by Aircoookie in issue #462
-    byte w = W(in);
-    byte r = R(in);
-    byte g = G(in);
-    byte b = B(in);
-
-    int DMXFixtureStart = DMXStart + (DMXGap * (i - DMXStartLED));
-    for (int j = 0; j < DMXChannels; j++) {
-      int DMXAddr = DMXFixtureStart + j;
-      switch (DMXFixtureMap[j]) {
-        case 0:        // Set this channel to 0. Good way to tell strobe- and fade-functions to fuck right off.
-          dmx.write(DMXAddr, 0);
-          break;
-        case 1:        // Red
-          dmx.write(DMXAddr, calc_brightness ? (r * brightness) / 255 : r);
-          break;
-        case 2:        // Green
-          dmx.write(DMXAddr, calc_brightness ? (g * brightness) / 255 : g);
-          break;
-        case 3:        // Blue
-          dmx.write(DMXAddr, calc_brightness ? (b * brightness) / 255 : b);
-          break;
-        case 4:        // White
-          dmx.write(DMXAddr, calc_brightness ? (w * brightness) / 255 : w);
-          break;
-        case 5:        // Shutter channel. Controls the brightness.
-          dmx.write(DMXAddr, brightness);
-          break;
-        case 6:        // Sets this channel to 255. Like 0, but more wholesome.
-          dmx.write(DMXAddr, 255);
-          break;
-      }
+  // whole universe is produced in a single pass, channels not used by fixtures are 0
+  memset(dmxUniverse, 0, sizeof(dmxUniverse));
+  unsigned len = strip.getLengthTotal();
+  unsigned fixtures = len > DMXStartLED ? std::min(len - DMXStartLED, (unsigned)dmxMaxFixtures) : 0; // uses the amount of LEDs as fixture count
+  uint8_t *out = dmxUniverse + std::max((int)DMXStart, 1) - 1;
+  for (unsigned i = 0; i < fixtures; i++, out += DMXGap) {
+    uint32_t in = strip.getPixelColor(DMXStartLED + i); // get the colors for the individual fixtures as suggested by Aircoookie in issue #462
+    for (unsigned j = 0; j < dmxChannels; j++) {
+      out[j] = dmxShift[j] == DMX_CH_FIXED ? fixed[j] : briLUT[(in >> dmxShift[j]) & 0xFF];
     }
   }
 
+  dmx.write(1, dmxUniverse, DMX_UNIVERSE_SIZE);
   dmx.update();        // update the DMX bus
 }
 
@@ -74,8 +87,10 @@ void initDMXOutput() {
  #else
   dmx.initWrite(512);  // initialize with bus length
  #endif
+  compileDMXOutput();
 }
 #else
 void initDMXOutput(){}
 void handleDMXOutput() {}
+void compileDMXOutput() {}
 #endif
@@ -31,6 +31,8 @@ bool configBackupExists();
 void resetConfig();
 bool deserializeConfig(JsonObject doc, bool fromFS = false);
 bool deserializeConfigFromFS();
+bool configSnapshotValid();
+void removeConfigSnapshot();
 bool deserializeConfigSec();
 void serializeConfig(JsonObject doc);
 void serializeConfigToFS();
@@ -77,6 +79,7 @@ typedef struct WiFiConfig {
 //dmx_output.cpp
 void initDMXOutput();
 void handleDMXOutput();
+void compileDMXOutput();
 
 //dmx_input.cpp
 void initDMXInput();
@@ -221,13 +224,16 @@ const char *getPresetsFileName(bool persistent = true);
 bool presetNeedsSaving();
 void initPresetsFile();
 void handlePresets();
+void finishBootPreset(const uint32_t *knownEffects);
 bool applyPreset(byte index, byte callMode = CALL_MODE_DIRECT_CHANGE);
 bool applyPresetFromPlaylist(byte index);
+bool applyPresetFromBuffer(byte index, const uint8_t *data, size_t len);
 void applyPresetWithFallback(uint8_t presetID, uint8_t callMode, uint8_t effectID = 0, uint8_t paletteID = 0);
 inline bool applyTemporaryPreset() {return applyPreset(255);};
 void savePreset(byte index, const char* pname = nullptr, JsonObject saveobj = JsonObject());
 inline void saveTemporaryPreset() {savePreset(255);};
 void deletePreset(byte index);
+void presetsChanged();
 bool getPresetName(byte index, String& name);
 
 //remote.cpp
@@ -245,6 +251,7 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
+void handleFrameSync();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
 void refreshNodeList();
 void sendSysInfoUDP();
@@ -399,6 +406,7 @@ void releaseJSONBufferLock();
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen);
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var = nullptr);
 int16_t extractModeDefaults(uint8_t mode, const char *segVar);
+int16_t parseModeDefault(const char *defaults, const char *segVar);
 void checkSettingsPIN(const char *pin);
 uint16_t crc16(const unsigned char* data_p, size_t length);
 String computeSHA1(const String& input);
@@ -421,20 +429,30 @@ uint8_t perlin8(uint16_t x);
 uint8_t perlin8(uint16_t x, uint16_t y);
 uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z);
 
+#include "segment_random.h" // prng32() of seeded segments
 // fast (true) random numbers using hardware RNG, all functions return values in the range lowerlimit to upperlimit-1
 // note: for true random numbers with high entropy, do not call faster than every 200ns (5MHz)
 // tests show it is still highly random reading it quickly in a loop (better than fastled PRNG)
 // for 8bit and 16bit random functions: no limit check is done for best speed
 // 32bit inputs are used for speed and code size, limits don't work if inverted or out of range
 // inlining does save code size except for random(a,b) and 32bit random with limits
+// while an effect of a seeded segment runs, its FX worker draws from the segment's per-frame PRNG instead (see WS2812FX::runEffect())
+// the PRNG is bound to the task running the effect: other tasks on the same core (async web server, audio) keep using hardware RNG
+typedef struct {
+  const void *task;  // task that bound the state
+  uint32_t   *state; // nullptr = hardware RNG
+} hw_random_t;
+extern hw_random_t hwRandomState[];        // per FX worker
+inline unsigned fxWorkerId();              // FX.h
+inline const void *fxTaskId();             // FX.h
 #define random hw_random // replace arduino random()
-inline uint32_t hw_random() { return HW_RND_REGISTER; };
+inline uint32_t hw_random() { const hw_random_t &r = hwRandomState[fxWorkerId()]; return (r.state && r.task == fxTaskId()) ? prng32(*r.state) : HW_RND_REGISTER; };
 uint32_t hw_random(uint32_t upperlimit); // not inlined for code size
 int32_t hw_random(int32_t lowerlimit, int32_t upperlimit);
-inline uint16_t hw_random16() { return HW_RND_REGISTER; };
+inline uint16_t hw_random16() { return hw_random(); };
 inline uint16_t hw_random16(uint32_t upperlimit) { return (hw_random16() * upperlimit) >> 16; }; // input range 0-65535 (uint16_t)
 inline int16_t hw_random16(int32_t lowerlimit, int32_t upperlimit) { int32_t range = upperlimit - lowerlimit; return lowerlimit + hw_random16(range); }; // signed limits, use int16_t ranges
-inline uint8_t hw_random8() { return HW_RND_REGISTER; };
+inline uint8_t hw_random8() { return hw_random(); };
 inline uint8_t hw_random8(uint32_t upperlimit) { return (hw_random8() * upperlimit) >> 8; }; // input range 0-255
 inline uint8_t hw_random8(uint32_t lowerlimit, uint32_t upperlimit) { uint32_t range = upperlimit - lowerlimit; return lowerlimit + hw_random8(range); }; // input range 0-255
 
@@ -541,6 +559,8 @@ uint32_t sqrt32_bw(uint32_t x);
 //wled_serial.cpp
 void handleSerial();
 void updateBaudRate(uint32_t rate);
+unsigned getSerialFps();
+unsigned getSerialDropped();
 
 //wled_server.cpp
 void initServer();
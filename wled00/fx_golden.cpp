@@ -0,0 +1,228 @@
+#include "wled.h"
+
+#ifdef WLED_ENABLE_FX_GOLDEN
+
+/*
+ * Golden image regression test for effects (development aid, enable with -D WLED_ENABLE_FX_GOLDEN)
+ * This runs on the device: it records golden hashes with a known good build and reports failures of a later build
+ * through the JSON API, it is not part of the host (pio test -e native) tests.
+ *
+ * Every effect is rendered for a fixed number of frames with fixed strip.now steps, a fixed segment seed
+ * and fixed gamma on several 1D (and, if a matrix is configured, 2D) segment geometries. A hash of each
+ * composited (gamma corrected) frame is compared against a golden file recorded on a known good build.
+ * Use it to make sure that optimizations of Segment::setPixelColor(), blendSegment(), the particle system,
+ * etc. do not change effect output.
+ *
+ * JSON API: {"fxgolden":1} records /fxgolden.bin, {"fxgolden":0} compares against it; results are in info.fxgolden
+ * ("skipped" counts effect/geometry combinations that were not recorded or compared)
+ * Effects that do not render identical frames twice in a row (i.e. using millis() instead of strip.now)
+ * are marked as unstable when recording and are skipped when comparing. Audio reactive effects and 2D only effects
+ * on 1D geometries (see effect descriptor flags) are not tested.
+ */
+
+#ifndef WLED_FX_GOLDEN_FRAMES
+  #define WLED_FX_GOLDEN_FRAMES 16
+#endif
+#ifndef WLED_FX_GOLDEN_STEP
+  #define WLED_FX_GOLDEN_STEP 42          // ms between frames (~24 FPS)
+#endif
+#define FX_GOLDEN_EPOCH   100000UL        // strip.now of first frame
+#define FX_GOLDEN_SEED    0x5EED          // segment seed (see WS2812FX::runEffect())
+#define FX_GOLDEN_VERSION 2               // 2: 32 bit hashes
+
+static const char _goldenFile[] PROGMEM = "/fxgolden.bin";
+static const char _goldenTemp[] PROGMEM = "/fxgolden.tmp"; // recorded file replaces golden file only when complete
+
+typedef struct GoldenHeader {
+  char     magic[4];                      // "WFXG"
+  uint8_t  version;
+  uint8_t  frames;
+  uint8_t  geometries;
+  uint8_t  modes;
+  uint16_t length;                        // strip length the file was recorded with
+  uint16_t step;                          // strip.now step between frames
+} golden_header_t;
+
+typedef struct GoldenGeometry {
+  bool    is2D;
+  uint8_t grouping;
+  uint8_t spacing;
+  bool    reverse;
+  bool    mirror;
+  bool    reverse_y;
+  bool    transpose;
+} golden_geometry_t;
+
+static const golden_geometry_t _goldenGeometries[] PROGMEM = {
+  // 1D
+  { false, 1, 0, false, false, false, false },
+  { false, 2, 1, false, false, false, false }, // grouping & spacing
+  { false, 1, 0, true,  false, false, false }, // reverse
+  { false, 1, 0, false, true,  false, false }, // mirror
+  // 2D (only if matrix is set up)
+  { true,  1, 0, false, false, false, false },
+  { true,  1, 0, false, false, false, true  }, // transpose
+  { true,  1, 0, true,  true,  true,  false }, // reverse & mirror & reverse Y
+  { true,  2, 0, false, false, false, false }, // grouping
+};
+
+// render one frame of the (only) test segment and return hash of the composited frame
+uint32_t WS2812FX::renderGoldenFrame(unsigned frame) {
+  Segment &seg = _segments[0];
+  now = FX_GOLDEN_EPOCH + frame * WLED_FX_GOLDEN_STEP;
+  seg.handleTransition();
+  seg.resetIfRequired();
+  renderSegment(seg, now);
+
+  const size_t totalLen = getLengthTotal();
+  for (size_t i = 0; i < totalLen; i++) _pixels[i] = BLACK;
+  blendSegment(seg);
+  uint32_t h = 2166136261U;                 // FNV-1a over pixel words
+  for (size_t i = 0; i < totalLen; i++) h = (h ^ gamma32(_pixels[i])) * 16777619U;
+  return h ? h : 1; // 0 is reserved for "not tested"
+}
+
+// renders all effects on all geometries; record == true writes golden file, otherwise compares with it
+// returns number of failing effect/geometry combinations, -1 if golden file is missing or does not match the setup
+int WS2812FX::runGoldenTest(bool record) {
+  if (!_pixels || _modeCount == 0) return -1;
+
+  golden_header_t hdr;
+  memcpy_P(hdr.magic, PSTR("WFXG"), 4);
+  hdr.version    = FX_GOLDEN_VERSION;
+  hdr.frames     = WLED_FX_GOLDEN_FRAMES;
+  hdr.geometries = isMatrix ? 8 : 4;
+  hdr.modes      = _modeCount;
+  hdr.length     = getLengthTotal();
+  hdr.step       = WLED_FX_GOLDEN_STEP;
+
+  char fileName[16];
+  strcpy_P(fileName, record ? _goldenTemp : _goldenFile);
+  File f = WLED_FS.open(fileName, record ? "w" : "r");
+  if (!f) return -1;
+  if (!record) {
+    golden_header_t fhdr;
+    if (f.read((uint8_t*)&fhdr, sizeof(fhdr)) != sizeof(fhdr) || memcmp(&fhdr, &hdr, sizeof(hdr)) != 0) {
+      DEBUG_PRINTLN(F("FX golden: file does not match current setup, record it again."));
+      f.close();
+      return -1;
+    }
+  } else if (f.write((const uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr)) {
+    f.close();
+    WLED_FS.remove(fileName); // FS full
+    return -1;
+  }
+
+  // stop effect rendering (service() and FX worker) before segments are swapped out
+  const bool wasSuspended = isSuspended();
+  suspend();
+  waitForIt();
+
+  // park current state
+  std::vector<Segment> saved;
+  saved.swap(_segments);
+  const unsigned long savedNow = now, savedTimebase = timebase;
+  const uint16_t savedTransition = _transitionDur;
+  const uint8_t  savedMainSegment = _mainSegment;
+  const uint8_t  savedBlendingStyle = blendingStyle;
+  const bool     savedGammaCol = gammaCorrectCol;
+  const CRGBPalette16 savedRandomPalette = Segment::_randomPalette, savedNewRandomPalette = Segment::_newRandomPalette;
+  _transitionDur = 0;
+  _mainSegment = 0;
+  blendingStyle = BLEND_STYLE_FADE;
+  gammaCorrectCol = true;
+  NeoGammaWLEDMethod::calcGammaTable(2.2f);
+  timebase = 0;
+
+  int failed = 0;
+  unsigned unstable = 0;
+  unsigned skipped = 0;
+  uint32_t hash[WLED_FX_GOLDEN_FRAMES];
+  uint32_t golden[WLED_FX_GOLDEN_FRAMES];
+  for (unsigned g = 0; g < hdr.geometries; g++) {
+    golden_geometry_t geo;
+    memcpy_P(&geo, &_goldenGeometries[g], sizeof(geo));
+    const unsigned w = geo.is2D ? std::min<unsigned>(Segment::maxWidth, 16) : std::min<unsigned>(Segment::maxWidth, 64);
+    const unsigned h = geo.is2D ? std::min<unsigned>(Segment::maxHeight, 16) : 1;
+    for (unsigned id = 0; id < _modeCount; id++) {
+      const uint8_t flags = getModeFlags(id);
+      bool skip = (flags & FX_INFO_RESERVED) || id == FX_MODE_IMAGE      // image effect depends on files
+               || (flags & (FX_INFO_VOLUME | FX_INFO_FREQ))              // (simulated) sound depends on millis()
+               || (!geo.is2D && (flags & FX_INFO_2D) && !(flags & FX_INFO_1D)); // 2D only effect on 1D segment
+      for (unsigned pass = 0; pass < (record ? 2 : 1); pass++) {
+        // fresh segment for every run so that effect data and call counter start from scratch
+        Segment::_randomPalette = Segment::_newRandomPalette = CRGBPalette16(CRGB::Red, CRGB::Green, CRGB::Blue, CRGB::White);
+        _segments.clear();
+        _segments.emplace_back(0, w, 0, h);
+        Segment &seg = _segments[0];
+        if (!seg.isActive()) { failed = -1; break; }
+        if (!skip) seg.setMode(id, true);
+        seg.setGeometry(0, w, geo.grouping, geo.spacing, 0, 0, h, seg.map1D2D);
+        seg.reverse   = geo.reverse;
+        seg.mirror    = geo.mirror;
+        seg.reverse_y = geo.reverse_y;
+        seg.transpose = geo.transpose;
+        seg.seed      = FX_GOLDEN_SEED;
+        for (unsigned i = 0; i < WLED_FX_GOLDEN_FRAMES && !skip; i++) {
+          uint32_t crc = renderGoldenFrame(i);
+          if (pass == 0) hash[i] = crc;
+          else if (hash[i] != crc) { skip = true; unstable++; DEBUG_PRINTF_P(PSTR("FX golden: %u unstable (geometry %u)\n"), id, g); }
+          yield();
+        }
+      }
+      if (failed < 0) break;
+      if (skip) memset(hash, 0, sizeof(hash)); // all zero: not tested
+
+      if (record) {
+        if (f.write((const uint8_t*)hash, sizeof(hash)) != sizeof(hash)) { failed = -1; break; } // FS full
+        if (skip) skipped++;
+      } else {
+        if (f.read((uint8_t*)golden, sizeof(golden)) != sizeof(golden)) { failed = -1; break; } // truncated file
+        bool tested = false;
+        for (unsigned i = 0; i < WLED_FX_GOLDEN_FRAMES; i++) tested |= golden[i] != 0;
+        // golden hashes of unstable, reserved or excluded effects are all zero
+        if (!tested) skipped++;
+        else for (unsigned i = 0; i < WLED_FX_GOLDEN_FRAMES; i++) if (hash[i] != golden[i]) {
+          DEBUG_PRINTF_P(PSTR("FX golden: %u FAILED (geometry %u, frame %u)\n"), id, g, i);
+          failed++;
+          break;
+        }
+      }
+      #if WLED_WATCHDOG_TIMEOUT > 0 && defined(ARDUINO_ARCH_ESP32)
+      esp_task_wdt_reset(); // this takes a while
+      #endif
+    }
+    if (failed < 0) break;
+  }
+  f.close();
+  if (record) {
+    // replace golden file only with a complete recording
+    char goldenName[16];
+    strcpy_P(goldenName, _goldenFile);
+    if (failed >= 0) {
+      WLED_FS.remove(goldenName);
+      if (!WLED_FS.rename(fileName, goldenName)) failed = -1;
+    }
+    if (failed < 0) WLED_FS.remove(fileName);
+  }
+  DEBUG_PRINTF_P(PSTR("FX golden: %s, %d failed, %u skipped (%u unstable)\n"), record ? "recorded" : "compared", failed, skipped, unstable);
+
+  // restore
+  _segments.clear();
+  _segments.swap(saved);
+  now = savedNow;
+  timebase = savedTimebase;
+  _transitionDur = savedTransition;
+  _mainSegment = savedMainSegment;
+  blendingStyle = savedBlendingStyle;
+  gammaCorrectCol = savedGammaCol;
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal);
+  Segment::_randomPalette = savedRandomPalette;
+  Segment::_newRandomPalette = savedNewRandomPalette;
+  fxGoldenSkipped = skipped;
+  if (!wasSuspended) resume();
+  trigger();
+  return failed;
+}
+
+#endif
@@ -281,7 +281,9 @@ static bool deserializeSegment(JsonObject elem, byte it, byte presetId = 0)
   #endif
 
   byte fx = seg.mode;
-  if (getVal(elem["fx"], fx, 0, strip.getModeCount())) {
+  uint8_t fxByName = elem["fx"].is<const char*>() ? strip.getModeByName(elem["fx"].as<const char*>()) : 255; // effect may also be given by its name
+  if (fxByName < 255) fx = fxByName;
+  if (fxByName < 255 || getVal(elem["fx"], fx, 0, strip.getModeCount())) {
     if (!presetId && currentPlaylist>=0) unloadPlaylist();
     if (fx != seg.mode) seg.setMode(fx, elem[F("fxdef")]); // use transition (WARNING: may change map1D2D causing geometry change)
   }
@@ -308,6 +310,8 @@ static bool deserializeSegment(JsonObject elem, byte it, byte presetId = 0)
   getVal(elem["bm"], blend, 0, 15); // we can't pass reference to bitfield
   seg.blendMode = constrain(blend, 0, 15);
 
+  seg.seed = elem[F("seed")] | seg.seed; // 0 = hardware RNG
+
   JsonArray iarr = elem[F("i")]; //set individual LEDs
   if (!iarr.isNull()) {
     // set brightness immediately and disable transition
@@ -403,6 +407,7 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
 
   blendingStyle = root[F("bs")] | blendingStyle;
   blendingStyle &= 0x1F;
+  transitionSnapshot = root[F("snap")] | transitionSnapshot; // bit per blending style: freeze outgoing effect
 
   // temporary transition (applies only once)
   tr = root[F("tt")] | -1;
@@ -434,6 +439,9 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
   }
 
   if (root[F("psave")].isNull()) doReboot = root[F("rb")] | doReboot;
+#ifdef WLED_ENABLE_FX_GOLDEN
+  if (!root[F("fxgolden")].isNull()) fxGoldenRequest = root[F("fxgolden")].as<bool>(); // run effect golden image test in loop()
+#endif
 
   // do not allow changing main segment while in realtime mode (may get odd results else)
   if (!realtimeMode) strip.setMainSegmentId(root[F("mainseg")] | strip.getMainSegmentId()); // must be before realtimeLock() if "live"
@@ -631,6 +639,7 @@ static void serializeSegment(JsonObject& root, const Segment& seg, byte id, bool
   root["si"]  = seg.soundSim;
   root["m12"] = seg.map1D2D;
   root["bm"]  = seg.blendMode;
+  root[F("seed")] = seg.seed;
 }
 
 void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
@@ -648,6 +657,7 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
     root["ps"] = (currentPreset > 0) ? currentPreset : -1;
     root[F("pl")] = currentPlaylist;
     root[F("ledmap")] = currentLedmap;
+    root[F("snap")] = transitionSnapshot;
 
     UsermodManager::addToJsonState(root);
 
@@ -705,7 +715,29 @@ void serializeInfo(JsonObject root)
   leds[F("count")] = strip.getLengthTotal();
   leds[F("pwr")] = BusManager::currentMilliamps();
   leds["fps"] = strip.getFps();
+  leds[F("wait")] = BusManager::getShowWaitTime(); // average us a frame waits for buses to finish sending previous one
+  leds[F("drop")] = BusManager::getDroppedFrames();
   leds[F("maxpwr")] = BusManager::currentMilliamps()>0 ? BusManager::ablMilliampsMax() : 0;
+  if (BusManager::ablMilliampsPSU()) leds[F("psupwr")] = BusManager::ablMilliampsPSU();
+  if (BusManager::_useABL) {
+    // estimated current without limit (demand) vs. limited current, total and per bus
+    JsonObject abl = leds.createNestedObject(F("abl"));
+    abl[F("dem")] = BusManager::demandMilliamps();
+    if (BusManager::ablMilliampsMax() || BusManager::ablMilliampsPSU()) abl[F("avg")] = BusManager::averageMilliamps();
+    abl[F("sm")]  = BusManager::getABLSmoothing();
+    abl[F("sus")] = BusManager::getABLSustained();
+    JsonArray busABL = abl.createNestedArray(F("bus"));
+    for (size_t b = 0; b < BusManager::getNumBusses(); b++) {
+      const Bus *bus = BusManager::getBus(b);
+      if (!bus || !bus->isDigital() || !bus->isOk()) continue;
+      const BusDigital *busd = static_cast<const BusDigital*>(bus);
+      JsonObject ba = busABL.createNestedObject();
+      ba["n"]       = b;
+      ba[F("dem")]  = busd->getDemandCurrent();
+      ba[F("pwr")]  = busd->getUsedCurrent();
+      ba[F("max")]  = busd->getCurrentLimit();
+    }
+  }
   leds[F("maxseg")] = WS2812FX::getMaxSegments();
   //leds[F("actseg")] = strip.getActiveSegmentsNum();
   //leds[F("seglock")] = false; //might be used in the future to prevent modifications to segment config
@@ -716,6 +748,13 @@ void serializeInfo(JsonObject root)
     JsonObject matrix = leds.createNestedObject(F("matrix"));
     matrix["w"] = Segment::maxWidth;
     matrix["h"] = Segment::maxHeight;
+    if (strip.isCanvasTile()) {
+      JsonArray tile = matrix.createNestedArray(F("tile")); // x, y, w, h of the part of the canvas driven by this controller
+      tile.add(strip.canvasX);
+      tile.add(strip.canvasY);
+      tile.add(strip.getMatrixWidth());
+      tile.add(strip.getMatrixHeight());
+    }
   }
   #endif
 
@@ -749,6 +788,21 @@ void serializeInfo(JsonObject root)
 
   root[F("name")] = serverDescription;
   root[F("udpport")] = udpPort;
+#ifdef WLED_ENABLE_FX_GOLDEN
+  JsonObject fxg = root.createNestedObject(F("fxgolden"));
+  fxg[F("failed")]   = fxGoldenFailed;
+  fxg[F("skipped")]  = fxGoldenSkipped;
+#endif
+  if (frameSyncMode) {
+    JsonObject fsync = root.createNestedObject(F("fsync"));
+    fsync[F("mode")] = frameSyncMode;
+    fsync[F("period")] = strip.getFrameSyncPeriod(); // 0 if not locked to a leader's frame grid
+    if (frameSyncMode == 2) {
+      fsync[F("skew")] = frameSyncSkew;              // strip time error vs. leader at last packet (ms)
+      fsync[F("phase")] = strip.getFrameSyncPhase(); // last frame start after grid point (ms)
+      fsync[F("age")] = millis() - frameSyncLastRx;  // ms since last packet
+    }
+  }
   root[F("simplifiedui")] = simplifiedUI;
   root["live"] = (bool)realtimeMode;
   root[F("liveseg")] = useMainSegmentOnly ? strip.getMainSegmentId() : -1;  // if using main segment only for live
@@ -766,6 +820,11 @@ void serializeInfo(JsonObject root)
   }
 
   root[F("lip")] = realtimeIP[0] == 0 ? "" : realtimeIP.toString();
+  if (realtimeMode == REALTIME_MODE_ADALIGHT) {
+    JsonObject serial = root.createNestedObject(F("serial"));
+    serial["fps"]     = getSerialFps();
+    serial[F("drop")] = getSerialDropped(); // frames with invalid header
+  }
 
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
@@ -852,6 +911,17 @@ void serializeInfo(JsonObject root)
   #endif
   root[F("uptime")] = millis()/1000 + rolloverMillis*4294967;
 
+  JsonObject boot = root.createNestedObject(F("boot"));
+  boot[F("fs")]    = bootTimes[BOOT_PHASE_FS];
+  boot[F("cfg")]   = bootTimes[BOOT_PHASE_CONFIG];
+  boot[F("strip")] = bootTimes[BOOT_PHASE_STRIP];
+  boot[F("um")]    = bootTimes[BOOT_PHASE_USERMODS];
+  boot[F("net")]   = bootTimes[BOOT_PHASE_SERVICES];
+  boot[F("light")] = bootTimes[BOOT_PHASE_LIGHT];
+  boot[F("total")] = bootTimes[BOOT_PHASE_SETUP];
+  boot[F("snap")]  = bootFromSnapshot;
+  boot[F("early")] = earlyOutput;
+
   char time[32];
   getTimeString(time);
   root[F("time")] = time;
@@ -1056,15 +1126,11 @@ void serializeNodes(JsonObject root)
 // deserializes mode data string into JsonArray
 void serializeModeData(JsonArray fxdata)
 {
-  char lineBuffer[256];
   for (size_t i = 0; i < strip.getModeCount(); i++) {
-    strncpy_P(lineBuffer, strip.getModeData(i), sizeof(lineBuffer)/sizeof(char)-1);
-    lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-    if (lineBuffer[0] != 0) {
-      char* dataPtr = strchr(lineBuffer,'@');
-      if (dataPtr) fxdata.add(dataPtr+1);
-      else         fxdata.add("");
-    }
+    if (pgm_read_byte(strip.getModeData(i)) == 0) continue; // empty mode data
+    const char *dataPtr = strip.getModeUIData(i); // located by effect descriptor, no need to scan mode data
+    if (dataPtr) fxdata.add(FPSTR(dataPtr));
+    else         fxdata.add("");
   }
 }
 
@@ -1072,15 +1138,13 @@ void serializeModeData(JsonArray fxdata)
 // also removes effect data extensions (@...) from deserialised names
 void serializeModeNames(JsonArray arr)
 {
-  char lineBuffer[256];
+  char lineBuffer[64];
   for (size_t i = 0; i < strip.getModeCount(); i++) {
-    strncpy_P(lineBuffer, strip.getModeData(i), sizeof(lineBuffer)/sizeof(char)-1);
-    lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-    if (lineBuffer[0] != 0) {
-      char* dataPtr = strchr(lineBuffer,'@');
-      if (dataPtr) *dataPtr = 0; // terminate mode data after name
-      arr.add(lineBuffer);
-    }
+    if (pgm_read_byte(strip.getModeData(i)) == 0) continue; // empty mode data
+    size_t len = std::min((size_t)strip.getModeNameLength(i), sizeof(lineBuffer)-1); // name length is known from effect descriptor
+    strncpy_P(lineBuffer, strip.getModeData(i), len);
+    lineBuffer[len] = '\0'; // terminate string
+    arr.add(lineBuffer);
   }
 }
 
@@ -1209,7 +1273,7 @@ bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient)
 #ifndef WLED_DISABLE_2D
   if (strip.isMatrix) {
     // ignore anything behid matrix (i.e. extra strip)
-    used = Segment::maxWidth*Segment::maxHeight; // always the size of matrix (more or less than strip.getLengthTotal())
+    used = strip.getMatrixWidth()*strip.getMatrixHeight(); // always the size of (local) matrix (more or less than strip.getLengthTotal())
     n = 1;
     if (used > MAX_LIVE_LEDS) n = 2;
     if (used > MAX_LIVE_LEDS*4) n = 4;
@@ -1224,7 +1288,7 @@ bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient)
   for (size_t i = 0; i < used; i += n)
   {
 #ifndef WLED_DISABLE_2D
-    if (strip.isMatrix && n>1 && (i/Segment::maxWidth)%n) i += Segment::maxWidth * (n-1);
+    if (strip.isMatrix && n>1 && (i/strip.getMatrixWidth())%n) i += strip.getMatrixWidth() * (n-1);
 #endif
     uint32_t c = strip.getPixelColor(i);
     uint8_t r = R(c);
@@ -1240,8 +1304,8 @@ bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient)
   buf += sprintf_P(buf, PSTR("],\"n\":%d"), n);
 #ifndef WLED_DISABLE_2D
   if (strip.isMatrix) {
-    buf += sprintf_P(buf, PSTR(",\"w\":%d"), Segment::maxWidth/n);
-    buf += sprintf_P(buf, PSTR(",\"h\":%d"), Segment::maxHeight/n);
+    buf += sprintf_P(buf, PSTR(",\"w\":%d"), strip.getMatrixWidth()/n);
+    buf += sprintf_P(buf, PSTR(",\"h\":%d"), strip.getMatrixHeight()/n);
   }
 #endif
   (*buf++) = '}';
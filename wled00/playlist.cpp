@@ -4,10 +4,28 @@
  * Handles playlists, timed sequences of presets
  */
 
+// presets used by a playlist are preloaded into RAM (as MessagePack) so that steps do not need filesystem access
+#ifndef PLAYLIST_CACHE_SIZE
+  #if defined(ESP8266)
+    #define PLAYLIST_CACHE_SIZE  1024 // heap is scarce, enough for a few simple presets
+  #elif defined(BOARD_HAS_PSRAM)
+    #define PLAYLIST_CACHE_SIZE 65536
+  #else
+    #define PLAYLIST_CACHE_SIZE 16384
+  #endif
+#endif
+
+#define PL_CACHE_NONE   0 // not preloaded yet
+#define PL_CACHE_OK     1 // preloaded
+#define PL_CACHE_FS     2 // preset cannot be preloaded (nested playlist, HTTP API, too large or missing), read from FS
+
 typedef struct PlaylistEntry {
   uint8_t preset; //ID of the preset to apply
-  uint16_t dur;   //Duration of the entry (in tenths of seconds)
+  uint8_t cache;  //PL_CACHE_* state of preloaded preset
   uint16_t tr;    //Duration of the transition TO this entry (in tenths of seconds)
+  uint32_t dur;   //Duration of the entry (in ms)
+  uint8_t *data;  //preloaded preset (MessagePack), may be shared with other entries of the same preset
+  uint16_t len;   //length of preloaded preset
 } ple;
 
 static byte           playlistRepeat = 1;        //how many times to repeat the playlist (0 = infinitely)
@@ -17,7 +35,9 @@ static byte           playlistOptions = 0;       //bit 0: shuffle playlist after
 static PlaylistEntry *playlistEntries = nullptr;
 static byte           playlistLen;               //number of playlist entries
 static int8_t         playlistIndex = -1;
-static uint16_t       playlistEntryDur = 0;      //duration of the current entry in tenths of seconds
+static uint32_t       playlistEntryDur = 0;      //duration of the current entry in ms (UINT32_MAX = until advanced)
+static size_t         playlistCacheUsed = 0;     //bytes used by preloaded presets
+static uint32_t       playlistCacheGen = 0;      //presetsGeneration when presets were preloaded
 
 //values we need to keep about the parent playlist while inside sub-playlist
 static int16_t        parentPlaylistIndex = -1;
@@ -42,8 +62,68 @@ void shufflePlaylist() {
 }
 
 
+static void freePlaylistCache() {
+  if (playlistEntries == nullptr) return;
+  for (int i = 0; i < playlistLen; i++) {
+    if (playlistEntries[i].data) {
+      uint8_t *data = playlistEntries[i].data;
+      for (int j = i; j < playlistLen; j++) if (playlistEntries[j].data == data) playlistEntries[j].data = nullptr; // shared buffer
+      p_free(data);
+    }
+    playlistEntries[i].cache = PL_CACHE_NONE;
+    playlistEntries[i].len = 0;
+  }
+  playlistCacheUsed = 0;
+}
+
+// preload one preset per call (to keep loop() responsive), entries which are not (yet) preloaded are applied from FS
+static void preloadPlaylistEntry() {
+  if (playlistCacheGen != presetsGeneration) { // presets were saved or deleted, preloaded content may be stale
+    freePlaylistCache();
+    playlistCacheGen = presetsGeneration;
+  }
+  int i = 0;
+  while (i < playlistLen && playlistEntries[i].cache != PL_CACHE_NONE) i++;
+  if (i >= playlistLen || strip.isUpdating()) return; // all done or try later, accessing FS during sendout causes glitches
+  PlaylistEntry &entry = playlistEntries[i];
+
+  // entries of the same preset share preloaded data
+  for (int j = 0; j < playlistLen; j++) {
+    if (j != i && playlistEntries[j].preset == entry.preset && playlistEntries[j].cache != PL_CACHE_NONE) {
+      entry.cache = playlistEntries[j].cache;
+      entry.data  = playlistEntries[j].data;
+      entry.len   = playlistEntries[j].len;
+      return;
+    }
+  }
+
+  if (!requestJSONBufferLock(23)) return;
+  entry.cache = PL_CACHE_FS;
+  if (readObjectFromFileUsingId(getPresetsFileName(), entry.preset, pDoc)) {
+    JsonObject fdo = pDoc->as<JsonObject>();
+    if (fdo[F("playlist")].isNull() && fdo["win"].isNull()) {
+      fdo.remove("ps"); // same as in handlePresets()
+      fdo.remove("n");  // not needed to apply preset
+      fdo.remove(F("ql"));
+      size_t len = measureMsgPack(*pDoc);
+      if (len <= UINT16_MAX && playlistCacheUsed + len <= PLAYLIST_CACHE_SIZE) {
+        entry.data = static_cast<uint8_t*>(p_malloc(len));
+        if (entry.data) {
+          entry.len = serializeMsgPack(*pDoc, entry.data, len);
+          entry.cache = PL_CACHE_OK;
+          playlistCacheUsed += len;
+        }
+      }
+    }
+  }
+  releaseJSONBufferLock();
+  DEBUG_PRINTF_P(PSTR("Playlist preload %d: %u (%u bytes)\n"), (int)entry.preset, (unsigned)entry.cache, (unsigned)entry.len);
+}
+
+
 void unloadPlaylist() {
   if (playlistEntries != nullptr) {
+    freePlaylistCache();
     delete[] playlistEntries;
     playlistEntries = nullptr;
   }
@@ -74,18 +154,26 @@ int16_t loadPlaylist(JsonObject playlistObj, byte presetId) {
   for (int ps : presets) {
     if (it >= playlistLen) break;
     playlistEntries[it].preset = ps;
+    playlistEntries[it].cache  = PL_CACHE_NONE;
+    playlistEntries[it].data   = nullptr;
+    playlistEntries[it].len    = 0;
     it++;
   }
 
+  // durations are in tenths of seconds ("dur") or, for precise (e.g. music synced) playlists, in ms ("dms")
   it = 0;
-  JsonArray durations = playlistObj["dur"];
+  bool inMs = !playlistObj[F("dms")].isNull();
+  JsonVariant durObj = inMs ? playlistObj[F("dms")] : playlistObj["dur"];
+  const unsigned durMax = inMs ? 6553000 : 65530;
+  const unsigned durMul = inMs ? 1 : 100;
+  JsonArray durations = durObj;
   if (durations.isNull()) {
-    playlistEntries[0].dur = playlistObj["dur"] | 100; //10 seconds as fallback
+    playlistEntries[0].dur = constrain(durObj | (inMs ? 10000 : 100), 0, (int)durMax) * durMul; //10 seconds as fallback
     it = 1;
   } else {
     for (int dur : durations) {
       if (it >= playlistLen) break;
-      playlistEntries[it].dur = constrain(dur, 0, 65530);
+      playlistEntries[it].dur = constrain(dur, 0, (int)durMax) * durMul;
       it++;
     }
   }
@@ -137,17 +225,24 @@ int16_t loadPlaylist(JsonObject playlistObj, byte presetId) {
   }
 
   currentPlaylist = presetId;
+  playlistCacheGen = presetsGeneration;
   DEBUG_PRINTLN(F("Playlist loaded."));
   return currentPlaylist;
 }
 
 
 void handlePlaylist() {
-  static unsigned long presetCycledTime = 0;
+  static unsigned long presetCycledTime = 0; // time when current entry was due
   if (currentPlaylist < 0 || playlistEntries == nullptr) return;
 
-  if ((playlistEntryDur < UINT16_MAX && millis() - presetCycledTime > 100 * playlistEntryDur) || doAdvancePlaylist) {
-    presetCycledTime = millis();
+  unsigned long now = millis();
+  if ((playlistEntryDur < UINT32_MAX && now - presetCycledTime >= playlistEntryDur) || doAdvancePlaylist) {
+    // a due step is applied right before the frame that shows it is rendered, so it starts on the frame clock
+    if (!strip.isFrameDue(now)) return;
+    // next entry is due relative to when this one was due (not when it was handled) so that timing does not drift,
+    // unless playlist was just (re)started, advanced manually or paused
+    if (doAdvancePlaylist || playlistEntryDur == 0 || now - presetCycledTime >= 2 * playlistEntryDur) presetCycledTime = now;
+    else presetCycledTime += playlistEntryDur;
     if (bri == 0 || nightlightActive) return;
 
     ++playlistIndex %= playlistLen; // -1 at 1st run (limit to playlistLen)
@@ -167,12 +262,18 @@ void handlePlaylist() {
       if (playlistOptions & PL_OPTION_SHUFFLE) shufflePlaylist(); // shuffle playlist and start over
     }
 
+    const PlaylistEntry &entry = playlistEntries[playlistIndex];
     jsonTransitionOnce = true;
-    strip.setTransition(playlistEntries[playlistIndex].tr * 100);
-    playlistEntryDur = playlistEntries[playlistIndex].dur > 0 ? playlistEntries[playlistIndex].dur : UINT16_MAX;
-    applyPresetFromPlaylist(playlistEntries[playlistIndex].preset);
+    strip.setTransition(entry.tr * 100);
+    playlistEntryDur = entry.dur > 0 ? entry.dur : UINT32_MAX;
     doAdvancePlaylist = false;
+    // preloaded preset is applied immediately (and rendered in this loop() iteration), otherwise it is read from FS by handlePresets()
+    if (entry.cache != PL_CACHE_OK || playlistCacheGen != presetsGeneration || !applyPresetFromBuffer(entry.preset, entry.data, entry.len))
+      applyPresetFromPlaylist(entry.preset);
+    return;
   }
+
+  preloadPlaylistEntry(); // only when no entry was applied in this iteration
 }
 
 
@@ -184,9 +285,15 @@ void serializePlaylist(JsonObject sObj) {
   playlist[F("repeat")] = (playlistIndex < 0 && playlistRepeat > 0) ? playlistRepeat - 1 : playlistRepeat; // remove added repetition count (if not yet running)
   playlist["end"] = playlistOptions & PL_OPTION_RESTORE ? 255 : playlistEndPreset;
   playlist["r"] = playlistOptions & PL_OPTION_SHUFFLE;
+  bool inMs = false;
   for (int i=0; i<playlistLen; i++) {
     ps.add(playlistEntries[i].preset);
-    dur.add(playlistEntries[i].dur);
+    dur.add((playlistEntries[i].dur + 50) / 100);
     transition.add(playlistEntries[i].tr);
+    inMs |= playlistEntries[i].dur % 100;
+  }
+  if (inMs) { // durations with ms precision ("dur" is kept for older clients)
+    JsonArray dms = playlist.createNestedArray(F("dms"));
+    for (int i=0; i<playlistLen; i++) dms.add(playlistEntries[i].dur);
   }
 }
@@ -18,10 +18,43 @@ static bool includeBri = true, segBounds = true, selectedOnly = false, playlistS
 
 static const char presets_json[] PROGMEM = "/presets.json";
 static const char tmp_json[] PROGMEM = "/tmp.json";
+static const char boot_bin[] PROGMEM = "/boot.bin"; // compact (MessagePack) copy of boot preset for early output
 const char *getPresetsFileName(bool persistent) {
   return persistent ? presets_json : tmp_json;
 }
 
+#define BOOT_PRESET_MAGIC 0x53504257 // "WBPS"
+
+// boot preset is read from /boot.bin (if it matches) which avoids searching and parsing presets.json at boot
+static bool readBootPreset(JsonDocument *doc) {
+  File f = WLED_FS.open(FPSTR(boot_bin), "r");
+  if (!f) return false;
+  uint32_t hdr[2];
+  bool success = f.read(reinterpret_cast<uint8_t*>(hdr), sizeof(hdr)) == sizeof(hdr) &&
+                 hdr[0] == BOOT_PRESET_MAGIC && hdr[1] == bootPreset &&
+                 deserializeMsgPack(*doc, f) == DeserializationError::Ok;
+  f.close();
+  DEBUG_PRINTF_P(PSTR("Boot preset %s from cache.\n"), success ? "loaded" : "not loaded");
+  return success;
+}
+
+static void writeBootPreset(const JsonDocument *doc) {
+  File f = WLED_FS.open(FPSTR(boot_bin), "w");
+  if (!f) return;
+  uint32_t hdr[2] = { BOOT_PRESET_MAGIC, bootPreset };
+  f.write(reinterpret_cast<const uint8_t*>(hdr), sizeof(hdr));
+  serializeMsgPack(*doc, f);
+  f.close();
+}
+
+// presets.json was modified, cached boot preset may be stale (it is re-created at next boot)
+// must be called whenever presets.json is written, uploaded or deleted
+void presetsChanged() {
+  presetsModifiedTime = toki.second(); //unix time
+  presetsGeneration++; // invalidates presets preloaded by playlist
+  if (WLED_FS.exists(FPSTR(boot_bin))) WLED_FS.remove(FPSTR(boot_bin));
+}
+
 bool presetNeedsSaving() {
   return presetToSave;
 }
@@ -70,7 +103,7 @@ static void doSaveState() {
   #endif
   writeObjectToFileUsingId(getPresetsFileName(persist), presetToSave, pDoc);
 
-  if (persist) presetsModifiedTime = toki.second(); //unix time
+  if (persist) presetsChanged();
   releaseJSONBufferLock();
   updateFSInfo();
 
@@ -124,6 +157,27 @@ bool applyPresetFromPlaylist(byte index)
   return true;
 }
 
+// apply preset preloaded by playlist (MessagePack, "ps", "playlist" and "win" are not present), no filesystem access
+bool applyPresetFromBuffer(byte index, const uint8_t *data, size_t len)
+{
+  if (data == nullptr || presetToApply || !requestJSONBufferLock(24)) return false;
+  DEBUG_PRINTF_P(PSTR("Applying preloaded preset: %u\n"), (unsigned)index);
+  if (deserializeMsgPack(*pDoc, data, len)) {
+    releaseJSONBufferLock();
+    return false;
+  }
+  JsonObject fdo = pDoc->as<JsonObject>();
+  bool changePreset = !fdo["seg"].isNull() || !fdo["on"].isNull() || !fdo["bri"].isNull() || !fdo["nl"].isNull();
+  if (errorFlag == ERR_FS_PLOAD) errorFlag = ERR_NONE; // only reset errorflag if previous error was preset-related
+  deserializeState(fdo, CALL_MODE_NO_NOTIFY, index);
+  if (!errorFlag && changePreset) currentPreset = index;
+  releaseJSONBufferLock();
+  if (changePreset) notify(CALL_MODE_DIRECT_CHANGE); // force UDP notification
+  stateUpdated(CALL_MODE_DIRECT_CHANGE);
+  updateInterfaces(CALL_MODE_DIRECT_CHANGE);
+  return true;
+}
+
 bool applyPreset(byte index, byte callMode)
 {
   unloadPlaylist(); // applying a preset unloads the playlist (#3827)
@@ -142,6 +196,31 @@ void applyPresetWithFallback(uint8_t index, uint8_t callMode, uint8_t effectID,
   effectPalette = paletteID;
 }
 
+// early output: boot preset was applied before usermods were set up (see WLED::loop())
+// usermods only get its state, the preset is applied again only if it selects an effect added by a usermod since
+// (that segment runs a fallback effect); knownEffects has a bit set for each effect registered at first apply
+void finishBootPreset(const uint32_t *knownEffects)
+{
+  if (bootPreset == 0 || !requestJSONBufferLock(25)) return;
+  bool reapply = false;
+  if (readBootPreset(pDoc) || readObjectFromFileUsingId(getPresetsFileName(), bootPreset, pDoc)) {
+    JsonObject root = pDoc->as<JsonObject>();
+    auto isAddedEffect = [knownEffects](JsonVariant fxVar) {
+      const unsigned fx = fxVar.is<const char*>() ? strip.getModeByName(fxVar.as<const char*>()) : fxVar.is<int>() ? fxVar.as<int>() : 255;
+      return fx < strip.getModeCount() && !(knownEffects[fx >> 5] & (1U << (fx & 31)));
+    };
+    JsonVariant segVar = root["seg"];
+    if (segVar.is<JsonObject>()) reapply = isAddedEffect(segVar["fx"]);
+    else for (JsonObject elem : segVar.as<JsonArray>()) reapply |= isAddedEffect(elem["fx"]);
+    if (!reapply) {
+      UsermodManager::readFromJsonState(root);
+      UsermodManager::onStateChange(CALL_MODE_INIT);
+    }
+  }
+  releaseJSONBufferLock();
+  if (reapply) applyPreset(bootPreset, CALL_MODE_INIT);
+}
+
 void handlePresets()
 {
   byte presetErrFlag = ERR_NONE;
@@ -175,8 +254,14 @@ void handlePresets()
     deserializeJson(*pDoc,tmpRAMbuffer);
   } else
   #endif
+  if (!(earlyOutput && tmpMode == CALL_MODE_INIT && readBootPreset(pDoc))) // CALL_MODE_INIT is only used for boot preset
   {
   presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(tmpPreset < 255), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
+  if (earlyOutput && tmpMode == CALL_MODE_INIT && presetErrFlag == ERR_NONE) {
+    pDoc->remove("n");
+    pDoc->remove(F("ql"));
+    writeBootPreset(pDoc);
+  }
   }
   fdo = pDoc->as<JsonObject>();
 
@@ -261,7 +346,7 @@ void savePreset(byte index, const char* pname, JsonObject sObj)
         if (sObj["n"].isNull()) sObj["n"] = saveName;
         initPresetsFile(); // just in case if someone deleted presets.json using /edit
         writeObjectToFileUsingId(getPresetsFileName(), index, pDoc);
-        presetsModifiedTime = toki.second(); //unix time
+        presetsChanged();
         updateFSInfo();
       }
       p_free(saveName);
@@ -280,6 +365,6 @@ void savePreset(byte index, const char* pname, JsonObject sObj)
 void deletePreset(byte index) {
   StaticJsonDocument<24> empty;
   writeObjectToFileUsingId(getPresetsFileName(), index, &empty);
-  presetsModifiedTime = toki.second(); //unix time
+  presetsChanged();
   updateFSInfo();
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#ifndef RenderQueue_h
+#define RenderQueue_h
+/*
+ * Render queue shared by FX workers (loop() and FX worker task/thread, see WLED_FX_WORKERS)
+ *
+ * service() publishes the indices of due segments, every worker then claims entries until the queue is drained.
+ * Queue state packs generation (bits 16-23), queue length (bits 8-15) and next entry to claim (bits 0-7), so a worker
+ * woken late (or still finishing the previous frame) can never claim an entry of a queue it was not started for.
+ */
+
+#include <stdint.h>
+#include <atomic>
+
+template<unsigned N>
+class RenderQueue {
+  static_assert(N < 256, "queue length and entry index must fit into 8 bits");
+
+  public:
+    // entries must not be changed until isDone() (previous queue may still be drained by a late worker)
+    inline uint8_t *entries() { return _entries; }
+
+    // starts a new generation with the first len entries, workers can start claiming them
+    void publish(unsigned len) {
+      _len = len;
+      _done.store(0);
+      _state.store((uint32_t(++_gen) << 16) | (len << 8));
+    }
+
+    // claims and renders entries until the queue is drained or a new generation is published, called by every worker
+    template<typename F> void drain(F render) {
+      uint32_t state = _state.load();
+      const uint32_t gen = state & 0xFF0000U;
+      for (;;) {
+        if ((state & 0xFF0000U) != gen || (state & 0xFFU) >= ((state >> 8) & 0xFFU)) break; // new frame or queue drained
+        if (!_state.compare_exchange_weak(state, state + 1)) continue;                      // another worker claimed the entry
+        render(_entries[state & 0xFFU]);
+        _done.fetch_add(1);
+        state = _state.load();
+      }
+    }
+
+    inline bool isDone() const { return _done.load() >= _len; } // all entries of the current queue have been rendered
+
+  private:
+    uint8_t               _entries[N];
+    std::atomic<uint32_t> _state{0};
+    std::atomic<unsigned> _done{0};
+    unsigned              _len = 0;
+    uint8_t               _gen = 0;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+#ifndef SegmentRandom_h
+#define SegmentRandom_h
+/*
+ * PRNG of seeded segments (used by hw_random() and WS2812FX::runEffect())
+ * A segment with a seed set draws its random numbers from here instead of the hardware RNG, so an effect
+ * renders the same frames on every run (golden frame tests) and on every controller synced to it.
+ */
+
+#include <stdint.h>
+
+// splitmix32: good quality in all bits, so 8 and 16 bit variants may simply truncate
+inline uint32_t prng32(uint32_t &state) {
+  uint32_t z = (state += 0x9E3779B9U);
+  z = (z ^ (z >> 16)) * 0x85EBCA6BU;
+  z = (z ^ (z >> 13)) * 0xC2B2AE35U;
+  return z ^ (z >> 16);
+}
+
+// per-frame PRNG state of a seeded segment, depends only on segment seed, segment index, old/new effect of a transition
+// and frame counter (call), so the same frame of an effect gets the same random numbers on every run and every synced controller
+inline uint32_t segmentRandomState(uint16_t seed, unsigned segmentIndex, bool previousMode, uint32_t call) {
+  uint32_t key = (uint32_t(seed) << 16) | (uint32_t(segmentIndex) << 1) | previousMode;
+  return prng32(key) ^ call;
+}
+
+#endif
@@ -0,0 +1,127 @@
+#pragma once
+#ifndef SerialFrame_h
+#define SerialFrame_h
+/*
+ * Adalight and TPM2 frame parser (used by handleSerial())
+ * Recognizes the frame header, checks the Adalight checksum and hands out complete RGB pixels,
+ * so handleSerial() can read pixel data in blocks instead of one byte per loop() iteration.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+// header bytes are fed one at a time (commands, Improv and JSON need the stream positioned at their first byte),
+// pixel data is fed in blocks; a pixel split between blocks is completed from saved state
+class SerialFrameParser {
+  public:
+    enum class State : uint8_t {
+      Header_A,
+      Header_d,
+      Header_a,
+      Header_CountHi,
+      Header_CountLo,
+      Header_CountCheck,
+      Data_Red,
+      Data_Green,
+      Data_Blue,
+      TPM2_Header_Type,
+      TPM2_Header_CountHi,
+      TPM2_Header_CountLo,
+    };
+    enum class Event : uint8_t {
+      None,    // byte was consumed
+      Command, // not a frame start (only in Header_A state), to be handled by caller
+      Ping,    // TPM2 ping, to be answered with 0xAC
+    };
+
+    inline State    getState() const   { return _state; }
+    inline bool     isData() const     { return _state == State::Data_Red || _state == State::Data_Green || _state == State::Data_Blue; }
+    inline uint32_t getDropped() const { return _dropped; } // frames rejected due to bad header (checksum mismatch, invalid TPM2 size)
+    // bytes left in frame (only in data states)
+    inline size_t   bytesLeft() const  { return 3*_count - (_state == State::Data_Green) - 2*(_state == State::Data_Blue); }
+
+    // feeds one header byte, must not be called in data states
+    Event header(uint8_t next) {
+      switch (_state) {
+        case State::Header_A:
+          if      (next == 'A')  _state = State::Header_d;
+          else if (next == 0xC9) _state = State::TPM2_Header_Type; //TPM2 start byte
+          else return Event::Command;
+          break;
+        case State::Header_d:
+          _state = (next == 'd') ? State::Header_a : State::Header_A;
+          break;
+        case State::Header_a:
+          _state = (next == 'a') ? State::Header_CountHi : State::Header_A;
+          break;
+        case State::Header_CountHi:
+          _pixel = 0;
+          _count = next * 0x100;
+          _check = next;
+          _state = State::Header_CountLo;
+          break;
+        case State::Header_CountLo:
+          _count += next + 1;
+          _check = _check ^ next ^ 0x55;
+          _state = State::Header_CountCheck;
+          break;
+        case State::Header_CountCheck:
+          if (_check == next) _state = State::Data_Red;
+          else              { _state = State::Header_A; _dropped++; }
+          break;
+        case State::TPM2_Header_Type:
+          _state = State::Header_A; //(unsupported) TPM2 command or invalid type
+          if (next == 0xDA) _state = State::TPM2_Header_CountHi; //TPM2 data
+          else if (next == 0xAA) return Event::Ping;
+          break;
+        case State::TPM2_Header_CountHi:
+          _pixel = 0;
+          _count = next * 0x100; // number of bytes, converted to pixels when low byte is known
+          _state = State::TPM2_Header_CountLo;
+          break;
+        case State::TPM2_Header_CountLo:
+          _count = (_count + next) / 3;
+          if (_count > 0) _state = State::Data_Red;
+          else          { _state = State::Header_A; _dropped++; } // less than 1 pixel
+          break;
+        default: break; // data states are handled in data()
+      }
+      return Event::None;
+    }
+
+    // feeds pixel data (at most bytesLeft() bytes), setPixel(index, r, g, b) is called for each complete pixel
+    // returns true when frame is complete (parser then waits for next header)
+    template<typename SetPixel>
+    bool data(const uint8_t *buf, size_t len, SetPixel setPixel) {
+      size_t i = 0;
+      // complete pixel that was split between blocks
+      if (_state == State::Data_Green && i < len) { _green = buf[i++]; _state = State::Data_Blue; }
+      if (_state == State::Data_Blue && i < len) {
+        setPixel(_pixel, _red, _green, buf[i]);
+        i++; _pixel++; _count--;
+        _state = State::Data_Red;
+      }
+      if (_state == State::Data_Red) {
+        const size_t n = (len - i) / 3;
+        for (size_t p = 0; p < n; p++, i += 3) setPixel(_pixel + p, buf[i], buf[i+1], buf[i+2]);
+        _pixel += n;
+        _count -= n;
+        if (i < len) { _red   = buf[i++]; _state = State::Data_Green; }
+        if (i < len) { _green = buf[i++]; _state = State::Data_Blue; }
+      }
+      if (_count > 0) return false;
+      _state = State::Header_A;
+      return true;
+    }
+
+  private:
+    State    _state = State::Header_A;
+    uint32_t _count = 0;   // pixels left in frame (Adalight header allows 65536)
+    uint32_t _pixel = 0;   // index of next pixel
+    uint8_t  _check = 0;
+    uint8_t  _red   = 0;   // saved channels of pixel split between blocks
+    uint8_t  _green = 0;
+    uint32_t _dropped = 0;
+};
+
+#endif
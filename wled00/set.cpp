@@ -146,6 +146,10 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     // this will set global ABL max current used when per-port ABL is not used
     unsigned ablMilliampsMax = request->arg(F("MA")).toInt();
     BusManager::setMilliampsMax(ablMilliampsMax);
+    // PSU budget shared by outputs when per-port ABL is used
+    BusManager::setMilliampsPSU(request->arg(F("PS")).toInt());
+    BusManager::setABLSmoothing(request->hasArg(F("AM")));
+    BusManager::setABLSustained(constrain(request->arg(F("AS")).toInt(), 10, 100));
 
     strip.autoSegments = request->hasArg(F("MS"));
     strip.correctWB = request->hasArg(F("CCT"));
@@ -250,6 +254,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
         if (!BusManager::getColorOrderMap().add(start, length, colorOrder)) break;
       }
     }
+    doUpdateColorOrder = true; // in case buses are not re-created; spans are used by output in loop(), do not rebuild them here
 
     // update other pins
     #ifndef WLED_DISABLE_INFRARED
@@ -338,8 +343,10 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     turnOnAtBoot = request->hasArg(F("BO"));
     t = request->arg(F("BP")).toInt();
     if (t <= 250) bootPreset = t;
+    earlyOutput = request->hasArg(F("EO"));
     gammaCorrectBri = request->hasArg(F("GB"));
     gammaCorrectCol = request->hasArg(F("GC"));
+    BusDigital::setDither(request->hasArg(F("DT")));
     gammaCorrectVal = request->arg(F("GV")).toFloat();
     if (gammaCorrectVal <= 1.0f || gammaCorrectVal > 3) {
       gammaCorrectVal = 1.0f; // no gamma correction
@@ -353,6 +360,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     t = request->arg(F("TP")).toInt();
     randomPaletteChangeTime = MIN(255,MAX(1,t));
     useHarmonicRandomPalette = request->hasArg(F("TH"));
+    if (request->hasArg(F("TS"))) transitionSnapshot = request->arg(F("TS")).toInt();
 
     nightlightTargetBri = request->arg(F("TB")).toInt();
     t = request->arg(F("TL")).toInt();
@@ -415,6 +423,9 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     if (!nodeListEnabled) Nodes.clear();
     nodeBroadcastEnabled = request->hasArg(F("NB"));
 
+    t = request->arg(F("FS")).toInt();
+    if ((t>=0) && (t<3)) frameSyncMode = t;
+
     receiveDirect = request->hasArg(F("RD")); // UDP realtime
     useMainSegmentOnly = request->hasArg(F("MO"));
     realtimeRespectLedMaps = request->hasArg(F("RLM"));
@@ -648,6 +659,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       t = request->arg(argname).toInt();
       DMXFixtureMap[i] = t;
     }
+    compileDMXOutput();
   }
   #endif
 
@@ -816,6 +828,10 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
         pO[l] = 'H'; p.height      = request->arg(pO).toInt();
         strip.panel.push_back(p);
       }
+      strip.canvasWidth  = constrain(request->arg(F("CW")).toInt(), 0, 255);
+      strip.canvasHeight = constrain(request->arg(F("CH")).toInt(), 0, 255);
+      strip.canvasX      = constrain(request->arg(F("CX")).toInt(), 0, 254);
+      strip.canvasY      = constrain(request->arg(F("CY")).toInt(), 0, 254);
     }
     strip.panel.shrink_to_fit();  // release unused memory
     // we are changing matrix/ledmap geometry which *will* affect existing segments
@@ -78,6 +78,15 @@ void DMXESPSerial::write(int Channel, uint8_t value) {
   dmxDataStore[Channel] = value;
 }
 
+// Function to send a block of DMX data
+void DMXESPSerial::write(int Channel, const uint8_t *values, int len) {
+  if (dmxStarted == false) init();
+
+  if (Channel < 1) Channel = 1;
+  if (Channel + len - 1 > channelSize) len = channelSize - Channel + 1;
+  if (len > 0) memcpy(dmxDataStore + Channel, values, len);
+}
+
 void DMXESPSerial::end() {
   channelSize = 0;
   Serial1.end();
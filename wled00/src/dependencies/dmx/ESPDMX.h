@@ -24,6 +24,7 @@ public:
   void init(int MaxChan);
   uint8_t read(int Channel);
   void write(int channel, uint8_t value);
+  void write(int channel, const uint8_t *values, int len); // consecutive channels starting at channel
   void update();
   void end();
 };
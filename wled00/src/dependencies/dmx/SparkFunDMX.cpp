@@ -134,6 +134,16 @@ void SparkFunDMX::write(int Channel, uint8_t value) {
   dmxData[Channel] = value; //add one to account for start byte
 }
 
+// Function to send a block of DMX data
+void SparkFunDMX::write(int Channel, const uint8_t *values, int len) {
+  if (Channel < 1) Channel = 1;
+  if (Channel + len - 1 > dmxMaxChannel) len = dmxMaxChannel - Channel + 1;
+  if (len <= 0) return;
+  if (Channel + len - 1 > chanSize) chanSize = Channel + len - 1;
+  dmxData[0] = 0;
+  memcpy(dmxData + Channel, values, len);
+}
+
 
 
 void SparkFunDMX::update() {
@@ -31,6 +31,7 @@ public:
   uint8_t read(int Channel);
 #endif
   void write(int channel, uint8_t value);
+  void write(int channel, const uint8_t *values, int len); // consecutive channels starting at channel
   void update();
 private:
   const uint8_t _startCodeValue = 0xFF;
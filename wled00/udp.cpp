@@ -9,6 +9,9 @@
 #define WLEDPACKETSIZE (41+(WS2812FX::getMaxSegments()*UDP_SEG_SIZE)+0)
 #define UDP_IN_MAXSIZE 1472
 #define PRESUMED_NETWORK_DELAY 3 //how many ms could it take on avg to reach the receiver? This will be added to transmitted times
+#define FRAME_SYNC_INTERVAL 500  //ms between frame sync packets sent by the leader
+#define FRAME_SYNC_TIMEOUT 3000  //follower falls back to its own frame timing if no frame sync packet was received for this long
+#define FRAME_SYNC_MAX_SLEW 250  //clock errors above this (ms) are corrected in one jump instead of being slewed
 
 typedef struct PartialEspNowPacket {
   uint8_t magic;
@@ -368,7 +371,7 @@ static void parseNotifyPacket(const uint8_t *udpIn) {
     stateChanged = true;
   }
 
-  if (applyEffects && version > 5) {
+  if (applyEffects && version > 5 && frameSyncMode != 2) { // frame sync followers get their timebase from the leader
     uint32_t t = (udpIn[25] << 24) | (udpIn[26] << 16) | (udpIn[27] << 8) | (udpIn[28]);
     t += PRESUMED_NETWORK_DELAY; //adjust trivially for network delay
     t -= millis();
@@ -465,6 +468,87 @@ void sendTPM2Ack() {
 }
 
 
+// frame sync packet from a leader: lock strip time (timebase) and frame grid onto the leader's
+static void parseFrameSyncPacket(const uint8_t *udpIn) {
+  uint32_t leaderNow = (udpIn[2] << 24) | (udpIn[3] << 16) | (udpIn[4] << 8) | (udpIn[5]);
+  uint32_t epoch     = (udpIn[6] << 24) | (udpIn[7] << 16) | (udpIn[8] << 8) | (udpIn[9]);
+  uint16_t period    = (udpIn[10] << 8) | (udpIn[11]);
+
+  int32_t delay = PRESUMED_NETWORK_DELAY;
+  if (udpIn[13] > 99 && toki.getTimeSource() > 99) { //if we both have good times, use the actual transit time
+    Toki::Time tm;
+    tm.sec = (udpIn[14] << 24) | (udpIn[15] << 16) | (udpIn[16] << 8) | (udpIn[17]);
+    tm.ms = (udpIn[18] << 8) | (udpIn[19]);
+    Toki::Time myTime = toki.getTime();
+    uint32_t diff = toki.msDifference(tm, myTime);
+    if (diff < 1000) delay = toki.isLater(tm, myTime) ? (int32_t)diff : -(int32_t)diff;
+  }
+
+  unsigned long target = leaderNow + delay - millis(); // timebase that makes our strip.now equal to the leader's
+  int32_t err = (int32_t)(target - strip.timebase);
+  frameSyncSkew = err;
+  if (millis() - frameSyncLastRx > FRAME_SYNC_TIMEOUT || abs(err) > FRAME_SYNC_MAX_SLEW) {
+    strip.timebase = target; // (re)lock
+  } else {
+    strip.timebase += err / 2; // slew: follows clock drift and averages out network jitter without visible jumps
+  }
+  frameSyncLastRx = millis();
+  strip.setFrameSync(epoch, period);
+}
+
+// leader: broadcast strip time and frame grid to followers
+static void sendFrameSyncUDP()
+{
+  if (!udp2Connected || !syncGroups) return;
+
+  //  0: 1 byte 'binary token 255'
+  //  1: 1 byte id '2'
+  //  2: 4 byte strip time (millis() + timebase) at send
+  //  6: 4 byte strip time of the last frame start
+  // 10: 2 byte frame period in ms (0 = unlimited FPS, followers sync their timebase only)
+  // 12: 1 byte sync groups
+  // 13: 1 byte time source
+  // 14: 4 byte unix time
+  // 18: 2 byte milliseconds
+  // 20 bytes total
+  uint8_t data[20] = {0};
+  data[0] = 255;
+  data[1] = 2;
+  uint32_t t = millis() + strip.timebase;
+  uint32_t epoch = strip.getLastFrameStart() + strip.timebase;
+  uint16_t period = (strip.getTargetFps() != FPS_UNLIMITED) ? strip.getFrameTime() : 0;
+  for (size_t i = 0; i < 4; i++) {
+    data[2+i] = (t     >> (24 - 8*i)) & 0xFF;
+    data[6+i] = (epoch >> (24 - 8*i)) & 0xFF;
+  }
+  data[10] = (period >> 8) & 0xFF;
+  data[11] = (period >> 0) & 0xFF;
+  data[12] = syncGroups;
+  data[13] = toki.getTimeSource();
+  Toki::Time tm = toki.getTime();
+  for (size_t i = 0; i < 4; i++) data[14+i] = (tm.sec >> (24 - 8*i)) & 0xFF;
+  data[18] = (tm.ms >> 8) & 0xFF;
+  data[19] = (tm.ms >> 0) & 0xFF;
+
+  IPAddress broadcastIP(255, 255, 255, 255);
+  notifier2Udp.beginPacket(broadcastIP, udpPort2);
+  notifier2Udp.write(data, sizeof(data));
+  notifier2Udp.endPacket();
+}
+
+void handleFrameSync()
+{
+  static unsigned long lastSent = 0;
+  if (frameSyncMode == 1) {
+    if (millis() - lastSent >= FRAME_SYNC_INTERVAL) {
+      lastSent = millis();
+      sendFrameSyncUDP();
+    }
+  } else if (strip.getFrameSyncPeriod() && (frameSyncMode != 2 || millis() - frameSyncLastRx > FRAME_SYNC_TIMEOUT)) {
+    strip.clearFrameSync(); // leader lost, run on our own frame timing
+  }
+}
+
 void handleNotifications()
 {
   IPAddress localIP;
@@ -557,6 +641,12 @@ void handleNotifications()
     return;
   }
 
+  // frame sync from a leader
+  if (isSupp && udpIn[0] == 255 && udpIn[1] == 2 && len >= 20) {
+    if (frameSyncMode == 2 && notifier2Udp.remoteIP() != localIP && (receiveGroups & udpIn[12])) parseFrameSyncPacket(udpIn);
+    return;
+  }
+
   //wled notifier, ignore if realtime packets active
   if (udpIn[0] == 0 && !realtimeMode && receiveGroups)
   {
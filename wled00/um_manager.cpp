@@ -18,11 +18,15 @@ static size_t getCount() {
 }
 
 
+// in early output boot LEDs run before usermods are set up (see WLED::setup()), callbacks that may be
+// triggered by the boot preset or by effects are not forwarded until then
+static inline bool usermodsReady() { return bootStage != BOOT_STAGE_USERMODS; }
+
 //Usermod Manager internals
 void UsermodManager::setup()             { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->setup(); }
 void UsermodManager::connected()         { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->connected(); }
 void UsermodManager::loop()              { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->loop();  }
-void UsermodManager::handleOverlayDraw() { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->handleOverlayDraw(); }
+void UsermodManager::handleOverlayDraw() { if (usermodsReady()) for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->handleOverlayDraw(); }
 void UsermodManager::appendConfigData(Print& dest)  { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->appendConfigData(dest); }
 bool UsermodManager::handleButton(uint8_t b) {
   bool overrideIO = false;
@@ -32,6 +36,7 @@ bool UsermodManager::handleButton(uint8_t b) {
   return overrideIO;
 }
 bool UsermodManager::getUMData(um_data_t **data, uint8_t mod_id) {
+  if (!usermodsReady()) return false; // effects fall back to simulated data
   for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) {
     if (mod_id > 0 && (*mod)->getId() != mod_id) continue;  // only get data form requested usermod if provided
     if ((*mod)->getUMData(data)) return true;               // if usermod does provide data return immediately (only one usermod can provide data at one time)
@@ -46,7 +51,7 @@ void UsermodManager::addToJsonInfo(JsonObject& obj)     {
     (*mod)->addToJsonInfo(obj);
   }
 }
-void UsermodManager::readFromJsonState(JsonObject& obj) { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->readFromJsonState(obj); }
+void UsermodManager::readFromJsonState(JsonObject& obj) { if (usermodsReady()) for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->readFromJsonState(obj); }
 void UsermodManager::addToConfig(JsonObject& obj)       { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->addToConfig(obj); }
 bool UsermodManager::readFromConfig(JsonObject& obj)    {
   bool allComplete = true;
@@ -73,7 +78,7 @@ bool UsermodManager::onUdpPacket(uint8_t* payload, size_t len) {
   return false;
 }
 void UsermodManager::onUpdateBegin(bool init) { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->onUpdateBegin(init); } // notify usermods that update is to begin
-void UsermodManager::onStateChange(uint8_t mode) { for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->onStateChange(mode); } // notify usermods that WLED state changed
+void UsermodManager::onStateChange(uint8_t mode) { if (usermodsReady()) for (auto mod = _usermod_table_begin; mod < _usermod_table_end; ++mod) (*mod)->onStateChange(mode); } // notify usermods that WLED state changed
 
 /*
  * Enables usermods to lookup another Usermod.
@@ -218,17 +218,9 @@ uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLe
 {
   if (src == JSON_mode_names || src == nullptr) {
     if (mode < strip.getModeCount()) {
-      char lineBuffer[256];
-      //strcpy_P(lineBuffer, (const char*)pgm_read_dword(&(WS2812FX::_modeData[mode])));
-      strncpy_P(lineBuffer, strip.getModeData(mode), sizeof(lineBuffer)/sizeof(char)-1);
-      lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-      size_t len = strlen(lineBuffer);
-      size_t j = 0;
-      for (; j < maxLen && j < len; j++) {
-        if (lineBuffer[j] == '\0' || lineBuffer[j] == '@') break;
-        dest[j] = lineBuffer[j];
-      }
-      dest[j] = 0; // terminate string
+      size_t len = std::min((size_t)strip.getModeNameLength(mode), (size_t)maxLen); // name length is known from effect descriptor
+      strncpy_P(dest, strip.getModeData(mode), len);
+      dest[len] = 0; // terminate string
       return strlen(dest);
     } else return 0;
   }
@@ -270,98 +262,102 @@ uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLe
 }
 
 
+// finds c in PROGMEM string between p and end, returns end if not found
+static const char *findChar_P(const char *p, const char *end, char c) {
+  while (p < end && pgm_read_byte(p) != c) p++;
+  return p;
+}
+
+// same as (uint8_t)atoi() for PROGMEM string of digits
+static uint8_t parseUInt8_P(const char *p) {
+  unsigned val = 0;
+  for (char c = pgm_read_byte(p); c >= '0' && c <= '9'; c = pgm_read_byte(++p)) val = val * 10 + (c - '0');
+  return val;
+}
+
 // extracts effect slider data (1st group after @)
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var)
 {
   dest[0] = '\0'; // start by clearing buffer
 
-  if (mode < strip.getModeCount()) {
-    String lineBuffer = FPSTR(strip.getModeData(mode));
-    if (lineBuffer.length() > 0) {
-      int start = lineBuffer.indexOf('@');   // String::indexOf() returns an int, not an unsigned; -1 means "not found"
-      int stop  = lineBuffer.indexOf(';', start);
-      if (start>0 && stop>0) {
-        String names = lineBuffer.substring(start, stop); // include @
-        int nameBegin = 1, nameEnd, nameDefault;
-        if (slider < 10) {
-          for (size_t i=0; i<=slider; i++) {
-            const char *tmpstr;
-            dest[0] = '\0'; //clear dest buffer
-            if (nameBegin <= 0) break; // there are no more names
-            nameEnd = names.indexOf(',', nameBegin);
-            if (i == slider) {
-              nameDefault = names.indexOf('=', nameBegin); // find default value
-              if (nameDefault > 0 && var && ((nameEnd>0 && nameDefault<nameEnd) || nameEnd<0)) {
-                *var = (uint8_t)atoi(names.substring(nameDefault+1).c_str());
-              }
-              if (names.charAt(nameBegin) == '!') {
-                switch (slider) {
-                  case  0: tmpstr = PSTR("FX Speed");     break;
-                  case  1: tmpstr = PSTR("FX Intensity"); break;
-                  case  2: tmpstr = PSTR("FX Custom 1");  break;
-                  case  3: tmpstr = PSTR("FX Custom 2");  break;
-                  case  4: tmpstr = PSTR("FX Custom 3");  break;
-                  default: tmpstr = PSTR("FX Custom");    break;
-                }
-                strncpy_P(dest, tmpstr, maxLen); // copy the name into buffer (replacing previous)
-                dest[maxLen-1] = '\0';
-              } else {
-                if (nameEnd<0) tmpstr = names.substring(nameBegin).c_str(); // did not find ",", last name?
-                else           tmpstr = names.substring(nameBegin, nameEnd).c_str();
-                strlcpy(dest, tmpstr, maxLen); // copy the name into buffer (replacing previous)
-              }
-            }
-            nameBegin = nameEnd+1; // next name (if "," is not found it will be 0)
-          } // next slider
-        } else if (slider == 255) {
-          // palette
-          strlcpy(dest, "pal", maxLen);
-          names = lineBuffer.substring(stop+1); // stop has index of color slot names
-          nameBegin = names.indexOf(';'); // look for palette
-          if (nameBegin >= 0) {
-            nameEnd = names.indexOf(';', nameBegin+1);
-            if (!isdigit(names[nameBegin+1])) nameBegin = names.indexOf('=', nameBegin+1); // look for default value
-            if (nameEnd >= 0 && nameBegin > nameEnd) nameBegin = -1;
-            if (nameBegin >= 0 && var) {
-              *var = (uint8_t)atoi(names.substring(nameBegin+1).c_str());
-            }
-          }
-        }
-        // we have slider name (including default value) in the dest buffer
-        for (size_t i=0; i<strlen(dest); i++) if (dest[i]=='=') { dest[i]='\0'; break; } // truncate default value
+  if (mode >= strip.getModeCount() || pgm_read_byte(strip.getModeData(mode)) == 0) return 0;
+  if (slider < 8 && !(strip.getModeControls(mode) & (1 << slider))) return 0; // control not shown, known from effect descriptor
+
+  const char *names = strip.getModeUIData(mode);               // located by effect descriptor (PROGMEM), after "@"
+  const char *end   = names ? names + strlen_P(names) : nullptr;
+  const char *stop  = names ? findChar_P(names, end, ';') : nullptr; // end of slider names
+  if (!names || stop == end) {
+    // defaults to just speed and intensity since there is no slider data
+    switch (slider) {
+      case 0:  strncpy_P(dest, PSTR("FX Speed"), maxLen); break;
+      case 1:  strncpy_P(dest, PSTR("FX Intensity"), maxLen); break;
+    }
+    dest[maxLen] = '\0'; // strncpy does not necessarily null terminate string
+    return strlen(dest);
+  }
 
-      } else {
-        // defaults to just speed and intensity since there is no slider data
-        switch (slider) {
-          case 0:  strncpy_P(dest, PSTR("FX Speed"), maxLen); break;
-          case 1:  strncpy_P(dest, PSTR("FX Intensity"), maxLen); break;
-        }
-        dest[maxLen] = '\0'; // strncpy does not necessarily null terminate string
+  if (slider < 10) {
+    const char *nameBegin = names;
+    for (size_t i = 0; i < slider; i++) {
+      nameBegin = findChar_P(nameBegin, stop, ',');
+      if (nameBegin == stop) return 0; // there are no more names
+      nameBegin++;
+    }
+    const char *nameEnd     = findChar_P(nameBegin, stop, ',');
+    const char *nameDefault = findChar_P(nameBegin, nameEnd, '='); // find default value
+    if (nameDefault < nameEnd && var) *var = parseUInt8_P(nameDefault + 1);
+    if (pgm_read_byte(nameBegin) == '!') {
+      const char *tmpstr;
+      switch (slider) {
+        case  0: tmpstr = PSTR("FX Speed");     break;
+        case  1: tmpstr = PSTR("FX Intensity"); break;
+        case  2: tmpstr = PSTR("FX Custom 1");  break;
+        case  3: tmpstr = PSTR("FX Custom 2");  break;
+        case  4: tmpstr = PSTR("FX Custom 3");  break;
+        default: tmpstr = PSTR("FX Custom");    break;
       }
+      strncpy_P(dest, tmpstr, maxLen); // copy the name into buffer
+      dest[maxLen-1] = '\0';
+    } else if (maxLen) {
+      size_t len = std::min((size_t)(nameDefault - nameBegin), (size_t)maxLen - 1); // without default value
+      strncpy_P(dest, nameBegin, len);
+      dest[len] = '\0';
+    }
+  } else if (slider == 255) {
+    // palette
+    strlcpy(dest, "pal", maxLen);
+    const char *nameBegin = findChar_P(stop + 1, end, ';'); // skip color slot names, look for palette
+    if (nameBegin < end && var) {
+      const char *nameEnd = findChar_P(nameBegin + 1, end, ';');
+      if (!isdigit(pgm_read_byte(nameBegin + 1))) nameBegin = findChar_P(nameBegin + 1, nameEnd, '='); // look for default value
+      if (nameBegin < nameEnd) *var = parseUInt8_P(nameBegin + 1);
     }
-    return strlen(dest);
   }
-  return 0;
+  return strlen(dest);
 }
 
 
+// extracts mode parameter default from defaults section of mode data (e.g. "sx=16,ix=240" in "Juggle@!,Trail;!,!,;!;012;sx=16,ix=240")
+int16_t parseModeDefault(const char *defaults, const char *segVar)
+{
+  if (!defaults) return -1;
+  const char* stopPtr = strstr(defaults, segVar);
+  if (!stopPtr) return -1;
+
+  stopPtr += strlen(segVar) +1; // skip "="
+  return atoi(stopPtr);
+}
+
 // extracts mode parameter defaults from last section of mode data (e.g. "Juggle@!,Trail;!,!,;!;012;sx=16,ix=240")
 int16_t extractModeDefaults(uint8_t mode, const char *segVar)
 {
   if (mode < strip.getModeCount()) {
-    char lineBuffer[256];
-    strncpy_P(lineBuffer, strip.getModeData(mode), sizeof(lineBuffer)/sizeof(char)-1);
+    const char *defaults = strip.getModeDefaults(mode); // located by effect descriptor (PROGMEM)
+    if (!defaults) return -1;
+    char lineBuffer[128];
+    strncpy_P(lineBuffer, defaults, sizeof(lineBuffer)/sizeof(char)-1);
     lineBuffer[sizeof(lineBuffer)/sizeof(char)-1] = '\0'; // terminate string
-    if (lineBuffer[0] != 0) {
-      char* startPtr = strrchr(lineBuffer, ';'); // last ";" in FX data
-      if (!startPtr) return -1;
-
-      char* stopPtr = strstr(startPtr, segVar);
-      if (!stopPtr) return -1;
-
-      stopPtr += strlen(segVar) +1; // skip "="
-      return atoi(stopPtr);
-    }
+    return parseModeDefault(lineBuffer, segVar);
   }
   return -1;
 }
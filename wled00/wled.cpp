@@ -14,6 +14,8 @@
 
 extern "C" void usePWMFixedNMI();
 
+static bool bootCfgSave = false; // config needs saving after (deferred) usermod setup
+
 /*
  * Main WLED class implementation. Mostly initialization and connection logic
  */
@@ -57,6 +59,22 @@ void WLED::loop()
   unsigned long        stripMillis;
 #endif
 
+  if (bootStage != BOOT_STAGE_DONE) { // early output boot: LEDs are already running, finish setup() one stage per iteration
+    strip.service();
+    if (bootStage == BOOT_STAGE_USERMODS) {
+      uint32_t knownEffects[8] = {0}; // effects a boot preset could select before usermods added theirs
+      for (unsigned i = 0; i < strip.getModeCount(); i++) if (!(strip.getModeFlags(i) & FX_INFO_RESERVED)) knownEffects[i >> 5] |= 1U << (i & 31);
+      setupUsermods(bootCfgSave);
+      bootStage = BOOT_STAGE_SERVICES;
+      // boot preset was applied before usermods were set up: hand its state to usermods (and apply it again if it uses a usermod effect)
+      if (bootPreset > 0 && UsermodManager::getModCount()) finishBootPreset(knownEffects);
+    } else {
+      finishSetup();
+      bootStage = BOOT_STAGE_DONE;
+    }
+    return;
+  }
+
   handleTime();
   #ifndef WLED_DISABLE_INFRARED
   handleIR();        // 2nd call to function needed for ESP32 to return valid results -- should be good for ESP8266, too
@@ -67,6 +85,7 @@ void WLED::loop()
   #endif
   handleImprovWifiScan();
   handleNotifications();
+  handleFrameSync();
   handleTransitions();
   #ifdef WLED_ENABLE_DMX
   handleDMXOutput();
@@ -127,13 +146,16 @@ void WLED::loop()
     handlePresets();
     yield();
 
-    if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate())
+    if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate()) {
       strip.service();
+      if (bootTimes[BOOT_PHASE_LIGHT] == 0) bootTimes[BOOT_PHASE_LIGHT] = millis(); // first frame since power-up
+    }
     #ifdef ESP8266
     else if (!noWifiSleep)
       delay(1); //required to make sure ESP enters modem sleep (see #1184)
     #endif
   }
+  BusManager::showPending(); // frame deferred by a busy bus must be sent even if strip.service() is not called (realtime, off)
   #ifdef WLED_DEBUG
   stripMillis = millis() - stripMillis;
   avgStripMillis += stripMillis;
@@ -196,10 +218,20 @@ void WLED::loop()
     BusManager::setBrightness(scaledBri(bri)); // fix re-initialised bus' brightness #4005 and #4824
     configNeedsWrite = true;
   }
+  if (doUpdateColorOrder) {
+    doUpdateColorOrder = false;
+    BusManager::updateColorOrderSpans();
+  }
   if (loadLedmap >= 0) {
     strip.deserializeMap(loadLedmap);
     loadLedmap = -1;
   }
+#ifdef WLED_ENABLE_FX_GOLDEN
+  if (fxGoldenRequest >= 0) {
+    fxGoldenFailed = strip.runGoldenTest(fxGoldenRequest);
+    fxGoldenRequest = -1;
+  }
+#endif
   yield();
   if (configNeedsWrite) serializeConfigToFS();
 
@@ -417,6 +449,7 @@ void WLED::setup()
 
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
 
+  unsigned long phaseStart = millis(); // boot phase timing, see bootTimes[]
   bool fsinit = false;
   DEBUGFS_PRINTLN(F("Mount FS"));
 #ifdef ARDUINO_ARCH_ESP32
@@ -437,6 +470,7 @@ void WLED::setup()
   initPresetsFile();
 #endif
   updateFSInfo();
+  bootTimes[BOOT_PHASE_FS] = millis() - phaseStart;
 
   // generate module IDs must be done before AP setup
   escapedMac = WiFi.macAddress();
@@ -446,13 +480,15 @@ void WLED::setup()
   WLED_SET_AP_SSID(); // otherwise it is empty on first boot until config is saved
   multiWiFi.push_back(WiFiConfig(CLIENT_SSID,CLIENT_PASS)); // initialise vector with default WiFi
 
-  if(!verifyConfig()) {
+  phaseStart = millis();
+  if (!configSnapshotValid() && !verifyConfig()) { // valid snapshot implies valid cfg.json, no need to parse it twice
     if(!restoreConfig()) {
       resetConfig();
     }
   }
   DEBUG_PRINTLN(F("Reading config"));
   bool needsCfgSave = deserializeConfigFromFS();
+  bootTimes[BOOT_PHASE_CONFIG] = millis() - phaseStart;
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
 
 #if defined(STATUSLED) && STATUSLED>=0
@@ -464,16 +500,41 @@ void WLED::setup()
 #endif
 
   DEBUG_PRINTLN(F("Initializing strip"));
+  phaseStart = millis();
   beginStrip();
+  bootTimes[BOOT_PHASE_STRIP] = millis() - phaseStart;
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
 
+  if (earlyOutput) {
+    // apply boot preset and start LED output right away, usermods and network are set up from loop()
+    handlePresets();
+    strip.service();
+    bootTimes[BOOT_PHASE_LIGHT] = millis();
+    bootCfgSave = needsCfgSave;
+    bootStage = BOOT_STAGE_USERMODS;
+    return;
+  }
+  setupUsermods(needsCfgSave);
+  finishSetup();
+}
+
+// usermods setup, part of setup() (deferred to loop() in early output mode)
+void WLED::setupUsermods(bool needsCfgSave)
+{
+  unsigned long phaseStart = millis();
   DEBUG_PRINTLN(F("Usermods setup"));
   userSetup();
   UsermodManager::setup();
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
 
   if (needsCfgSave) serializeConfigToFS(); // usermods required new parameters; need to wait for strip to be initialised #4752
+  bootTimes[BOOT_PHASE_USERMODS] = millis() - phaseStart;
+}
 
+// network, web server and remaining interfaces, last part of setup() (deferred to loop() in early output mode)
+void WLED::finishSetup()
+{
+  unsigned long phaseStart = millis();
   if (strcmp(multiWiFi[0].clientSSID, DEFAULT_CLIENT_SSID) == 0 && !configBackupExists())
     showWelcomePage = true;
   WiFi.persistent(false);
@@ -556,6 +617,11 @@ void WLED::setup()
   WRITE_PERI_REG(RTC_CNTL_BROWN_OUT_REG, 1); //enable brownout detector
   #endif
   markOTAvalid();
+  bootTimes[BOOT_PHASE_SERVICES] = millis() - phaseStart;
+  bootTimes[BOOT_PHASE_SETUP] = millis(); // total time since power-up
+  DEBUG_PRINTF_P(PSTR("Boot: FS %ums, config %ums (%s), strip %ums, usermods %ums, services %ums, total %ums\n"),
+    (unsigned)bootTimes[BOOT_PHASE_FS], (unsigned)bootTimes[BOOT_PHASE_CONFIG], bootFromSnapshot ? "snapshot" : "json", (unsigned)bootTimes[BOOT_PHASE_STRIP],
+    (unsigned)bootTimes[BOOT_PHASE_USERMODS], (unsigned)bootTimes[BOOT_PHASE_SERVICES], (unsigned)bootTimes[BOOT_PHASE_SETUP]);
 }
 
 void WLED::beginStrip()
@@ -395,6 +395,7 @@ WLED_GLOBAL uint8_t txPower _INIT(WIFI_POWER_19_5dBm);
 // LED CONFIG
 WLED_GLOBAL bool turnOnAtBoot _INIT(true);                // turn on LEDs at power-up
 WLED_GLOBAL byte bootPreset   _INIT(0);                   // save preset to load after power-up
+WLED_GLOBAL bool earlyOutput  _INIT(false);               // start LED output (boot preset) before usermods and network
 
 //if true, a segment per bus will be created on boot and LED settings save
 //if false, only one segment spanning the total LEDs is created,
@@ -607,6 +608,7 @@ WLED_GLOBAL uint8_t paletteBlend _INIT(0);        // determines blending and wra
 
 // transitions
 WLED_GLOBAL uint8_t       blendingStyle            _INIT(0);      // effect blending/transitionig style
+WLED_GLOBAL uint32_t      transitionSnapshot       _INIT(0);      // bit per blending style: outgoing effect is frozen at its last frame instead of being rendered (stored in cfg.json)
 WLED_GLOBAL bool          transitionActive         _INIT(false);
 WLED_GLOBAL uint16_t      transitionDelay          _INIT(750);    // global transition duration
 WLED_GLOBAL uint16_t      transitionDelayDefault   _INIT(750);    // default transition time (stored in cfg.json)
@@ -673,6 +675,9 @@ WLED_GLOBAL byte notificationSentCallMode _INIT(CALL_MODE_INIT);
 WLED_GLOBAL uint8_t notificationCount _INIT(0);
 WLED_GLOBAL uint8_t syncGroups    _INIT(0x01);                // sync send groups this instance syncs to (bit mapped)
 WLED_GLOBAL uint8_t receiveGroups _INIT(0x01);                // sync receive groups this instance belongs to (bit mapped)
+WLED_GLOBAL byte frameSyncMode       _INIT(0);               // frame sync: 0 off, 1 leader (broadcasts frame grid), 2 follower
+WLED_GLOBAL int32_t frameSyncSkew     _INIT(0);               // follower: strip time error vs. leader measured at last sync packet (ms)
+WLED_GLOBAL unsigned long frameSyncLastRx _INIT(0);           // follower: millis() of last accepted sync packet
 #ifdef WLED_SAVE_RAM
 // this will save us 8 bytes of RAM while increasing code by ~400 bytes
 typedef class Receive {
@@ -888,6 +893,7 @@ WLED_GLOBAL Toki toki _INIT(Toki());
 WLED_GLOBAL size_t fsBytesUsed _INIT(0);
 WLED_GLOBAL size_t fsBytesTotal _INIT(0);
 WLED_GLOBAL unsigned long presetsModifiedTime _INIT(0L);
+WLED_GLOBAL uint32_t presetsGeneration _INIT(0);  // incremented on every change of presets.json (presetsModifiedTime only has 1s resolution)
 WLED_GLOBAL bool doCloseFile _INIT(false);
 
 // presets
@@ -900,6 +906,9 @@ WLED_GLOBAL byte optionType;
 
 WLED_GLOBAL bool configNeedsWrite  _INIT(false);        // flag to initiate saving of config
 WLED_GLOBAL bool doReboot          _INIT(false);        // flag to initiate reboot from async handlers
+WLED_GLOBAL uint32_t bootTimes[BOOT_PHASES] _INIT_N(({0})); // duration of boot phases in ms
+WLED_GLOBAL bool bootFromSnapshot  _INIT(false);        // config was loaded from binary snapshot (cfg.bin)
+WLED_GLOBAL byte bootStage         _INIT(BOOT_STAGE_DONE); // part of setup() still pending (early output)
 
 // status led
 #if defined(STATUSLED)
@@ -929,7 +938,13 @@ WLED_GLOBAL bool e131NewData _INIT(false);
 WLED_GLOBAL WS2812FX   strip         _INIT(WS2812FX());
 WLED_GLOBAL std::vector<BusConfig> busConfigs;    //temporary, to remember values from network callback until after
 WLED_GLOBAL bool       doInitBusses  _INIT(false);
+WLED_GLOBAL bool       doUpdateColorOrder _INIT(false); // rebuild per bus color order spans in loop() (map changed)
 WLED_GLOBAL int8_t     loadLedmap    _INIT(-1);
+#ifdef WLED_ENABLE_FX_GOLDEN
+WLED_GLOBAL int8_t     fxGoldenRequest  _INIT(-1);  // effect golden image test requested from async handler: 0 compare, 1 record
+WLED_GLOBAL int16_t    fxGoldenFailed   _INIT(-1);  // result of last test: failing effects (-1 not run or no/invalid golden file)
+WLED_GLOBAL uint16_t   fxGoldenSkipped  _INIT(0);   // effect/geometry combinations not tested (unstable, reserved or excluded)
+#endif
 WLED_GLOBAL uint8_t    currentLedmap _INIT(0);
 #ifndef ESP8266
 WLED_GLOBAL char  *ledmapNames[WLED_MAX_LEDMAPS-1] _INIT_N(({nullptr}));
@@ -1078,6 +1093,8 @@ public:
   void reset();
 
   void beginStrip();
+  void setupUsermods(bool needsCfgSave);
+  void finishSetup();
   void handleConnection();
   void initAP(bool resetAP = false);
   void initConnection();
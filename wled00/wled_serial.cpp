@@ -1,28 +1,31 @@
 #include "wled.h"
+#include "serial_frame.h"
 
 /*
  * Adalight and TPM2 handler
  */
 
-enum class AdaState {
-  Header_A,
-  Header_d,
-  Header_a,
-  Header_CountHi,
-  Header_CountLo,
-  Header_CountCheck,
-  Data_Red,
-  Data_Green,
-  Data_Blue,
-  TPM2_Header_Type,
-  TPM2_Header_CountHi,
-  TPM2_Header_CountLo,
-};
-
 uint16_t currentBaud = 1152; //default baudrate 115200 (divided by 100)
 bool continuousSendLED = false;
 uint32_t lastUpdate = 0;
 
+// realtime frame statistics
+static uint32_t serialFrameTime = 0;   // millis() of last complete frame
+static uint32_t serialFps = 0;         // rolling average (x16 fixed point)
+static SerialFrameParser serialParser;
+
+unsigned getSerialFps()     { return (serialFps + 8) >> 4; }
+unsigned getSerialDropped() { return serialParser.getDropped(); }
+
+static void serialFrameDone() {
+  uint32_t now = millis();
+  uint32_t diff = now - serialFrameTime;
+  serialFrameTime = now;
+  if (diff == 0) diff = 1;
+  if (diff > 2000) serialFps = 0; // stream (re)started
+  else             serialFps = (7 * serialFps + 16000 / diff) / 8; // rolling average of 1000/diff
+}
+
 void updateBaudRate(uint32_t rate){
   unsigned rate100 = rate/100;
   if (rate100 == currentBaud || rate100 < 96) return;
@@ -71,116 +74,68 @@ void handleSerial()
 {
   if (!(serialCanRX && Serial)) return; // arduino docs: `if (Serial)` indicates whether or not the USB CDC serial connection is open. For all non-USB CDC ports, this will always return true
 
-  static auto state = AdaState::Header_A;
-  static uint16_t count = 0;
-  static uint16_t pixel = 0;
-  static byte check = 0x00;
-  static byte red   = 0x00;
-  static byte green = 0x00;
-
   while (Serial.available() > 0)
   {
     yield();
+    if (serialParser.isData()) {
+      // pixel data is read in blocks (never past the end of the frame) instead of byte by byte
+      uint8_t buf[192]; // multiple of 3
+      size_t len = Serial.readBytes(buf, std::min(std::min((size_t)Serial.available(), serialParser.bytesLeft()), sizeof(buf)));
+      if (len == 0) break;
+      continuousSendLED = false; // all other received bytes will disable Continuous Serial Streaming
+      bool done;
+      if (realtimeOverride) done = serialParser.data(buf, len, [](unsigned, uint8_t, uint8_t, uint8_t) {});
+      else                  done = serialParser.data(buf, len, [](unsigned i, uint8_t r, uint8_t g, uint8_t b) { setRealtimePixel(i, r, g, b, 0); });
+      if (done) {
+        realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
+        if (!realtimeOverride) strip.show();
+        serialFrameDone();
+      }
+      continue;
+    }
+
     byte next = Serial.peek();
-    switch (state) {
-      case AdaState::Header_A:
-        if      (next == 'A')  { state = AdaState::Header_d; }
-        else if (next == 0xC9) { state = AdaState::TPM2_Header_Type; } //TPM2 start byte
-        else if (next == 'I')  { handleImprovPacket(); return; }
-        else if (next == 'v')  { Serial.print("WLED"); Serial.write(' '); Serial.println(VERSION); }
-        else if (next == 0xB0) { updateBaudRate( 115200); }
-        else if (next == 0xB1) { updateBaudRate( 230400); }
-        else if (next == 0xB2) { updateBaudRate( 460800); }
-        else if (next == 0xB3) { updateBaudRate( 500000); }
-        else if (next == 0xB4) { updateBaudRate( 576000); }
-        else if (next == 0xB5) { updateBaudRate( 921600); }
-        else if (next == 0xB6) { updateBaudRate(1000000); }
-        else if (next == 0xB7) { updateBaudRate(1500000); }
-        else if (next == 'l')  { sendJSON(); } // Send LED data as JSON Array
-        else if (next == 'L')  { sendBytes(); } // Send LED data as TPM2 Data Packet
-        else if (next == 'o')  { continuousSendLED = false; } // Disable Continuous Serial Streaming
-        else if (next == 'O')  { continuousSendLED = true; } // Enable Continuous Serial Streaming
-        else if (next == '{')  { //JSON API
-          bool verboseResponse = false;
-          if (!requestJSONBufferLock(16)) {
-            Serial.printf_P(PSTR("{\"error\":%d}\n"), ERR_NOBUF);
-            return;
-          }
-          Serial.setTimeout(100);
-          DeserializationError error = deserializeJson(*pDoc, Serial);
-          if (!error) {
-            verboseResponse = deserializeState(pDoc->as<JsonObject>());
-            //only send response if TX pin is unused for other purposes
-            if (verboseResponse && serialCanTX) {
-              pDoc->clear();
-              JsonObject stateDoc = pDoc->createNestedObject("state");
-              serializeState(stateDoc);
-              JsonObject info  = pDoc->createNestedObject("info");
-              serializeInfo(info);
-
-              serializeJson(*pDoc, Serial);
-              Serial.println();
-            }
-          }
-          releaseJSONBufferLock();
+    SerialFrameParser::Event event = serialParser.header(next);
+    if (event == SerialFrameParser::Event::Ping) Serial.write(0xAC); //TPM2 ping
+    else if (event == SerialFrameParser::Event::Command) {
+      if      (next == 'I')  { handleImprovPacket(); return; }
+      else if (next == 'v')  { Serial.print("WLED"); Serial.write(' '); Serial.println(VERSION); }
+      else if (next == 0xB0) { updateBaudRate( 115200); }
+      else if (next == 0xB1) { updateBaudRate( 230400); }
+      else if (next == 0xB2) { updateBaudRate( 460800); }
+      else if (next == 0xB3) { updateBaudRate( 500000); }
+      else if (next == 0xB4) { updateBaudRate( 576000); }
+      else if (next == 0xB5) { updateBaudRate( 921600); }
+      else if (next == 0xB6) { updateBaudRate(1000000); }
+      else if (next == 0xB7) { updateBaudRate(1500000); }
+      else if (next == 'l')  { sendJSON(); } // Send LED data as JSON Array
+      else if (next == 'L')  { sendBytes(); } // Send LED data as TPM2 Data Packet
+      else if (next == 'o')  { continuousSendLED = false; } // Disable Continuous Serial Streaming
+      else if (next == 'O')  { continuousSendLED = true; } // Enable Continuous Serial Streaming
+      else if (next == '{')  { //JSON API
+        bool verboseResponse = false;
+        if (!requestJSONBufferLock(16)) {
+          Serial.printf_P(PSTR("{\"error\":%d}\n"), ERR_NOBUF);
+          return;
         }
-        break;
-      case AdaState::Header_d:
-        if (next == 'd') state = AdaState::Header_a;
-        else             state = AdaState::Header_A;
-        break;
-      case AdaState::Header_a:
-        if (next == 'a') state = AdaState::Header_CountHi;
-        else             state = AdaState::Header_A;
-        break;
-      case AdaState::Header_CountHi:
-        pixel = 0;
-        count = next * 0x100;
-        check = next;
-        state = AdaState::Header_CountLo;
-        break;
-      case AdaState::Header_CountLo:
-        count += next + 1;
-        check = check ^ next ^ 0x55;
-        state = AdaState::Header_CountCheck;
-        break;
-      case AdaState::Header_CountCheck:
-        if (check == next) state = AdaState::Data_Red;
-        else               state = AdaState::Header_A;
-        break;
-      case AdaState::TPM2_Header_Type:
-        state = AdaState::Header_A; //(unsupported) TPM2 command or invalid type
-        if (next == 0xDA) state = AdaState::TPM2_Header_CountHi; //TPM2 data
-        else if (next == 0xAA) Serial.write(0xAC); //TPM2 ping
-        break;
-      case AdaState::TPM2_Header_CountHi:
-        pixel = 0;
-        count = (next * 0x100) /3;
-        state = AdaState::TPM2_Header_CountLo;
-        break;
-      case AdaState::TPM2_Header_CountLo:
-        count += next /3;
-        state = AdaState::Data_Red;
-        break;
-      case AdaState::Data_Red:
-        red   = next;
-        state = AdaState::Data_Green;
-        break;
-      case AdaState::Data_Green:
-        green = next;
-        state = AdaState::Data_Blue;
-        break;
-      case AdaState::Data_Blue:
-        byte blue  = next;
-        if (!realtimeOverride) setRealtimePixel(pixel++, red, green, blue, 0);
-        if (--count > 0) state = AdaState::Data_Red;
-        else {
-          realtimeLock(realtimeTimeoutMs, REALTIME_MODE_ADALIGHT);
-
-          if (!realtimeOverride) strip.show();
-          state = AdaState::Header_A;
+        Serial.setTimeout(100);
+        DeserializationError error = deserializeJson(*pDoc, Serial);
+        if (!error) {
+          verboseResponse = deserializeState(pDoc->as<JsonObject>());
+          //only send response if TX pin is unused for other purposes
+          if (verboseResponse && serialCanTX) {
+            pDoc->clear();
+            JsonObject stateDoc = pDoc->createNestedObject("state");
+            serializeState(stateDoc);
+            JsonObject info  = pDoc->createNestedObject("info");
+            serializeInfo(info);
+
+            serializeJson(*pDoc, Serial);
+            Serial.println();
+          }
         }
-        break;
+        releaseJSONBufferLock();
+      }
     }
 
     // All other received bytes will disable Continuous Serial Streaming
@@ -200,7 +200,8 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
 
     request->_tempFile = WLED_FS.open(finalname, "w");
     DEBUG_PRINTF_P(PSTR("Uploading %s\n"), finalname.c_str());
-    if (finalname.equals(FPSTR(getPresetsFileName()))) presetsModifiedTime = toki.second();
+    if (finalname.equals(FPSTR(getPresetsFileName()))) presetsChanged();
+    if (finalname.equals(F("/cfg.json"))) removeConfigSnapshot(); // snapshot no longer matches
   }
   if (len) {
     request->_tempFile.write(data,len);
@@ -302,8 +303,11 @@ void createEditHandler() {
     if (func == "delete") {
       if (!WLED_FS.remove(path))
         request->send(500, FPSTR(CONTENT_TYPE_PLAIN), F("Delete failed"));
-      else
+      else {
+        if (path.equals(FPSTR(getPresetsFileName()))) presetsChanged();
+        if (path.equals(F("/cfg.json"))) removeConfigSnapshot();
         request->send(200, FPSTR(CONTENT_TYPE_PLAIN), F("File deleted"));
+      }
       return;
     }
 
@@ -201,7 +201,7 @@ bool sendLiveLedsWs(uint32_t wsClient)
 #ifndef WLED_DISABLE_2D
   if (strip.isMatrix) {
     // ignore anything behid matrix (i.e. extra strip)
-    used = Segment::maxWidth*Segment::maxHeight; // always the size of matrix (more or less than strip.getLengthTotal())
+    used = strip.getMatrixWidth()*strip.getMatrixHeight(); // always the size of (local) matrix (more or less than strip.getLengthTotal())
     n = 1;
     if (used > MAX_LIVE_LEDS_WS) n = 2;
     if (used > MAX_LIVE_LEDS_WS*4) n = 4;
@@ -220,15 +220,15 @@ bool sendLiveLedsWs(uint32_t wsClient)
 #ifndef WLED_DISABLE_2D
   if (strip.isMatrix) {
     buffer[1] = 2; //version
-    buffer[2] = Segment::maxWidth/n;
-    buffer[3] = Segment::maxHeight/n;
+    buffer[2] = strip.getMatrixWidth()/n;
+    buffer[3] = strip.getMatrixHeight()/n;
   }
 #endif
 
   for (size_t i = 0; pos < bufSize -2; i += n)
   {
 #ifndef WLED_DISABLE_2D
-    if (strip.isMatrix && n>1 && (i/Segment::maxWidth)%n) i += Segment::maxWidth * (n-1);
+    if (strip.isMatrix && n>1 && (i/strip.getMatrixWidth())%n) i += strip.getMatrixWidth() * (n-1);
 #endif
     uint32_t c = strip.getPixelColor(i); // note: LEDs mapped outside of valid range are set to black
     uint8_t r = R(c);
@@ -376,6 +376,9 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormValue(settingsScript,PSTR("MA"),BusManager::ablMilliampsMax() ? BusManager::ablMilliampsMax() : sumMa);
     printSetFormCheckbox(settingsScript,PSTR("ABL"),BusManager::ablMilliampsMax() || sumMa > 0);
     printSetFormCheckbox(settingsScript,PSTR("PPL"),!BusManager::ablMilliampsMax() && sumMa > 0);
+    printSetFormValue(settingsScript,PSTR("PS"),BusManager::ablMilliampsPSU());
+    printSetFormCheckbox(settingsScript,PSTR("AM"),BusManager::getABLSmoothing());
+    printSetFormValue(settingsScript,PSTR("AS"),BusManager::getABLSustained());
 
     settingsScript.printf_P(PSTR("resetCOM(%d);"), WLED_MAX_COLOR_ORDER_MAPPINGS);
     const ColorOrderMap& com = BusManager::getColorOrderMap();
@@ -389,13 +392,16 @@ void getSettingsJS(byte subPage, Print& settingsScript)
 
     printSetFormCheckbox(settingsScript,PSTR("BO"),turnOnAtBoot);
     printSetFormValue(settingsScript,PSTR("BP"),bootPreset);
+    printSetFormCheckbox(settingsScript,PSTR("EO"),earlyOutput);
 
     printSetFormCheckbox(settingsScript,PSTR("GB"),gammaCorrectBri);
     printSetFormCheckbox(settingsScript,PSTR("GC"),gammaCorrectCol);
+    printSetFormCheckbox(settingsScript,PSTR("DT"),BusDigital::getDither());
     dtostrf(gammaCorrectVal,3,1,nS); printSetFormValue(settingsScript,PSTR("GV"),nS);
     printSetFormValue(settingsScript,PSTR("TD"),transitionDelayDefault);
     printSetFormValue(settingsScript,PSTR("TP"),randomPaletteChangeTime);
     printSetFormCheckbox(settingsScript,PSTR("TH"),useHarmonicRandomPalette);
+    printSetFormValue(settingsScript,PSTR("TS"),transitionSnapshot);
     printSetFormValue(settingsScript,PSTR("BF"),briMultiplier);
     printSetFormValue(settingsScript,PSTR("TB"),nightlightTargetBri);
     printSetFormValue(settingsScript,PSTR("TL"),nightlightDelayMinsDefault);
@@ -450,6 +456,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
 
     printSetFormCheckbox(settingsScript,PSTR("NL"),nodeListEnabled);
     printSetFormCheckbox(settingsScript,PSTR("NB"),nodeBroadcastEnabled);
+    printSetFormValue(settingsScript,PSTR("FS"),frameSyncMode);
 
     printSetFormCheckbox(settingsScript,PSTR("RD"),receiveDirect);
     printSetFormCheckbox(settingsScript,PSTR("MO"),useMainSegmentOnly);
@@ -683,6 +690,10 @@ void getSettingsJS(byte subPage, Print& settingsScript)
       printSetFormValue(settingsScript,PSTR("PW"),strip.panel.size()>0?strip.panel[0].width:8); //Set generator Width and Height to first panel size for convenience
       printSetFormValue(settingsScript,PSTR("PH"),strip.panel.size()>0?strip.panel[0].height:8);
       printSetFormValue(settingsScript,PSTR("MPC"),strip.panel.size());
+      printSetFormValue(settingsScript,PSTR("CW"),strip.canvasWidth);
+      printSetFormValue(settingsScript,PSTR("CH"),strip.canvasHeight);
+      printSetFormValue(settingsScript,PSTR("CX"),strip.canvasX);
+      printSetFormValue(settingsScript,PSTR("CY"),strip.canvasY);
       // panels
       for (unsigned i=0; i<strip.panel.size(); i++) {
         settingsScript.printf_P(PSTR("addPanel(%d);"), i);